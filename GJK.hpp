@@ -37,8 +37,9 @@
 
     #endif
 
-    //#include "src/MortonCode.hpp"
-    //#include "src/Collision/HilbertCurve.hpp"
+    // Space-filling curves for the linear BVH build:
+    #include "src/MortonCode.hpp"
+    #include "src/HilbertCurve.hpp"
 
     // These primitives are not serializable -- for a reason.
     #include "src/Primitives/PrimitiveBase.hpp"
@@ -50,6 +51,8 @@
     #include "src/Primitives/PolytopeBase.hpp"
     #include "src/Primitives/PolytopeExt.hpp"
     #include "src/Primitives/Polytope.hpp"
+    #include "src/Primitives/PolytopeSoA.hpp"
+    #include "src/Primitives/IndexedPolytope.hpp"
     #include "src/Primitives/Ellipsoid.hpp"
     #include "src/Primitives/Parallelepiped.hpp"
 
@@ -57,21 +60,38 @@
 
     #include "src/Primitives/TypeDefs.hpp"
 
+    // Scheduling of the parallel loops over primitives and pairs:
+    #include "src/GJK_JobScheduler.hpp"
+    #include "src/RadixSort.hpp"
+    #include "src/ParallelSelect.hpp"
+
+    // Small dense eigensolver for the OBBs:
+    #include "src/SymmetricEigenSolve.hpp"
+
     // Bounding volume types:
     #include "src/BoundingVolumes/BoundingVolumeBase.hpp"
     #include "src/BoundingVolumes/AABB.hpp"
     #include "src/BoundingVolumes/AABB_LongestAxisSplit.hpp"
     #include "src/BoundingVolumes/AABB_MedianSplit.hpp"
     #include "src/BoundingVolumes/AABB_PreorderedSplit.hpp"
-    //#include "src/BoundingVolumes/OBB.hpp"                    // requires eigensolve
-    //#include "src/BoundingVolumes/OBB_MedianSplit.hpp"        // requires eigensolve
-    //#include "src/BoundingVolumes/OBB_PreorderedSplit.hpp"    // requires eigensolve
+    #include "src/BoundingVolumes/AABB_SAHSplit.hpp"
+    #include "src/BoundingVolumes/OBB.hpp"
+    #include "src/BoundingVolumes/OBB_MedianSplit.hpp"
+    #include "src/BoundingVolumes/OBB_PreorderedSplit.hpp"
+
+    // Bounding volume hierarchy:
+    #include "src/BVH.hpp"
 
 
     // Actual GJK algorithms
     #include "src/GJK_Algorithm.hpp"
+    #include "src/GJK_Algorithm_Vectorized.hpp"
+    #include "src/EPA_Algorithm.hpp"
+    #include "src/AABB_Overlap.hpp"
     #include "src/GJK_Batch.hpp"
     #include "src/GJK_Offset_Batch.hpp"
+    #include "src/GJK_Indexed_Batch.hpp"
+    #include "src/BVH_Collisions.hpp"
 
 
     #include "src/Primitives/MovingPolytopeBase.hpp"
@@ -80,5 +100,7 @@
 
     #include "src/CollisionFinderBase.hpp"
     #include "src/CollisionFinder.hpp"
+    #include "src/CollisionFinder_Batch.hpp"
+    #include "src/SweptBVH.hpp"
 
 #endif
@@ -0,0 +1,223 @@
+#pragma once
+
+namespace GJK
+{
+    // Batch overlap tests of axis-aligned boxes.
+    //
+    // The kernels work on SoA blocks of a fixed number of boxes: row k of a block holds coordinate k of all boxes of the block, so that the loops over the boxes read contiguous memory, have a trip count known at compile time and vectorize without gathers. The results are bitmasks: bit b is set if box b of the block overlaps.
+    //
+    // AABB_OverlapMask and AABB_OverlapMatrix test boxes in the serialized layout of AABB (squared radius, center, half edge lengths); AABB_TransposeBlocks converts them to blocks of AABB_BLOCK_SIZE boxes first. Two boxes overlap (up to offset) if |x_P[k] - x_Q[k]| <= L_P[k] + L_Q[k] + offset for all k; in contrast to AABB_SquaredDistance, this needs neither branches nor a reduction over k. AABB_OverlapMatrix tests all pairs of two sets of boxes in tiles; it is meant as brute-force broad phase for small scenes.
+    //
+    // PackedBox_OverlapMask tests pairs of packed boxes (see AABB::WritePackedBox) lane by lane; BVH_PairTraversal uses it to test the node pairs of its stack in blocks.
+
+    // Number of boxes per block of AABB_TransposeBlocks.
+    constexpr int AABB_BLOCK_SIZE = 64;
+
+    template<typename Int>
+    constexpr Int AABB_MaskWordCount( const Int n )
+    {
+        return (n + Int(AABB_BLOCK_SIZE - 1)) / Int(AABB_BLOCK_SIZE);
+    }
+
+    // Packs the flags (0 or 1, one byte each) into a bitmask, eight at a time: the multiplication moves the lowest bit of byte c to bit 56 + c. This assumes little-endian byte order.
+    template<int BLOCK>
+    std::uint64_t AABB_PackBits( cptr<std::uint8_t> flags )
+    {
+        static_assert( (BLOCK % 8 == 0) && (BLOCK <= 64), "AABB_PackBits: BLOCK must be a multiple of 8 and must not exceed 64." );
+
+        std::uint64_t bits = 0;
+
+        for( int c = 0; c < BLOCK / 8; ++c )
+        {
+            std::uint64_t chunk;
+
+            std::memcpy( &chunk, flags + 8 * c, 8 );
+
+            bits |= ( (chunk * std::uint64_t(0x0102040810204080)) >> 56 ) << (8 * c);
+        }
+
+        return bits;
+    }
+
+    // Writes the serialized AABBs Q_0,...,Q_{n-1} as blocks of AABB_BLOCK_SIZE boxes: Block w is a matrix of size (2 * AMB_DIM) x AABB_BLOCK_SIZE with the centers in rows 0,...,AMB_DIM-1 and the half edge lengths in rows AMB_DIM,...,2*AMB_DIM-1. Unused columns of the last block get negative half edge lengths, so that they never overlap.
+    template<int AMB_DIM, typename SReal, typename Int>
+    void AABB_TransposeBlocks(
+        cptr<SReal> Q_serialized,       // matrix of size n x (1 + 2 * AMB_DIM) of serialized AABBs
+        const Int n,
+        mptr<SReal> Q_blocks            // vector of size AABB_MaskWordCount(n) * 2 * AMB_DIM * AABB_BLOCK_SIZE
+    )
+    {
+        constexpr Int SIZE  = 1 + 2 * AMB_DIM;
+        constexpr Int BLOCK = AABB_BLOCK_SIZE;
+
+        const Int block_count = AABB_MaskWordCount(n);
+
+        for( Int w = 0; w < block_count; ++w )
+        {
+            mptr<SReal> block = Q_blocks + 2 * AMB_DIM * BLOCK * w;
+
+            for( Int b = 0; b < BLOCK; ++b )
+            {
+                const Int j = BLOCK * w + b;
+
+                if( j < n )
+                {
+                    for( Int k = 0; k < 2 * AMB_DIM; ++k )
+                    {
+                        block[BLOCK * k + b] = Q_serialized[SIZE * j + 1 + k];
+                    }
+                }
+                else
+                {
+                    for( Int k = 0; k < AMB_DIM; ++k )
+                    {
+                        block[BLOCK * k + b] = Scalar::Zero<SReal>;
+                    }
+
+                    for( Int k = AMB_DIM; k < 2 * AMB_DIM; ++k )
+                    {
+                        block[BLOCK * k + b] = -std::numeric_limits<SReal>::infinity();
+                    }
+                }
+            }
+        }
+    }
+
+    // Tests the box P against the boxes Q_0,...,Q_{n-1}.
+    template<int AMB_DIM, typename SReal, typename Int>
+    void AABB_OverlapMask(
+        cptr<SReal> P_data,             // one serialized AABB
+        cptr<SReal> Q_blocks,           // Q_0,...,Q_{n-1} as written by AABB_TransposeBlocks
+        const Int n,
+        mptr<std::uint64_t> mask,       // vector of size AABB_MaskWordCount(n)
+        const SReal offset = 0          // boxes at distance <= offset (in each coordinate) count as overlapping
+    )
+    {
+        constexpr Int BLOCK = AABB_BLOCK_SIZE;
+
+        cptr<SReal> P_x = P_data + 1;
+        cptr<SReal> P_L = P_data + 1 + AMB_DIM;
+
+        const Int word_count = AABB_MaskWordCount(n);
+
+        for( Int w = 0; w < word_count; ++w )
+        {
+            cptr<SReal> Q = Q_blocks + 2 * AMB_DIM * BLOCK * w;
+
+            // One byte per box; the loops below are then plain elementwise loops.
+            alignas(64) std::uint8_t overlapQ [BLOCK];
+
+            std::fill( &overlapQ[0], &overlapQ[BLOCK], std::uint8_t(1) );
+
+            for( Int k = 0; k < AMB_DIM; ++k )
+            {
+                const SReal x = P_x[k];
+                const SReal L = P_L[k] + offset;
+
+                cptr<SReal> Q_x = Q + BLOCK * k;
+                cptr<SReal> Q_L = Q + BLOCK * (AMB_DIM + k);
+
+                for( Int b = 0; b < BLOCK; ++b )
+                {
+                    overlapQ[b] &= static_cast<std::uint8_t>( std::abs( x - Q_x[b] ) <= L + Q_L[b] );
+                }
+            }
+
+            mask[w] = AABB_PackBits<BLOCK>( &overlapQ[0] );
+        }
+    }
+
+    // Tests all pairs of the boxes P_0,...,P_{m-1} and Q_0,...,Q_{n-1}. Row i of masks is the mask of P_i against all Q_j.
+    template<int AMB_DIM, typename SReal, typename Int>
+    void AABB_OverlapMatrix(
+        cptr<SReal> P_serialized,       // matrix of size m x (1 + 2 * AMB_DIM) of serialized AABBs
+        const Int m,
+        cptr<SReal> Q_serialized,       // matrix of size n x (1 + 2 * AMB_DIM) of serialized AABBs
+        const Int n,
+        mptr<std::uint64_t> masks,      // matrix of size m x AABB_MaskWordCount(n)
+        const SReal offset = 0,
+        const Int thread_count = 1
+    )
+    {
+        constexpr Int SIZE  = 1 + 2 * AMB_DIM;
+        constexpr Int BLOCK = AABB_BLOCK_SIZE;
+
+        // Columns per tile; the blocks of 256 boxes of Q (12 KB for AMB_DIM = 3 and double) stay in L1 while all rows of a thread pass over them.
+        constexpr Int tile_size = 256;
+
+        static_assert( tile_size % BLOCK == 0, "AABB_OverlapMatrix: tile_size must be a multiple of AABB_BLOCK_SIZE." );
+
+        const Int word_count = AABB_MaskWordCount(n);
+
+        std::vector<SReal> Q_blocks ( word_count * 2 * AMB_DIM * BLOCK );
+
+        AABB_TransposeBlocks<AMB_DIM>( Q_serialized, n, Q_blocks.data() );
+
+        ParallelDo(
+            [&]( const Int thread )
+            {
+                const Int i_begin = JobPointer( m, thread_count, thread    );
+                const Int i_end   = JobPointer( m, thread_count, thread +1 );
+
+                for( Int j_begin = 0; j_begin < n; j_begin += tile_size )
+                {
+                    const Int j_count = Min( tile_size, n - j_begin );
+
+                    for( Int i = i_begin; i < i_end; ++i )
+                    {
+                        AABB_OverlapMask<AMB_DIM>(
+                            &P_serialized[SIZE * i], &Q_blocks[2 * AMB_DIM * j_begin], j_count,
+                            &masks[word_count * i + j_begin / BLOCK],
+                            offset
+                        );
+                    }
+                }
+            },
+            thread_count
+        );
+    }
+
+    // Tests the pairs (P_b,Q_b) of packed boxes for b = 0,...,BLOCK-1; bit b of the result is set if the squared distance of P_b and Q_b is at most r2[b]. P_block and Q_block are matrices of size (2 * AMB_DIM) x BLOCK with the lower corners in rows 0,...,AMB_DIM-1 and the upper corners in rows AMB_DIM,...,2*AMB_DIM-1.
+    //
+    // The distances are accumulated in Real, so that the test is exact for the (outward rounded) boxes also with a positive r2; for r2 = 0, it is just the overlap test.
+    template<int AMB_DIM, int BLOCK, typename F, typename Real>
+    std::uint64_t PackedBox_OverlapMask(
+        cptr<F> P_block,
+        cptr<F> Q_block,
+        cptr<Real> r2                   // vector of size BLOCK
+    )
+    {
+        alignas(64) Real d2 [BLOCK] = {};
+
+        for( int k = 0; k < AMB_DIM; ++k )
+        {
+            cptr<F> P_lower = P_block + BLOCK * k;
+            cptr<F> P_upper = P_block + BLOCK * (AMB_DIM + k);
+            cptr<F> Q_lower = Q_block + BLOCK * k;
+            cptr<F> Q_upper = Q_block + BLOCK * (AMB_DIM + k);
+
+            for( int b = 0; b < BLOCK; ++b )
+            {
+                const Real x = Max(
+                    Scalar::Zero<Real>,
+                    Max(
+                        static_cast<Real>(P_lower[b]) - static_cast<Real>(Q_upper[b]),
+                        static_cast<Real>(Q_lower[b]) - static_cast<Real>(P_upper[b])
+                    )
+                );
+
+                d2[b] += x * x;
+            }
+        }
+
+        alignas(64) std::uint8_t overlapQ [BLOCK];
+
+        for( int b = 0; b < BLOCK; ++b )
+        {
+            overlapQ[b] = static_cast<std::uint8_t>( d2[b] <= r2[b] );
+        }
+
+        return AABB_PackBits<BLOCK>( &overlapQ[0] );
+    }
+
+} // namespace GJK
@@ -0,0 +1,1060 @@
+#pragma once
+
+#define CLASS BVH
+
+namespace GJK
+{
+    // Bounding volume hierarchy over serialized primitives.
+    //
+    // BoundingVolume_T is a bounding volume class with a Split routine (e.g., AABB_MedianSplit<...>); Primitive_T is the type of the primitive prototype (e.g., PolytopeBase<...> or Polytope<...>).
+    //
+    // The tree owns a copy of the primitives' serialized data. Split reorders the primitives, so that each node covers a contiguous range [NodeBegin()[node],NodeEnd()[node][ of PrimitiveData(); PrimitiveOrdering()[i] is the original index of the primitive in row i.
+    //
+    // The tree is built top-down. The first few levels are split one node at a time, with all threads working inside of Split. Then the open subtrees are distributed dynamically over the threads (see GJK_JobScheduler), and each thread builds its subtrees serially.
+    //
+    // BUILD METHODS
+    // BVH_BuildMethod::TopDownSplit: Each node is split by BoundingVolume_T::Split, and the children's bounding volumes are computed during the split.
+    // BVH_BuildMethod::TopDownIndexSplit: Like TopDownSplit, but Split does not move the primitives around. Instead, it works on a compact proxy array that stores the bounding box of each primitive as a BoundingVolume_T, and only the proxies and PrimitiveOrdering() are permuted. A single gather pass writes the primitives in tree order at the end. This saves most of the memory traffic for large primitives. The splits see the proxies' centers instead of the primitives' interior points, so the tree may differ slightly from TopDownSplit. Requires BoundingVolume_T to be derived from AABB (the box of boxes is the box of the primitives); otherwise TopDownSplit is used.
+    // BVH_BuildMethod::MortonCode, BVH_BuildMethod::HilbertCurve: Linear BVH. The primitives' interior points are quantized (see AABB::QuantizeCoordinates), mapped to 64-bit codes along the respective space-filling curve, and sorted once by RadixSort. A node is then split where the highest differing bit of its codes changes, which needs only a binary search per node. The bounding volumes are computed bottom-up afterwards: leaves by FromPrimitives, inner nodes by merging the children if BoundingVolume_T is derived from AABB. This is much faster than the Split-based build, but the boxes are a bit looser.
+    //
+    // NODE LAYOUT
+    // Node 0 is the root. Leaves have NodeLeft()[node] == NodeRight()[node] == -1. Otherwise the children are stored next to each other, NodeRight()[node] == NodeLeft()[node] + 1. Apart from that, the order of the nodes depends on the thread schedule.
+    // NodeData() is a matrix of size NodeCount() x BoundingVolume().Size(); use BoundingVolume_T::SetPointer( NodeData(), node ) to read the bounding volume of a node.
+    //
+    // PACKED NODE BOXES
+    // If BoundingVolume_T is derived from AABB, the tree stores the nodes' boxes as 2 * AMB_DIM floats per node instead (lower corner, then upper corner; see AABB::WritePackedBox), rounded outward so that they contain the boxes computed during the build. For AMB_DIM = 3 and SReal = double, that is 24 instead of 56 bytes per node, and the traversal in BVH_Collisions.hpp tests only these packed boxes. NodeData() is released at the end of Build and returns nullptr; Refit then works on the packed boxes directly (leaves from their primitives, inner nodes by the minima and maxima of their children's corners, which are exact in float). Pass keep_node_data = true to the constructor to keep NodeData() as well.
+    //
+    // REFIT
+    // If the primitives move but the connectivity stays the same (e.g., deforming meshes), Refit recomputes the bounding volumes bottom-up without splitting again, one tree level at a time with all threads. Refitted trees get looser over time; CostRatio compares the current cost of the tree with its cost right after the build and tells when a rebuild pays off.
+
+    enum class BVH_BuildMethod
+    {
+        TopDownSplit,
+        TopDownIndexSplit,
+        MortonCode,
+        HilbertCurve
+    };
+
+    template<typename BoundingVolume_T_, typename Primitive_T_>
+    class CLASS
+    {
+    public:
+
+        using BoundingVolume_T = BoundingVolume_T_;
+        using Primitive_T      = Primitive_T_;
+
+        using Real  = typename Primitive_T::Real;
+        using Int   = typename Primitive_T::Int;
+        using SReal = typename Primitive_T::SReal;
+
+        static constexpr Int AMB_DIM = Primitive_T::AmbDim();
+
+        static_assert( BoundingVolume_T::AmbDim() == AMB_DIM, "BVH: Ambient dimensions of bounding volume and primitive do not match." );
+
+        using PrimitiveSerialized_T = PrimitiveSerialized<AMB_DIM,Real,Int,SReal>;
+
+        // Storage type of the packed node boxes.
+        using PackedReal = float;
+
+        static constexpr bool PackedQ = std::is_base_of_v<AABB<AMB_DIM,Real,Int,SReal>,BoundingVolume_T>;
+
+    protected:
+
+        std::shared_ptr<BoundingVolume_T> C_proto;
+        std::shared_ptr<Primitive_T>      P_proto;
+
+        Int primitive_count = 0;
+        Int node_count      = 0;
+        Int max_leaf_size   = 1;
+        Int thread_count    = 1;
+
+        BVH_BuildMethod method = BVH_BuildMethod::TopDownSplit;
+
+        bool keep_node_data = false;
+
+        std::vector<SReal> P_serialized;
+        std::vector<Int>   P_ordering;
+
+        std::vector<SReal> C_serialized;
+        std::vector<Int>   C_begin;
+        std::vector<Int>   C_end;
+        std::vector<Int>   C_left;
+        std::vector<Int>   C_right;
+
+        // Scratch buffers for Split; the subtrees work on disjoint ranges, so all threads can share them.
+        std::vector<SReal> score;
+        std::vector<Int>   perm;
+        std::vector<Int>   inv_perm;
+
+        // Boxes of the nodes, rounded outward to PackedReal; only used if PackedQ.
+        std::vector<PackedReal> C_packed;
+
+        // Sorted space-filling-curve codes of the primitives; only used by the linear build methods.
+        std::vector<std::uint64_t> codes;
+
+        // Nodes grouped by depth (CSR layout); computed by the first Refit.
+        std::vector<Int> level_ptr;
+        std::vector<Int> level_nodes;
+
+        Real build_cost = 0;
+
+        alignas(ObjectAlignment) std::atomic<Int> node_counter { 0 };
+
+    public:
+
+        CLASS() = default;
+
+        // P_data is a matrix of size n x P_.Size() holding the serialized primitives.
+        CLASS(
+            cref<BoundingVolume_T> C_,
+            cref<Primitive_T> P_,
+            cptr<SReal> P_data,
+            const Int n,
+            const Int max_leaf_size_ = 1,           // nodes with at most this many primitives are not split
+            const Int thread_count_  = 1,
+            const BVH_BuildMethod method_ = BVH_BuildMethod::TopDownSplit,
+            const bool keep_node_data_    = false   // only relevant if PackedQ; keeps NodeData() next to the packed boxes
+        )
+        :   C_proto         ( C_.Clone()                    )
+        ,   P_proto         ( P_.Clone()                    )
+        ,   primitive_count ( n                             )
+        ,   max_leaf_size   ( Max( max_leaf_size_, Int(1) ) )
+        ,   thread_count    ( Max( thread_count_,  Int(1) ) )
+        ,   method          ( method_                       )
+        ,   keep_node_data  ( keep_node_data_               )
+        {
+            Build( P_data );
+        }
+
+        CLASS( const CLASS & other ) = delete;
+
+        ~CLASS() = default;
+
+    public:
+
+        Int PrimitiveCount() const
+        {
+            return primitive_count;
+        }
+
+        Int NodeCount() const
+        {
+            return node_count;
+        }
+
+        Int MaxLeafSize() const
+        {
+            return max_leaf_size;
+        }
+
+        Int ThreadCount() const
+        {
+            return thread_count;
+        }
+
+        BVH_BuildMethod BuildMethod() const
+        {
+            return method;
+        }
+
+        cref<BoundingVolume_T> BoundingVolume() const
+        {
+            return *C_proto;
+        }
+
+        cref<Primitive_T> Primitive() const
+        {
+            return *P_proto;
+        }
+
+        // Serialized primitives in tree order; matrix of size PrimitiveCount() x Primitive().Size().
+        SReal * PrimitiveData()
+        {
+            return P_serialized.data();
+        }
+
+        const SReal * PrimitiveData() const
+        {
+            return P_serialized.data();
+        }
+
+        const Int * PrimitiveOrdering() const
+        {
+            return P_ordering.data();
+        }
+
+        // Whether the tree keeps the serialized bounding volumes of the nodes; false for trees with packed boxes unless keep_node_data was set.
+        bool NodeDataQ() const
+        {
+            return !PackedQ || keep_node_data;
+        }
+
+        // Serialized bounding volumes of the nodes; matrix of size NodeCount() x BoundingVolume().Size(). Returns nullptr unless NodeDataQ().
+        SReal * NodeData()
+        {
+            return NodeDataQ() ? C_serialized.data() : nullptr;
+        }
+
+        const SReal * NodeData() const
+        {
+            return NodeDataQ() ? C_serialized.data() : nullptr;
+        }
+
+        // Packed boxes of the nodes; matrix of size NodeCount() x (2 * AMB_DIM). Returns nullptr unless PackedQ.
+        const PackedReal * PackedNodeBoxes() const
+        {
+            return PackedQ ? C_packed.data() : nullptr;
+        }
+
+        const Int * NodeBegin() const
+        {
+            return C_begin.data();
+        }
+
+        const Int * NodeEnd() const
+        {
+            return C_end.data();
+        }
+
+        const Int * NodeLeft() const
+        {
+            return C_left.data();
+        }
+
+        const Int * NodeRight() const
+        {
+            return C_right.data();
+        }
+
+        bool LeafQ( const Int node ) const
+        {
+            return C_left[node] < 0;
+        }
+
+        Int LeafCount() const
+        {
+            Int count = 0;
+
+            for( Int node = 0; node < node_count; ++node )
+            {
+                count += LeafQ(node);
+            }
+
+            return count;
+        }
+
+        Int Depth() const
+        {
+            if( node_count <= 0 )
+            {
+                return 0;
+            }
+
+            Int depth = 0;
+
+            std::vector<std::pair<Int,Int>> stack;
+
+            stack.emplace_back( 0, 1 );
+
+            while( !stack.empty() )
+            {
+                const auto [node, d] = stack.back();
+                stack.pop_back();
+
+                depth = Max( depth, d );
+
+                if( !LeafQ(node) )
+                {
+                    stack.emplace_back( C_left [node], d + 1 );
+                    stack.emplace_back( C_right[node], d + 1 );
+                }
+            }
+
+            return depth;
+        }
+
+        // ################################################################
+        // ############################  Refit  ###########################
+        // ################################################################
+
+        // Copies new primitive data into the tree and recomputes all bounding volumes. P_data is a matrix of size PrimitiveCount() x Primitive().Size() in the original order (like the constructor's argument).
+        void Refit( cptr<SReal> P_data )
+        {
+            const Int n      = primitive_count;
+            const Int P_Size = P_proto->Size();
+
+            ParallelDo(
+                [&]( const Int thread )
+                {
+                    const Int i_begin = JobPointer( n, thread_count, thread    );
+                    const Int i_end   = JobPointer( n, thread_count, thread +1 );
+
+                    for( Int i = i_begin; i < i_end; ++i )
+                    {
+                        std::copy_n( &P_data[P_Size * P_ordering[i]], P_Size, &P_serialized[P_Size * i] );
+                    }
+                },
+                thread_count
+            );
+
+            Refit();
+        }
+
+        // Recomputes all bounding volumes from the current PrimitiveData(), e.g., after it was modified in place.
+        void Refit()
+        {
+            tic(ClassName()+"::Refit");
+
+            if( node_count <= 0 )
+            {
+                toc(ClassName()+"::Refit");
+                return;
+            }
+
+            if( level_ptr.empty() )
+            {
+                ComputeLevels();
+            }
+
+            const Int level_count = static_cast<Int>(level_ptr.size()) - 1;
+
+            // Deepest level first, so that the children are always done when their parent is merged.
+            for( Int level = level_count - 1; level >= 0; --level )
+            {
+                const Int l_begin = level_ptr[level    ];
+                const Int l_end   = level_ptr[level + 1];
+
+                // Do not wake up all threads for the top levels.
+                const Int threads = Min( thread_count, Max( Int(1), (l_end - l_begin) / Int(64) ) );
+
+                ParallelDo(
+                    [&]( const Int thread )
+                    {
+                        std::shared_ptr<BoundingVolume_T> C = C_proto->Clone();
+                        std::shared_ptr<Primitive_T>      P = P_proto->Clone();
+
+                        // Scratch for the leaves' boxes if there is no NodeData().
+                        std::vector<SReal> C_data ( NodeDataQ() ? Int(0) : C->Size() );
+
+                        const Int k_begin = l_begin + JobPointer( l_end - l_begin, threads, thread    );
+                        const Int k_end   = l_begin + JobPointer( l_end - l_begin, threads, thread +1 );
+
+                        for( Int k = k_begin; k < k_end; ++k )
+                        {
+                            if( NodeDataQ() )
+                            {
+                                ComputeNodeBoundingVolume( level_nodes[k], *C, *P );
+                            }
+                            else
+                            {
+                                ComputeNodePackedBox( level_nodes[k], *C, *P, C_data.data() );
+                            }
+                        }
+                    },
+                    threads
+                );
+            }
+
+            if( NodeDataQ() )
+            {
+                ComputePackedBoxes();
+            }
+
+            toc(ClassName()+"::Refit");
+        }
+
+        // Surface area heuristic: the expected cost of a query that hits the root, i.e., the sum of the surface areas of all inner nodes plus the surface areas of the leaves weighted by their primitive counts, relative to the surface area of the root. For bounding volumes that are not derived from AABB, the squared radius is used as surface measure.
+        Real Cost() const
+        {
+            if( node_count <= 0 )
+            {
+                return 0;
+            }
+
+            const Real root_area = NodeSurfaceArea( 0 );
+
+            if( root_area <= Scalar::Zero<Real> )
+            {
+                return 0;
+            }
+
+            Real cost = 0;
+
+            for( Int node = 0; node < node_count; ++node )
+            {
+                cost += LeafQ(node)
+                    ? NodeSurfaceArea( node ) * static_cast<Real>( C_end[node] - C_begin[node] )
+                    : NodeSurfaceArea( node );
+            }
+
+            return cost / root_area;
+        }
+
+        // Cost() divided by the cost right after the build. Values well above 1 (say, 1.5) mean that the refitted tree has degraded and that a rebuild will speed up the queries.
+        Real CostRatio() const
+        {
+            return (build_cost > Scalar::Zero<Real>) ? Cost() / build_cost : Scalar::One<Real>;
+        }
+
+    protected:
+
+        Real NodeSurfaceArea( const Int node ) const
+        {
+            const Int C_Size = C_proto->Size();
+
+            if constexpr ( std::is_base_of_v<AABB<AMB_DIM,Real,Int,SReal>,BoundingVolume_T> )
+            {
+                // Half edge lengths; from the packed box if there is no NodeData().
+                std::array<SReal,AMB_DIM> L;
+
+                if( NodeDataQ() )
+                {
+                    copy_buffer<AMB_DIM>( &C_serialized[C_Size * node + 1 + AMB_DIM], L.data() );
+                }
+                else
+                {
+                    cptr<PackedReal> box = &C_packed[2 * AMB_DIM * node];
+
+                    for( Int k = 0; k < AMB_DIM; ++k )
+                    {
+                        L[k] = Scalar::Half<SReal> * ( static_cast<SReal>(box[k + AMB_DIM]) - static_cast<SReal>(box[k]) );
+                    }
+                }
+
+                if constexpr ( AMB_DIM == 1 )
+                {
+                    return static_cast<Real>( L[0] );
+                }
+                else
+                {
+                    Real area = 0;
+
+                    for( Int k = 0; k < AMB_DIM; ++k )
+                    {
+                        Real face = 1;
+
+                        for( Int j = 0; j < AMB_DIM; ++j )
+                        {
+                            face *= (j == k) ? Scalar::One<Real> : static_cast<Real>( L[j] );
+                        }
+
+                        area += face;
+                    }
+
+                    return area;
+                }
+            }
+            else
+            {
+                return static_cast<Real>( C_serialized[C_Size * node] );
+            }
+        }
+
+        void ComputePackedBoxes()
+        {
+            if constexpr ( PackedQ )
+            {
+                const Int C_Size = C_proto->Size();
+
+                C_packed.resize( node_count * 2 * AMB_DIM );
+
+                const Int threads = Min( thread_count, Max( Int(1), node_count / Int(65536) ) );
+
+                ParallelDo(
+                    [&]( const Int thread )
+                    {
+                        const Int k_begin = JobPointer( node_count, threads, thread    );
+                        const Int k_end   = JobPointer( node_count, threads, thread +1 );
+
+                        for( Int node = k_begin; node < k_end; ++node )
+                        {
+                            AABB<AMB_DIM,Real,Int,SReal>::WritePackedBox(
+                                &C_serialized[C_Size * node], &C_packed[2 * AMB_DIM * node]
+                            );
+                        }
+                    },
+                    threads
+                );
+            }
+        }
+
+        void ComputeLevels()
+        {
+            level_ptr  .clear();
+            level_nodes.clear();
+
+            level_nodes.reserve( node_count );
+
+            level_ptr.push_back( 0 );
+            level_nodes.push_back( 0 );
+            level_ptr.push_back( 1 );
+
+            Int l_begin = 0;
+
+            while( l_begin < static_cast<Int>(level_nodes.size()) )
+            {
+                const Int l_end = static_cast<Int>(level_nodes.size());
+
+                for( Int k = l_begin; k < l_end; ++k )
+                {
+                    const Int node = level_nodes[k];
+
+                    if( !LeafQ(node) )
+                    {
+                        level_nodes.push_back( C_left [node] );
+                        level_nodes.push_back( C_right[node] );
+                    }
+                }
+
+                if( static_cast<Int>(level_nodes.size()) > l_end )
+                {
+                    level_ptr.push_back( static_cast<Int>(level_nodes.size()) );
+                }
+
+                l_begin = l_end;
+            }
+        }
+
+    protected:
+
+        // ################################################################
+        // ############################  Build  ###########################
+        // ################################################################
+
+        void Build( cptr<SReal> P_data )
+        {
+            tic(ClassName()+"::Build");
+
+            const Int n      = primitive_count;
+            const Int P_Size = P_proto->Size();
+            const Int C_Size = C_proto->Size();
+
+            node_count = 0;
+            build_cost = 0;
+
+            level_ptr  .clear();
+            level_nodes.clear();
+            C_packed   .clear();
+
+            if( n <= 0 )
+            {
+                toc(ClassName()+"::Build");
+                return;
+            }
+
+            P_ordering.resize( n );
+            std::iota( P_ordering.begin(), P_ordering.end(), Int(0) );
+
+            const bool linearQ = (method == BVH_BuildMethod::MortonCode) || (method == BVH_BuildMethod::HilbertCurve);
+
+            const bool proxyQ = (method == BVH_BuildMethod::TopDownIndexSplit)
+                && std::is_base_of_v<AABB<AMB_DIM,Real,Int,SReal>,BoundingVolume_T>;
+
+            // The primitives that Split works on: either the primitives themselves or their bounding boxes (see BVH_BuildMethod::TopDownIndexSplit).
+            std::shared_ptr<BoundingVolume_T> B_proto;
+            std::vector<SReal>                B_serialized;
+
+            if( proxyQ )
+            {
+                B_proto = C_proto->Clone();
+
+                ComputeProxies( P_data, B_serialized );
+
+                // Filled by the final gather.
+                P_serialized.resize( n * P_Size );
+            }
+            else
+            {
+                P_serialized.assign( P_data, P_data + n * P_Size );
+            }
+
+            PrimitiveSerialized_T * S_proto = proxyQ
+                ? static_cast<PrimitiveSerialized_T *>( B_proto.get() )
+                : static_cast<PrimitiveSerialized_T *>( P_proto.get() );
+
+            SReal * S_serialized = proxyQ ? B_serialized.data() : P_serialized.data();
+
+            if( linearQ )
+            {
+                SortAlongCurve();
+            }
+            else
+            {
+                score   .resize( n );
+                perm    .resize( n );
+                inv_perm.resize( n );
+            }
+
+            // Every split creates two nonempty children, so there are at most 2 n - 1 nodes.
+            const Int max_node_count = 2 * n - 1;
+
+            C_serialized.assign( max_node_count * C_Size, Scalar::Zero<SReal> );
+            C_begin     .assign( max_node_count, Int(0)  );
+            C_end       .assign( max_node_count, Int(0)  );
+            C_left      .assign( max_node_count, Int(-1) );
+            C_right     .assign( max_node_count, Int(-1) );
+
+            C_begin[0] = 0;
+            C_end  [0] = n;
+
+            node_counter.store( 1 );
+
+            if( !linearQ )
+            {
+                C_proto->SetPointer( C_serialized.data(), 0 );
+                C_proto->FromPrimitives( *S_proto, S_serialized, 0, n, thread_count );
+            }
+
+            // Split the top levels breadth-first with all threads working inside of Split, until there are enough subtrees to keep the threads busy.
+            std::vector<Int> open   { 0 };
+            std::vector<Int> next;
+
+            // Nodes handled in this serial phase; the linear build computes their bounding volumes last.
+            std::vector<Int> top_nodes;
+
+            std::vector<SReal> child_data ( 2 * C_Size );
+
+            const Int target_count = (thread_count > 1) ? 4 * thread_count : 1;
+
+            while( !open.empty() && (static_cast<Int>(open.size()) < target_count) )
+            {
+                next.clear();
+
+                for( const Int node : open )
+                {
+                    top_nodes.push_back( node );
+
+                    if( linearQ
+                        ? SplitNodeByCode( node )
+                        : SplitNode( node, *C_proto, *S_proto, S_serialized, child_data.data(), thread_count )
+                    )
+                    {
+                        next.push_back( C_left [node] );
+                        next.push_back( C_right[node] );
+                    }
+                }
+
+                std::swap( open, next );
+            }
+
+            // Build the remaining subtrees in parallel.
+            GJK_JobScheduler<Int> scheduler ( Int(0), static_cast<Int>(open.size()), thread_count, Int(1) );
+
+            ParallelDo(
+                [&]( const Int thread )
+                {
+                    std::shared_ptr<BoundingVolume_T> C = C_proto->Clone();
+                    std::shared_ptr<Primitive_T>      P = P_proto->Clone();
+
+                    std::shared_ptr<PrimitiveSerialized_T> S = S_proto->Clone();
+
+                    std::vector<SReal> buffer ( 2 * C_Size );
+                    std::vector<Int>   stack;
+                    std::vector<Int>   subtree_nodes;
+
+                    auto jobs = scheduler.GetWorker( thread );
+
+                    Int k;
+
+                    while( jobs.Next(k) )
+                    {
+                        stack.push_back( open[k] );
+
+                        while( !stack.empty() )
+                        {
+                            const Int node = stack.back();
+                            stack.pop_back();
+
+                            if( linearQ )
+                            {
+                                subtree_nodes.push_back( node );
+                            }
+
+                            if( linearQ
+                                ? SplitNodeByCode( node )
+                                : SplitNode( node, *C, *S, S_serialized, buffer.data(), Int(1) )
+                            )
+                            {
+                                stack.push_back( C_right[node] );
+                                stack.push_back( C_left [node] );
+                            }
+                        }
+
+                        // Children are visited after their parents, so the reverse order is bottom-up.
+                        for( auto node = subtree_nodes.rbegin(); node != subtree_nodes.rend(); ++node )
+                        {
+                            ComputeNodeBoundingVolume( *node, *C, *P );
+                        }
+
+                        subtree_nodes.clear();
+                    }
+                },
+                thread_count
+            );
+
+            if( linearQ )
+            {
+                for( auto node = top_nodes.rbegin(); node != top_nodes.rend(); ++node )
+                {
+                    ComputeNodeBoundingVolume( *node, *C_proto, *P_proto );
+                }
+            }
+
+            if( proxyQ )
+            {
+                // The only pass that moves the primitives.
+                ParallelDo(
+                    [&]( const Int thread )
+                    {
+                        const Int i_begin = JobPointer( n, thread_count, thread    );
+                        const Int i_end   = JobPointer( n, thread_count, thread +1 );
+
+                        for( Int i = i_begin; i < i_end; ++i )
+                        {
+                            std::copy_n( &P_data[P_Size * P_ordering[i]], P_Size, &P_serialized[P_Size * i] );
+                        }
+                    },
+                    thread_count
+                );
+            }
+
+            node_count = node_counter.load();
+
+            C_serialized.resize( node_count * C_Size );
+            C_begin     .resize( node_count );
+            C_end       .resize( node_count );
+            C_left      .resize( node_count );
+            C_right     .resize( node_count );
+
+            ComputePackedBoxes();
+
+            if( !NodeDataQ() )
+            {
+                C_serialized.clear();
+                C_serialized.shrink_to_fit();
+            }
+
+            build_cost = Cost();
+
+            toc(ClassName()+"::Build");
+        }
+
+        // Tries to split node; returns true if two children have been created.
+        // The children's bounding volumes are computed into buffer first, because their node IDs are only reserved after the split was successful.
+        bool SplitNode(
+            const Int node,
+            mref<BoundingVolume_T> C,
+            mref<PrimitiveSerialized_T> P,
+            mptr<SReal> P_data,                     // P_serialized or the proxies of BVH_BuildMethod::TopDownIndexSplit
+            mptr<SReal> buffer,
+            const Int threads
+        )
+        {
+            const Int begin = C_begin[node];
+            const Int end   = C_end  [node];
+
+            if( end - begin <= max_leaf_size )
+            {
+                return false;
+            }
+
+            const Int C_Size = C.Size();
+
+            const Int split_index = C.Split(
+                P, P_data, begin, end, P_ordering.data(),
+                C_serialized.data(), node,
+                &buffer[0],      Int(0),
+                &buffer[C_Size], Int(0),
+                score.data(), perm.data(), inv_perm.data(),
+                threads
+            );
+
+            if( (split_index <= begin) || (split_index >= end) )
+            {
+                return false;
+            }
+
+            const Int L = node_counter.fetch_add( 2 );
+            const Int R = L + 1;
+
+            std::copy_n( &buffer[0     ], C_Size, &C_serialized[C_Size * L] );
+            std::copy_n( &buffer[C_Size], C_Size, &C_serialized[C_Size * R] );
+
+            C_begin[L] = begin;
+            C_end  [L] = split_index;
+            C_begin[R] = split_index;
+            C_end  [R] = end;
+
+            C_left [node] = L;
+            C_right[node] = R;
+
+            return true;
+        }
+
+        // Writes the bounding box of primitive i, as a BoundingVolume_T, to row i of B_data.
+        void ComputeProxies( cptr<SReal> P_data, mref<std::vector<SReal>> B_data )
+        {
+            const Int n      = primitive_count;
+            const Int P_Size = P_proto->Size();
+            const Int C_Size = C_proto->Size();
+
+            B_data.resize( n * C_Size );
+
+            ParallelDo(
+                [&]( const Int thread )
+                {
+                    std::shared_ptr<BoundingVolume_T> B = C_proto->Clone();
+                    std::shared_ptr<Primitive_T>      P = P_proto->Clone();
+
+                    // P_data is read-only, but the primitives have to be mapped onto mutable memory.
+                    std::vector<SReal> record ( P_Size );
+
+                    const Int i_begin = JobPointer( n, thread_count, thread    );
+                    const Int i_end   = JobPointer( n, thread_count, thread +1 );
+
+                    for( Int i = i_begin; i < i_end; ++i )
+                    {
+                        std::copy_n( &P_data[P_Size * i], P_Size, record.data() );
+
+                        B->SetPointer( B_data.data(), i );
+                        B->FromPrimitives( *P, record.data(), Int(0), Int(1), Int(1) );
+                    }
+                },
+                thread_count
+            );
+        }
+
+        // Computes the primitives' codes along the space-filling curve selected by method, sorts them, and reorders P_serialized and P_ordering accordingly.
+        void SortAlongCurve()
+        {
+            tic(ClassName()+"::SortAlongCurve");
+
+            const Int n      = primitive_count;
+            const Int P_Size = P_proto->Size();
+
+            using AABB_T = AABB<AMB_DIM,Real,Int,SReal>;
+
+            std::vector<Real> x ( n * AMB_DIM );
+
+            std::vector<std::array<SReal,AMB_DIM>> thread_lo ( thread_count );
+            std::vector<std::array<SReal,AMB_DIM>> thread_hi ( thread_count );
+
+            // Interior points and their bounding box.
+            ParallelDo(
+                [&]( const Int thread )
+                {
+                    std::shared_ptr<Primitive_T> P = P_proto->Clone();
+
+                    const Int i_begin = JobPointer( n, thread_count, thread    );
+                    const Int i_end   = JobPointer( n, thread_count, thread +1 );
+
+                    mref<std::array<SReal,AMB_DIM>> lo = thread_lo[thread];
+                    mref<std::array<SReal,AMB_DIM>> hi = thread_hi[thread];
+
+                    lo.fill( Scalar::Max<SReal> );
+                    hi.fill( Scalar::Min<SReal> );
+
+                    for( Int i = i_begin; i < i_end; ++i )
+                    {
+                        P->SetPointer( P_serialized.data(), i );
+                        P->InteriorPoint( &x[AMB_DIM * i] );
+
+                        for( Int k = 0; k < AMB_DIM; ++k )
+                        {
+                            lo[k] = Min( lo[k], static_cast<SReal>(x[AMB_DIM * i + k]) );
+                            hi[k] = Max( hi[k], static_cast<SReal>(x[AMB_DIM * i + k]) );
+                        }
+                    }
+                },
+                thread_count
+            );
+
+            std::array<SReal,AMB_DIM> c;
+
+            SReal L = Scalar::Zero<SReal>;
+
+            for( Int k = 0; k < AMB_DIM; ++k )
+            {
+                SReal lo = Scalar::Max<SReal>;
+                SReal hi = Scalar::Min<SReal>;
+
+                for( Int thread = 0; thread < thread_count; ++thread )
+                {
+                    lo = Min( lo, thread_lo[thread][k] );
+                    hi = Max( hi, thread_hi[thread][k] );
+                }
+
+                c[k] = Scalar::Half<SReal> * ( hi + lo );
+
+                L = Max( L, Scalar::Half<SReal> * ( hi - lo ) );
+            }
+
+            codes.resize( n );
+
+            ParallelDo(
+                [&]( const Int thread )
+                {
+                    const Int i_begin = JobPointer( n, thread_count, thread    );
+                    const Int i_end   = JobPointer( n, thread_count, thread +1 );
+
+                    std::uint64_t q [AMB_DIM];
+
+                    for( Int i = i_begin; i < i_end; ++i )
+                    {
+                        AABB_T::QuantizeCoordinates( &x[AMB_DIM * i], c.data(), L, &q[0] );
+
+                        codes[i] = (method == BVH_BuildMethod::HilbertCurve)
+                            ? HilbertCode<AMB_DIM>( &q[0] )
+                            : MortonCode <AMB_DIM>( &q[0] );
+                    }
+                },
+                thread_count
+            );
+
+            RadixSort( n, codes.data(), P_ordering.data(), AMB_DIM * AABB_T::QuantizationBits(), thread_count );
+
+            std::vector<SReal> P_sorted ( n * P_Size );
+
+            ParallelDo(
+                [&]( const Int thread )
+                {
+                    const Int i_begin = JobPointer( n, thread_count, thread    );
+                    const Int i_end   = JobPointer( n, thread_count, thread +1 );
+
+                    for( Int i = i_begin; i < i_end; ++i )
+                    {
+                        std::copy_n( &P_serialized[P_Size * P_ordering[i]], P_Size, &P_sorted[P_Size * i] );
+                    }
+                },
+                thread_count
+            );
+
+            std::swap( P_serialized, P_sorted );
+
+            toc(ClassName()+"::SortAlongCurve");
+        }
+
+        // Linear build: Splits node where the highest bit that differs between its codes changes (in the middle if all codes are equal); returns true if two children have been created. The bounding volumes are computed later by ComputeNodeBoundingVolume.
+        bool SplitNodeByCode( const Int node )
+        {
+            const Int begin = C_begin[node];
+            const Int end   = C_end  [node];
+
+            if( end - begin <= max_leaf_size )
+            {
+                return false;
+            }
+
+            const std::uint64_t a = codes[begin];
+            const std::uint64_t b = codes[end-1];
+
+            Int split_index;
+
+            if( a == b )
+            {
+                split_index = begin + (end - begin) / 2;
+            }
+            else
+            {
+                int h = 63;
+
+                while( ((a ^ b) >> h) == 0 )
+                {
+                    --h;
+                }
+
+                // The codes are sorted, so the ones with bit h equal to that of a come first.
+                split_index = static_cast<Int>(
+                    std::partition_point(
+                        &codes[begin], &codes[begin] + (end - begin),
+                        [=]( const std::uint64_t code ){ return (code >> h) == (a >> h); }
+                    )
+                    - &codes[0]
+                );
+            }
+
+            const Int L = node_counter.fetch_add( 2 );
+            const Int R = L + 1;
+
+            C_begin[L] = begin;
+            C_end  [L] = split_index;
+            C_begin[R] = split_index;
+            C_end  [R] = end;
+
+            C_left [node] = L;
+            C_right[node] = R;
+
+            return true;
+        }
+
+        // Linear build and Refit: Computes the bounding volume of node; the children's bounding volumes must be known already.
+        void ComputeNodeBoundingVolume(
+            const Int node,
+            mref<BoundingVolume_T> C,
+            mref<Primitive_T> P
+        )
+        {
+            C.SetPointer( C_serialized.data(), node );
+
+            if constexpr ( std::is_base_of_v<AABB<AMB_DIM,Real,Int,SReal>,BoundingVolume_T> )
+            {
+                if( !LeafQ(node) )
+                {
+                    const Int C_Size = C.Size();
+
+                    std::copy_n( &C_serialized[C_Size * C_left[node]], C_Size, &C_serialized[C_Size * node] );
+
+                    C.Merge( C_serialized.data(), C_right[node] );
+
+                    return;
+                }
+            }
+
+            C.FromPrimitives( P, P_serialized.data(), C_begin[node], C_end[node], Int(1) );
+        }
+
+        // Refit without NodeData(): Computes the packed box of node; the children's packed boxes must be known already. Minima and maxima of floats are exact, so an inner node gets the smallest packed box that contains its children.
+        void ComputeNodePackedBox(
+            const Int node,
+            mref<BoundingVolume_T> C,
+            mref<Primitive_T> P,
+            mptr<SReal> C_data                      // scratch of size C.Size()
+        )
+        {
+            if constexpr ( PackedQ )
+            {
+                mptr<PackedReal> box = &C_packed[2 * AMB_DIM * node];
+
+                if( LeafQ(node) )
+                {
+                    C.SetPointer( C_data, 0 );
+                    C.FromPrimitives( P, P_serialized.data(), C_begin[node], C_end[node], Int(1) );
+
+                    AABB<AMB_DIM,Real,Int,SReal>::WritePackedBox( C_data, box );
+                }
+                else
+                {
+                    cptr<PackedReal> L = &C_packed[2 * AMB_DIM * C_left [node]];
+                    cptr<PackedReal> R = &C_packed[2 * AMB_DIM * C_right[node]];
+
+                    for( Int k = 0; k < AMB_DIM; ++k )
+                    {
+                        box[k          ] = Min( L[k          ], R[k          ] );
+                        box[k + AMB_DIM] = Max( L[k + AMB_DIM], R[k + AMB_DIM] );
+                    }
+                }
+            }
+        }
+
+    public:
+
+        std::string ClassName() const
+        {
+            return TO_STD_STRING(CLASS)+"<"+(C_proto ? C_proto->ClassName() : std::string("?"))+","+(P_proto ? P_proto->ClassName() : std::string("?"))+">";
+        }
+
+    }; // BVH
+
+} // namespace GJK
+
+#undef CLASS
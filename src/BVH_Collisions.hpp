@@ -0,0 +1,648 @@
+#pragma once
+
+namespace GJK
+{
+    // ################################################################
+    // #####################  BVH_PairTraversal  ######################
+    // ################################################################
+
+    // Dual-tree traversal of two bounding volume hierarchies S and T.
+    //
+    // It emits the candidate primitive pairs (i,j) one at a time through Next, so that it can be handed to GJK_Algorithm_Vectorized::Process as job source: The narrow phase consumes the pairs right after the broad phase has produced them, and no pair list is ever stored.
+    //
+    // Node pairs are processed depth-first with an explicit stack. The traversal starts from the seed node pairs handed out by a GJK_JobScheduler worker; once the stack runs empty, it pulls the next seed.
+    //
+    // Offsets (optional) are given per primitive in tree order, together with the maximal offset per node. Then two primitives are candidates if their offsets may intersect.
+    //
+    // Primitive indices i, j refer to the rows of S.PrimitiveData() and T.PrimitiveData().
+    //
+    // If both trees store packed node boxes (see BVH), the node tests only read these; otherwise the bounding volumes are tested by GJK_Algorithm. The node pairs are taken from the stack in blocks of BLOCK_SIZE; with packed boxes, a block is gathered into SoA layout and tested at once by PackedBox_OverlapMask.
+
+    template<typename S_BVH_T, typename T_BVH_T>
+    class BVH_PairTraversal
+    {
+    public:
+
+        using Real  = typename S_BVH_T::Real;
+        using Int   = typename S_BVH_T::Int;
+        using SReal = typename S_BVH_T::SReal;
+
+        using S_BV_T = typename S_BVH_T::BoundingVolume_T;
+        using T_BV_T = typename T_BVH_T::BoundingVolume_T;
+
+        using NodePair_T = std::pair<Int,Int>;
+        using Worker_T   = typename GJK_JobScheduler<Int>::Worker;
+
+        static constexpr Int AMB_DIM = S_BVH_T::AMB_DIM;
+
+        static_assert( T_BVH_T::AMB_DIM == AMB_DIM, "BVH_PairTraversal: Ambient dimensions of the trees do not match." );
+
+        static constexpr bool packedQ = S_BVH_T::PackedQ && T_BVH_T::PackedQ
+            && std::is_same_v<typename S_BVH_T::PackedReal,typename T_BVH_T::PackedReal>;
+
+        using PackedReal = typename S_BVH_T::PackedReal;
+
+        // Number of node pairs that are tested together.
+        static constexpr Int BLOCK_SIZE = 8;
+
+    protected:
+
+        S_BVH_T & S;
+        T_BVH_T & T;
+
+        const Real * S_offsets;         // per primitive; may be nullptr
+        const Real * T_offsets;
+        const Real * S_node_offsets;    // maximal offset per node; may be nullptr
+        const Real * T_node_offsets;
+
+        const NodePair_T * seeds = nullptr;
+        Worker_T * worker        = nullptr;
+
+        std::shared_ptr<S_BV_T> A;
+        std::shared_ptr<T_BV_T> B;
+
+        // Bounding volumes reconstructed from packed boxes for trees without NodeData().
+        std::vector<SReal> A_data;
+        std::vector<SReal> B_data;
+
+        GJK_Algorithm<AMB_DIM,Real,Int> gjk;
+
+        std::vector<NodePair_T> stack;
+
+        // Intersecting pairs of leaves that have not been visited yet.
+        std::vector<NodePair_T> leaves;
+
+        // Current block of node pairs and their boxes in SoA layout (see PackedBox_OverlapMask).
+        NodePair_T block [BLOCK_SIZE];
+
+        alignas(64) PackedReal S_boxes [2 * AMB_DIM * BLOCK_SIZE] = {};
+        alignas(64) PackedReal T_boxes [2 * AMB_DIM * BLOCK_SIZE] = {};
+        alignas(64) Real       r2      [BLOCK_SIZE]               = {};
+
+        const Int S_Size;
+        const Int T_Size;
+
+        // Current pair of leaves and cursor in it.
+        Int i_begin = 0;
+        Int i_end   = 0;
+        Int j_begin = 0;
+        Int j_end   = 0;
+        Int i       = 0;
+        Int j       = 0;
+
+        Int count   = 0;
+
+        NodePair_T current { -1, -1 };
+
+    public:
+
+        BVH_PairTraversal(
+            S_BVH_T & S_, const Real * S_offsets_, const Real * S_node_offsets_,
+            T_BVH_T & T_, const Real * T_offsets_, const Real * T_node_offsets_
+        )
+        :   S               ( S_                              )
+        ,   T               ( T_                              )
+        ,   S_offsets       ( S_offsets_                      )
+        ,   T_offsets       ( T_offsets_                      )
+        ,   S_node_offsets  ( S_node_offsets_                 )
+        ,   T_node_offsets  ( T_node_offsets_                 )
+        ,   A               ( S_.BoundingVolume().Clone()     )
+        ,   B               ( T_.BoundingVolume().Clone()     )
+        ,   A_data          ( S_.BoundingVolume().Size()      )
+        ,   B_data          ( T_.BoundingVolume().Size()      )
+        ,   S_Size          ( S_.Primitive().Size()           )
+        ,   T_Size          ( T_.Primitive().Size()           )
+        {}
+
+        // The traversal pulls the indices of its seeds from worker.
+        void SetSeeds( const NodePair_T * seeds_, Worker_T & worker_ )
+        {
+            seeds  = seeds_;
+            worker = &worker_;
+        }
+
+        // Returns the current candidate pair (i,j); valid after Next returned true.
+        NodePair_T CurrentPair() const
+        {
+            return current;
+        }
+
+        // Number of candidate pairs emitted so far.
+        Int CandidateCount() const
+        {
+            return count;
+        }
+
+        bool OffsetQ() const
+        {
+            return S_offsets != nullptr;
+        }
+
+        Real Offset( const Int i_, const Int j_ ) const
+        {
+            return OffsetQ() ? S_offsets[i_] + T_offsets[j_] : Scalar::Zero<Real>;
+        }
+
+        // Job source interface for GJK_Algorithm_Vectorized::Process. Writes a running index to k and returns true if there is another candidate pair; use CurrentPair to get it.
+        bool Next( mref<Int> k )
+        {
+            while( true )
+            {
+                while( i < i_end )
+                {
+                    const Int i_ = i;
+                    const Int j_ = j;
+
+                    ++j;
+
+                    if( j >= j_end )
+                    {
+                        j = j_begin;
+                        ++i;
+                    }
+
+                    if( SpheresIntersectingQ( i_, j_ ) )
+                    {
+                        current = NodePair_T( i_, j_ );
+                        k = count;
+                        ++count;
+
+                        return true;
+                    }
+                }
+
+                if( !NextLeafPair() )
+                {
+                    return false;
+                }
+            }
+        }
+
+        // Tests the bounding volumes of the nodes a in S and b in T for intersection.
+        bool NodesIntersectingQ( const Int a, const Int b )
+        {
+            const Real r = (S_node_offsets != nullptr) ? S_node_offsets[a] + T_node_offsets[b] : Scalar::Zero<Real>;
+
+            if constexpr ( packedQ )
+            {
+                const Real d2 = AABB<AMB_DIM,Real,Int,SReal>::PackedBoxSquaredDistance(
+                    S.PackedNodeBoxes() + 2 * AMB_DIM * a,
+                    T.PackedNodeBoxes() + 2 * AMB_DIM * b
+                );
+
+                return d2 <= r * r;
+            }
+
+            SetNodePointer( S, a, *A, A_data );
+            SetNodePointer( T, b, *B, B_data );
+
+            if( r > Scalar::Zero<Real> )
+            {
+                return gjk.SquaredDistance( *A, *B ) <= r * r;
+            }
+            else
+            {
+                return gjk.IntersectingQ( *A, *B );
+            }
+        }
+
+        // Tests the node pairs pairs[0],...,pairs[count-1] with count <= BLOCK_SIZE; bit b of the result is set if the bounding volumes of pairs[b] intersect.
+        std::uint64_t NodesIntersectingMask( cptr<NodePair_T> pairs, const Int count )
+        {
+            if constexpr ( packedQ )
+            {
+                cptr<PackedReal> S_packed = S.PackedNodeBoxes();
+                cptr<PackedReal> T_packed = T.PackedNodeBoxes();
+
+                for( Int b = 0; b < count; ++b )
+                {
+                    const auto [a,c] = pairs[b];
+
+                    for( Int k = 0; k < 2 * AMB_DIM; ++k )
+                    {
+                        S_boxes[BLOCK_SIZE * k + b] = S_packed[2 * AMB_DIM * a + k];
+                        T_boxes[BLOCK_SIZE * k + b] = T_packed[2 * AMB_DIM * c + k];
+                    }
+
+                    const Real r = (S_node_offsets != nullptr) ? S_node_offsets[a] + T_node_offsets[c] : Scalar::Zero<Real>;
+
+                    r2[b] = r * r;
+                }
+
+                const std::uint64_t bits = PackedBox_OverlapMask<AMB_DIM,BLOCK_SIZE>( &S_boxes[0], &T_boxes[0], &r2[0] );
+
+                return bits & ( (std::uint64_t(1) << count) - std::uint64_t(1) );
+            }
+            else
+            {
+                std::uint64_t bits = 0;
+
+                for( Int b = 0; b < count; ++b )
+                {
+                    bits |= static_cast<std::uint64_t>( NodesIntersectingQ( pairs[b].first, pairs[b].second ) ) << b;
+                }
+
+                return bits;
+            }
+        }
+
+        // Appends the children pairs of the node pair (a,b) to out; we split the node with the larger bounding volume. Returns false if both nodes are leaves.
+        bool Refine( const Int a, const Int b, mref<std::vector<NodePair_T>> out ) const
+        {
+            const bool a_leafQ = S.LeafQ(a);
+            const bool b_leafQ = T.LeafQ(b);
+
+            if( a_leafQ && b_leafQ )
+            {
+                return false;
+            }
+
+            const Real a_r2 = NodeSquaredRadius( S, a );
+            const Real b_r2 = NodeSquaredRadius( T, b );
+
+            if( b_leafQ || ( !a_leafQ && (a_r2 >= b_r2) ) )
+            {
+                out.emplace_back( S.NodeRight()[a], b );
+                out.emplace_back( S.NodeLeft ()[a], b );
+            }
+            else
+            {
+                out.emplace_back( a, T.NodeRight()[b] );
+                out.emplace_back( a, T.NodeLeft ()[b] );
+            }
+
+            return true;
+        }
+
+    protected:
+
+        // Squared radius of the bounding volume of node; taken from the packed boxes if available, so that the traversal does not touch NodeData() at all.
+        template<typename BVH_T>
+        static Real NodeSquaredRadius( const BVH_T & X, const Int node )
+        {
+            if constexpr ( BVH_T::PackedQ )
+            {
+                const typename BVH_T::PackedReal * box = X.PackedNodeBoxes() + 2 * AMB_DIM * node;
+
+                Real r2 = Scalar::Zero<Real>;
+
+                for( Int k = 0; k < AMB_DIM; ++k )
+                {
+                    const Real L = Scalar::Half<Real> * ( static_cast<Real>(box[k + AMB_DIM]) - static_cast<Real>(box[k]) );
+
+                    r2 += L * L;
+                }
+
+                return r2;
+            }
+            else
+            {
+                return static_cast<Real>( X.NodeData()[ X.BoundingVolume().Size() * node ] );
+            }
+        }
+
+        // Points C to the bounding volume of node; if X does not keep NodeData(), it is reconstructed from the packed box in C_data.
+        template<typename BVH_T, typename BV_T>
+        static void SetNodePointer( mref<BVH_T> X, const Int node, mref<BV_T> C, mref<std::vector<SReal>> C_data )
+        {
+            if constexpr ( BVH_T::PackedQ )
+            {
+                if( !X.NodeDataQ() )
+                {
+                    AABB<AMB_DIM,Real,Int,SReal>::ReadPackedBox( X.PackedNodeBoxes() + 2 * AMB_DIM * node, C_data.data() );
+
+                    C.SetPointer( C_data.data(), 0 );
+
+                    return;
+                }
+            }
+
+            C.SetPointer( X.NodeData(), node );
+        }
+
+        // Pops blocks of node pairs until it finds an intersecting pair of leaves; returns false if the traversal is complete.
+        bool NextLeafPair()
+        {
+            while( leaves.empty() )
+            {
+                if( stack.empty() )
+                {
+                    Int s;
+
+                    if( (worker == nullptr) || !worker->Next(s) )
+                    {
+                        return false;
+                    }
+
+                    stack.push_back( seeds[s] );
+                }
+
+                const Int count = Min( BLOCK_SIZE, static_cast<Int>(stack.size()) );
+
+                std::copy_n( stack.end() - count, count, &block[0] );
+
+                stack.resize( stack.size() - static_cast<std::size_t>(count) );
+
+                const std::uint64_t bits = NodesIntersectingMask( &block[0], count );
+
+                for( Int b = 0; b < count; ++b )
+                {
+                    if( (bits >> b) & std::uint64_t(1) )
+                    {
+                        const auto [a,c] = block[b];
+
+                        if( !Refine( a, c, stack ) )
+                        {
+                            leaves.push_back( block[b] );
+                        }
+                    }
+                }
+            }
+
+            const auto [a,b] = leaves.back();
+            leaves.pop_back();
+
+            i_begin = S.NodeBegin()[a];
+            i_end   = S.NodeEnd  ()[a];
+            j_begin = T.NodeBegin()[b];
+            j_end   = T.NodeEnd  ()[b];
+            i       = i_begin;
+            j       = j_begin;
+
+            return true;
+        }
+
+        // Cheap test with the bounding spheres stored in every serialized primitive (squared radius and interior point). Saves many GJK calls for leaves with several primitives.
+        bool SpheresIntersectingQ( const Int i_, const Int j_ ) const
+        {
+            const SReal * p = &S.PrimitiveData()[S_Size * i_];
+            const SReal * q = &T.PrimitiveData()[T_Size * j_];
+
+            Real d2 = Scalar::Zero<Real>;
+
+            for( Int k = 0; k < AMB_DIM; ++k )
+            {
+                const Real diff = static_cast<Real>(p[1+k]) - static_cast<Real>(q[1+k]);
+
+                d2 += diff * diff;
+            }
+
+            const Real r = std::sqrt( static_cast<Real>(p[0]) ) + std::sqrt( static_cast<Real>(q[0]) ) + Offset( i_, j_ );
+
+            return d2 <= r * r;
+        }
+
+    }; // BVH_PairTraversal
+
+
+    // ################################################################
+    // ##################  BVH_IntersectingPairs  #####################
+    // ################################################################
+
+    // Returns all pairs (i,j) of a primitive i in S and a primitive j in T that intersect (or whose offsets intersect), with i and j referring to the original numbering of the primitives before the trees were built. The pairs are sorted lexicographically.
+    //
+    // Broad and narrow phase are fused: Each thread traverses a share of the node pairs and feeds the candidate pairs directly into the lanes of GJK_Algorithm_Vectorized; only the intersecting pairs are stored. The top levels of the traversal are expanded on the calling thread to generate enough seeds; these are then distributed dynamically over the threads.
+    //
+    // sub_algorithm selects the distance subalgorithm of the narrow phase (see GJK_SubAlgorithm); GJK_SubAlgorithm::SignedVolumes is more robust for meshes with thin sliver triangles.
+
+    template<typename S_BVH_T, typename T_BVH_T>
+    std::vector<std::pair<typename S_BVH_T::Int,typename S_BVH_T::Int>> BVH_IntersectingPairs_Implementation(
+        S_BVH_T & S, const typename S_BVH_T::Real * S_offsets_in,
+        T_BVH_T & T, const typename S_BVH_T::Real * T_offsets_in,
+        const typename S_BVH_T::Int thread_count_,
+        const GJK_SubAlgorithm sub_algorithm
+    )
+    {
+        using Real = typename S_BVH_T::Real;
+        using Int  = typename S_BVH_T::Int;
+
+        using S_P_T = typename S_BVH_T::Primitive_T;
+        using T_P_T = typename T_BVH_T::Primitive_T;
+
+        using Traversal_T = BVH_PairTraversal<S_BVH_T,T_BVH_T>;
+        using NodePair_T  = typename Traversal_T::NodePair_T;
+
+        constexpr int AMB_DIM    = S_BVH_T::AMB_DIM;
+        constexpr int LANE_COUNT = GJK_DefaultLaneCount<Real>();
+
+        static_assert( std::is_same_v<typename T_BVH_T::Real,Real>, "BVH_IntersectingPairs: Real types of trees do not match." );
+        static_assert( std::is_same_v<typename T_BVH_T::Int, Int >, "BVH_IntersectingPairs: Int types of trees do not match." );
+
+        const Int thread_count = Max( thread_count_, Int(1) );
+
+        std::vector<NodePair_T> result;
+
+        if( (S.NodeCount() <= 0) || (T.NodeCount() <= 0) )
+        {
+            return result;
+        }
+
+        // Offsets in tree order and maximal offsets per node. A child always has a larger node ID than its parent, so we can accumulate the maxima in reverse order.
+        const bool offsetQ = (S_offsets_in != nullptr) && (T_offsets_in != nullptr);
+
+        std::vector<Real> S_offsets;
+        std::vector<Real> T_offsets;
+        std::vector<Real> S_node_offsets;
+        std::vector<Real> T_node_offsets;
+
+        if( offsetQ )
+        {
+            auto prepare_offsets = [](
+                auto & X, const Real * X_offsets_in,
+                std::vector<Real> & X_offsets, std::vector<Real> & X_node_offsets
+            )
+            {
+                X_offsets     .resize( X.PrimitiveCount() );
+                X_node_offsets.resize( X.NodeCount()      );
+
+                for( Int i = 0; i < X.PrimitiveCount(); ++i )
+                {
+                    X_offsets[i] = X_offsets_in[ X.PrimitiveOrdering()[i] ];
+                }
+
+                for( Int node = X.NodeCount(); node --> 0; )
+                {
+                    if( X.LeafQ(node) )
+                    {
+                        Real r = Scalar::Zero<Real>;
+
+                        for( Int i = X.NodeBegin()[node]; i < X.NodeEnd()[node]; ++i )
+                        {
+                            r = Max( r, X_offsets[i] );
+                        }
+
+                        X_node_offsets[node] = r;
+                    }
+                    else
+                    {
+                        X_node_offsets[node] = Max( X_node_offsets[X.NodeLeft()[node]], X_node_offsets[X.NodeRight()[node]] );
+                    }
+                }
+            };
+
+            prepare_offsets( S, S_offsets_in, S_offsets, S_node_offsets );
+            prepare_offsets( T, T_offsets_in, T_offsets, T_node_offsets );
+        }
+
+        const Real * S_off      = offsetQ ? S_offsets.data()      : nullptr;
+        const Real * T_off      = offsetQ ? T_offsets.data()      : nullptr;
+        const Real * S_node_off = offsetQ ? S_node_offsets.data() : nullptr;
+        const Real * T_node_off = offsetQ ? T_node_offsets.data() : nullptr;
+
+        // Expand the top levels of the traversal breadth-first to get enough seeds for the threads.
+        std::vector<NodePair_T> seeds { NodePair_T(0,0) };
+
+        {
+            Traversal_T traversal ( S, S_off, S_node_off, T, T_off, T_node_off );
+
+            const std::size_t target_count = static_cast<std::size_t>( 8 * thread_count );
+
+            std::vector<NodePair_T> next;
+
+            bool refinedQ = true;
+
+            while( refinedQ && (seeds.size() < target_count) )
+            {
+                refinedQ = false;
+
+                next.clear();
+
+                const Int seed_count = static_cast<Int>(seeds.size());
+
+                for( Int s_begin = 0; s_begin < seed_count; s_begin += Traversal_T::BLOCK_SIZE )
+                {
+                    const Int count = Min( Traversal_T::BLOCK_SIZE, seed_count - s_begin );
+
+                    const std::uint64_t bits = traversal.NodesIntersectingMask( &seeds[s_begin], count );
+
+                    for( Int b = 0; b < count; ++b )
+                    {
+                        if( (bits >> b) & std::uint64_t(1) )
+                        {
+                            const auto [a,c] = seeds[s_begin + b];
+
+                            if( traversal.Refine( a, c, next ) )
+                            {
+                                refinedQ = true;
+                            }
+                            else
+                            {
+                                next.emplace_back( a, c );
+                            }
+                        }
+                    }
+                }
+
+                std::swap( seeds, next );
+            }
+        }
+
+        GJK_JobScheduler<Int> scheduler ( Int(0), static_cast<Int>(seeds.size()), thread_count, Int(1) );
+
+        std::vector<std::vector<NodePair_T>> thread_result ( thread_count );
+
+        ParallelDo(
+            [&]( const Int thread )
+            {
+                Traversal_T traversal ( S, S_off, S_node_off, T, T_off, T_node_off );
+
+                auto jobs = scheduler.GetWorker( thread );
+
+                traversal.SetSeeds( seeds.data(), jobs );
+
+                GJK_Algorithm_Vectorized<LANE_COUNT,AMB_DIM,Real,Int> gjk ( sub_algorithm );
+                SupportLanes<S_P_T,LANE_COUNT> P ( S.Primitive() );
+                SupportLanes<T_P_T,LANE_COUNT> Q ( T.Primitive() );
+
+                NodePair_T lane_pair [LANE_COUNT];
+
+                std::vector<NodePair_T> & hits = thread_result[thread];
+
+                gjk.Process( traversal, P, Q,
+                    [&]( const Int l, const Int k )
+                    {
+                        (void)k;
+
+                        const auto [i,j] = traversal.CurrentPair();
+
+                        lane_pair[l] = NodePair_T( i, j );
+
+                        P[l].SetPointer( S.PrimitiveData(), i );
+                        Q[l].SetPointer( T.PrimitiveData(), j );
+
+                        const Real r = traversal.Offset( i, j );
+
+                        gjk.Load( l, P, Q, true, r * r );
+                    },
+                    [&]( const Int l, const Int k )
+                    {
+                        (void)k;
+
+                        if( !gjk.SeparatedQ(l) )
+                        {
+                            hits.push_back( lane_pair[l] );
+                        }
+                    }
+                );
+            },
+            thread_count
+        );
+
+        std::size_t hit_count = 0;
+
+        for( const auto & hits : thread_result )
+        {
+            hit_count += hits.size();
+        }
+
+        result.reserve( hit_count );
+
+        for( const auto & hits : thread_result )
+        {
+            for( const auto & [i,j] : hits )
+            {
+                result.emplace_back( S.PrimitiveOrdering()[i], T.PrimitiveOrdering()[j] );
+            }
+        }
+
+        std::sort( result.begin(), result.end() );
+
+        return result;
+    }
+
+    template<typename S_BVH_T, typename T_BVH_T>
+    std::vector<std::pair<typename S_BVH_T::Int,typename S_BVH_T::Int>> BVH_IntersectingPairs(
+        S_BVH_T & S,
+        T_BVH_T & T,
+        const typename S_BVH_T::Int thread_count = 1,
+        const GJK_SubAlgorithm sub_algorithm = GJK_SubAlgorithm::Johnson
+    )
+    {
+        tic("BVH_IntersectingPairs");
+
+        auto result = BVH_IntersectingPairs_Implementation( S, nullptr, T, nullptr, thread_count, sub_algorithm );
+
+        toc("BVH_IntersectingPairs");
+
+        return result;
+    }
+
+    // S_offsets and T_offsets are vectors of sizes S.PrimitiveCount() and T.PrimitiveCount() in the original numbering of the primitives.
+    template<typename S_BVH_T, typename T_BVH_T>
+    std::vector<std::pair<typename S_BVH_T::Int,typename S_BVH_T::Int>> BVH_Offset_IntersectingPairs(
+        S_BVH_T & S, const typename S_BVH_T::Real * S_offsets,
+        T_BVH_T & T, const typename S_BVH_T::Real * T_offsets,
+        const typename S_BVH_T::Int thread_count = 1,
+        const GJK_SubAlgorithm sub_algorithm = GJK_SubAlgorithm::Johnson
+    )
+    {
+        tic("BVH_Offset_IntersectingPairs");
+
+        auto result = BVH_IntersectingPairs_Implementation( S, S_offsets, T, T_offsets, thread_count, sub_algorithm );
+
+        toc("BVH_Offset_IntersectingPairs");
+
+        return result;
+    }
+
+} // namespace GJK
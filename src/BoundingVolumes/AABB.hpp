@@ -19,9 +19,10 @@ namespace GJK
         
         Real id_matrix[AMB_DIM][AMB_DIM];
     
-        const int bits = static_cast<int>(64-1) / static_cast<int>(AMB_DIM);
-        const SReal power  = static_cast<SReal>(0.9999) * std::pow( Scalar::Two<SReal>, bits );
-        const SReal offset = Scalar::Half<SReal> * power;
+        // Quantization constants for 64-bit space-filling-curve codes (see QuantizeCoordinates).
+        static constexpr int   bits   = static_cast<int>(64-1) / static_cast<int>(AMB_DIM);
+        static constexpr SReal power  = static_cast<SReal>(0.9999) * static_cast<SReal>( std::uint64_t(1) << bits );
+        static constexpr SReal offset = Scalar::Half<SReal> * power;
         
     protected:
         
@@ -132,7 +133,8 @@ namespace GJK
             mptr<SReal> P_serialized,                // serialized data of primitives
             const Int begin,                           // which _P_rimitives are in question
             const Int end,                             // which _P_rimitives are in question
-            Int thread_count = 1                       // how many threads to utilize
+            Int thread_count = 1,                      // how many threads to utilize
+            const Int chunk_size = 0                   // primitives per chunk of the dynamic schedule; chunk_size <= 0 splits them evenly among the threads (see GJK_JobScheduler)
         ) const
         {
 //            ptic(ClassName()+"::FromPrimitives (PolytopeBase)");
@@ -158,6 +160,7 @@ namespace GJK
             {
                 std::vector<std::array<SReal,AMB_DIM>> thread_lower ( thread_count );
                 std::vector<std::array<SReal,AMB_DIM>> thread_upper ( thread_count );
+                GJK_JobScheduler<Int> scheduler ( begin, end, thread_count, chunk_size );
                 
                 ParallelDo(
                     [&]( const Int thread )
@@ -173,14 +176,16 @@ namespace GJK
                             U[k] = Scalar::Min<SReal>;
                         }
                         
-                        const Int i_begin = begin + JobPointer( end - begin, thread_count, thread    );
-                        const Int i_end   = begin + JobPointer( end - begin, thread_count, thread +1 );
-                        
-                        for( Int i = i_begin; i < i_end; ++i )
-                        {
-                            Q->SetPointer( P_serialized, i );
-                            Q->BoxMinMax( &L[0], &U[0] );
-                        }
+                        scheduler.ForEachChunk( thread,
+                            [&]( const Int i_begin, const Int i_end )
+                            {
+                                for( Int i = i_begin; i < i_end; ++i )
+                                {
+                                    Q->SetPointer( P_serialized, i );
+                                    Q->BoxMinMax( &L[0], &U[0] );
+                                }
+                            }
+                        );
                         
                         thread_lower[thread] = L;
                         thread_upper[thread] = U;
@@ -221,13 +226,84 @@ namespace GJK
 //            ptoc(ClassName()+"::FromPrimitives (PolytopeBase)");
         }
         
+        // Same as above for polytopes in structure-of-arrays layout. Reads only the point rows of the SoA matrix; the inner loops run over the primitives and are vectorized.
+        template<int POINT_COUNT, typename ExtReal, typename ExtInt>
+        void FromPrimitives(
+            cref<PolytopeSoA<POINT_COUNT,AMB_DIM,Real,Int,SReal,ExtReal,ExtInt>> P,  // view onto the SoA matrix of the primitives
+            const Int begin,                           // which _P_rimitives are in question
+            const Int end,                             // which _P_rimitives are in question
+            Int thread_count = 1,                      // how many threads to utilize
+            const Int chunk_size = 0                   // primitives per chunk of the dynamic schedule; chunk_size <= 0 splits them evenly among the threads (see GJK_JobScheduler)
+        ) const
+        {
+            std::array<SReal,AMB_DIM> lower;
+            std::array<SReal,AMB_DIM> upper;
+            
+            for( Int k = 0; k < AMB_DIM; ++k )
+            {
+                lower[k] = Scalar::Max<SReal>;
+                upper[k] = Scalar::Min<SReal>;
+            }
+            
+            if( thread_count <= 1 )
+            {
+                P.BoxMinMax( begin, end, &lower[0], &upper[0] );
+            }
+            else
+            {
+                std::vector<std::array<SReal,AMB_DIM>> thread_lower ( thread_count, lower );
+                std::vector<std::array<SReal,AMB_DIM>> thread_upper ( thread_count, upper );
+                GJK_JobScheduler<Int> scheduler ( begin, end, thread_count, chunk_size );
+                
+                ParallelDo(
+                    [&]( const Int thread )
+                    {
+                        scheduler.ForEachChunk( thread,
+                            [&]( const Int i_begin, const Int i_end )
+                            {
+                                P.BoxMinMax( i_begin, i_end, &thread_lower[thread][0], &thread_upper[thread][0] );
+                            }
+                        );
+                    },
+                    thread_count
+                );
+                
+                for( Int thread = 0; thread < thread_count; ++thread )
+                {
+                    for( Int k = 0; k < AMB_DIM; ++k )
+                    {
+                        lower[k] = std::min( lower[k], thread_lower[thread][k] );
+                        upper[k] = std::max( upper[k], thread_upper[thread][k] );
+                    }
+                }
+            }
+            
+            SReal r2 = Scalar::Zero<SReal>;
+
+            for( Int k = 0; k < AMB_DIM; ++k )
+            {
+                const SReal diff = Scalar::Half<SReal> * (upper[k] - lower[k]);
+                r2 += diff * diff;
+
+                // adding half the edge length to obtain the k-th coordinate of the center
+                lower[k] += diff;
+                // storing half the edge length in the designated storage.
+                upper[k]  = diff;
+            }
+            
+            serialized_data[0] = r2;
+            copy_buffer<AMB_DIM>( &lower[0], &serialized_data[1          ] );
+            copy_buffer<AMB_DIM>( &upper[0], &serialized_data[1 + AMB_DIM] );
+        }
+        
         // array p is supposed to represent a matrix of size N x AMB_DIM
         virtual void FromPrimitives(
             mref<PrimitiveSerialized<AMB_DIM,Real,Int,SReal>> P,      // primitive prototype
             mptr<SReal> P_serialized,                  // serialized data of primitives
             const Int begin,                           // which _P_rimitives are in question
             const Int end,                             // which _P_rimitives are in question
-            Int thread_count = 1                       // how many threads to utilize
+            Int thread_count = 1,                      // how many threads to utilize
+            const Int chunk_size = 0                   // primitives per chunk of the dynamic schedule; chunk_size <= 0 splits them evenly among the threads (see GJK_JobScheduler)
         ) const override
         {
 //            ptic(ClassName()+"::FromPrimitives (PrimitiveSerialized)");
@@ -264,15 +340,11 @@ namespace GJK
             {
                 std::vector<std::array<SReal,AMB_DIM>> thread_lower ( thread_count );
                 std::vector<std::array<SReal,AMB_DIM>> thread_upper ( thread_count );
+                GJK_JobScheduler<Int> scheduler ( begin, end, thread_count, chunk_size );
 
                 ParallelDo(
                     [&]( const Int thread )
                     {
-                        const Int i_begin = begin + JobPointer( end - begin, thread_count, thread    );
-                        const Int i_end   = begin + JobPointer( end - begin, thread_count, thread +1 );
-
-//                        print( ToString(thread) + " -> { " + ToString(i_begin) + ", " + ToString(i_end) + " }" );
-
                         std::shared_ptr<PrimitiveSerialized<AMB_DIM,Real,Int,SReal>> Q = P.Clone();
 
                         std::array<SReal,AMB_DIM> L;
@@ -284,21 +356,26 @@ namespace GJK
                             U[k] = Scalar::Min<SReal>;
                         }
 
-                        for( Int i = i_begin; i < i_end; ++i )
-                        {
-                            Q->SetPointer( P_serialized, i );
-
-                            for( Int j = 0; j < AMB_DIM; ++j )
+                        scheduler.ForEachChunk( thread,
+                            [&]( const Int i_begin, const Int i_end )
                             {
-                                Real min_val;
-                                Real max_val;
+                                for( Int i = i_begin; i < i_end; ++i )
+                                {
+                                    Q->SetPointer( P_serialized, i );
 
-                                Q->MinMaxSupportValue( &id_matrix[j][0], min_val, max_val );
+                                    for( Int j = 0; j < AMB_DIM; ++j )
+                                    {
+                                        Real min_val;
+                                        Real max_val;
 
-                                L[j] = Min( L[j], static_cast<SReal>(min_val) );
-                                U[j] = Max( U[j], static_cast<SReal>(max_val) );
+                                        Q->MinMaxSupportValue( &id_matrix[j][0], min_val, max_val );
+
+                                        L[j] = Min( L[j], static_cast<SReal>(min_val) );
+                                        U[j] = Max( U[j], static_cast<SReal>(max_val) );
+                                    }
+                                }
                             }
-                        }
+                        );
 
                         thread_lower[thread] = L;
                         thread_upper[thread] = U;
@@ -426,6 +503,104 @@ namespace GJK
             return d2;
         }
         
+        static constexpr int QuantizationBits()
+        {
+            return bits;
+        }
+        
+        // Maps the point x of the cube with center c and half edge length L to integer coordinates q[k] in [0, 2^QuantizationBits()[. The coordinates of AMB_DIM points fit into a single 64-bit code; see MortonCode and HilbertCode.
+        static void QuantizeCoordinates( cptr<Real> x, cptr<SReal> c, const SReal L, mptr<std::uint64_t> q )
+        {
+            const SReal scale = (L > Scalar::Zero<SReal>) ? Scalar::Half<SReal> * power / L : Scalar::Zero<SReal>;
+            
+            for( Int k = 0; k < AMB_DIM; ++k )
+            {
+                const SReal t = offset + scale * ( static_cast<SReal>(x[k]) - c[k] );
+                
+                q[k] = static_cast<std::uint64_t>( Min( Max( t, Scalar::Zero<SReal> ), power ) );
+            }
+        }
+
+        // Converts the box serialized at C_data to 2 * AMB_DIM numbers of type F (lower corner, then upper corner). The conversion rounds outward, so the box of type F always contains the box of type SReal; e.g., F = float halves the memory of double boxes without missing any intersections.
+        template<typename F>
+        static void WritePackedBox( cptr<SReal> C_data, mptr<F> box )
+        {
+            cptr<SReal> x = C_data + 1;
+            cptr<SReal> L = C_data + 1 + AMB_DIM;
+
+            for( Int k = 0; k < AMB_DIM; ++k )
+            {
+                const SReal lower = x[k] - L[k];
+                const SReal upper = x[k] + L[k];
+
+                F f_lower = static_cast<F>(lower);
+                F f_upper = static_cast<F>(upper);
+
+                if( static_cast<SReal>(f_lower) > lower )
+                {
+                    f_lower = std::nextafter( f_lower, -std::numeric_limits<F>::infinity() );
+                }
+
+                if( static_cast<SReal>(f_upper) < upper )
+                {
+                    f_upper = std::nextafter( f_upper,  std::numeric_limits<F>::infinity() );
+                }
+
+                box[k          ] = f_lower;
+                box[k + AMB_DIM] = f_upper;
+            }
+        }
+
+        // Inverse of WritePackedBox: Writes the serialized AABB of the packed box to C_data. The half edge lengths are rounded up where needed, so the result always contains the packed box.
+        template<typename F>
+        static void ReadPackedBox( cptr<F> box, mptr<SReal> C_data )
+        {
+            mptr<SReal> x = C_data + 1;
+            mptr<SReal> L = C_data + 1 + AMB_DIM;
+
+            SReal r2 = Scalar::Zero<SReal>;
+
+            for( Int k = 0; k < AMB_DIM; ++k )
+            {
+                const SReal lower = static_cast<SReal>(box[k          ]);
+                const SReal upper = static_cast<SReal>(box[k + AMB_DIM]);
+
+                x[k] = Scalar::Half<SReal> * ( upper + lower );
+                L[k] = Scalar::Half<SReal> * ( upper - lower );
+
+                while( (x[k] - L[k] > lower) || (x[k] + L[k] < upper) )
+                {
+                    L[k] = std::nextafter( L[k], std::numeric_limits<SReal>::infinity() );
+                }
+
+                r2 += L[k] * L[k];
+            }
+
+            C_data[0] = r2;
+        }
+
+        // Squared distance of two boxes written by WritePackedBox.
+        template<typename F>
+        static Real PackedBoxSquaredDistance( cptr<F> P_box, cptr<F> Q_box )
+        {
+            Real d2 = Scalar::Zero<Real>;
+
+            for( Int k = 0; k < AMB_DIM; ++k )
+            {
+                const Real x = Max(
+                    Scalar::Zero<Real>,
+                    Max(
+                        static_cast<Real>(P_box[k]) - static_cast<Real>(Q_box[k + AMB_DIM]),
+                        static_cast<Real>(Q_box[k]) - static_cast<Real>(P_box[k + AMB_DIM])
+                    )
+                );
+
+                d2 += x * x;
+            }
+
+            return d2;
+        }
+
         void Merge( mptr<SReal> C_Serialized, const Int i = 0 ) const
         {
             mptr<SReal> p = C_Serialized + SIZE * i;
@@ -108,45 +108,71 @@ namespace GJK
 
             cptr<SReal> p = P_serialized + 1 + split_dir;
 
-            // TODO: Parallelize
-            for( Int i = begin; i < end; ++i )
+            auto compute_score = [=]( const Int i )
             {
-                score[i] = p[ P_Size * i ];
-                perm [i] = i;
-            }
+                return p[ P_Size * i ];
+            };
 
             Int split_index = begin + ((end-begin)/2);
 
-            Int  * mid = perm + split_index;
-            // TODO: Parallelize
-            std::nth_element(
-                    perm + begin, mid,
-                    perm + end,
-                    [score](const Int i, const Int j) {return score[i] < score[j];}
-            );
-            // Now perm contains the desired ordering of score.
-
-            // Invert permutation.
-            // TODO: Parallelize
-            for( Int i = begin; i < end; ++i )
+            if( (thread_count > 1) && (end - begin >= ParallelSplitThreshold<Int>) )
             {
-                inv_perm[perm[i]] = i;
-            }
+                // Large nodes (the top levels of a tree): parallel selection and out-of-place reordering; see ParallelSelect.hpp.
+                ParallelDo(
+                    [&]( const Int thread )
+                    {
+                        const Int i_begin = begin + JobPointer( end - begin, thread_count, thread    );
+                        const Int i_end   = begin + JobPointer( end - begin, thread_count, thread +1 );
+
+                        for( Int i = i_begin; i < i_end; ++i )
+                        {
+                            score[i] = compute_score(i);
+                        }
+                    },
+                    thread_count
+                );
+
+                ParallelSplitPermutation( score, begin, split_index, end, perm, thread_count );
 
-            // https://www.geeksforgeeks.org/permute-the-elements-of-an-array-following-given-order/
-            // Reorder primitive according to perm, i.e., write primitive perm[i] to position i.
-            // TODO: Parallelize
-            for( Int i = begin; i < end; ++i )
+                ParallelGatherPrimitives( P_Size, P_serialized, P_ordering, perm, begin, end, inv_perm, thread_count );
+            }
+            else
             {
-                Int next = i;
+                for( Int i = begin; i < end; ++i )
+                {
+                    score[i] = compute_score(i);
+                    perm [i] = i;
+                }
 
-                while( inv_perm[next] >= 0 )
+                Int * mid = perm + split_index;
+
+                std::nth_element(
+                        perm + begin, mid,
+                        perm + end,
+                        [score](const Int i, const Int j) {return score[i] < score[j];}
+                );
+                // Now perm contains the desired ordering of score.
+
+                // Invert permutation.
+                for( Int i = begin; i < end; ++i )
+                {
+                    inv_perm[perm[i]] = i;
+                }
+
+                // https://www.geeksforgeeks.org/permute-the-elements-of-an-array-following-given-order/
+                // Reorder primitive according to perm, i.e., write primitive perm[i] to position i.
+                for( Int i = begin; i < end; ++i )
                 {
-                    Int temp = inv_perm[next];
-                    std::swap( P_ordering   [i]  , P_ordering   [temp] );
-                    P.Swap   ( P_serialized, i,    P_serialized, temp  );
-                    inv_perm[next] = -1;
-                    next = temp;
+                    Int next = i;
+
+                    while( inv_perm[next] >= 0 )
+                    {
+                        Int temp = inv_perm[next];
+                        std::swap( P_ordering   [i]  , P_ordering   [temp] );
+                        P.Swap   ( P_serialized, i,    P_serialized, temp  );
+                        inv_perm[next] = -1;
+                        next = temp;
+                    }
                 }
             }
 
@@ -0,0 +1,453 @@
+#pragma once
+
+#define BASE  AABB<AMB_DIM,Real,Int,SReal>
+#define CLASS AABB_SAHSplit
+
+namespace GJK
+{
+
+
+    // serialized_data is assumed to be an array of size SIZE. Will never be allocated by class! Instead, it is meant to be mapped onto an array of type SReal by calling the member SetPointer.
+
+    // DATA LAYOUT
+    // serialized_data[0] = squared radius
+    // serialized_data[1],...,serialized_data[AMB_DIM] = center
+    // serialized_data[AMB_DIM + 1],...,serialized_data[AMB_DIM + AMB_DIM] = half the edge lengths.
+
+    // Split by the surface area heuristic (SAH): the primitives' InteriorPoints are sorted into bin_count bins along each axis of the bounding box of the InteriorPoints; among all bin_count - 1 planes between the bins of all axes, the one minimizing
+    //
+    //     area(L) * #L + area(R) * #R
+    //
+    // is chosen, where L and R are the bounding boxes of the primitives on either side. The bins store the bounding boxes of their primitives, so the children's bounding volumes come for free.
+
+    template<int AMB_DIM, typename Real, typename Int, typename SReal>
+    class CLASS : public BASE
+    {
+    public:
+
+        static constexpr Int bin_count = 32;
+
+        CLASS() : BASE() {}
+
+        // Copy constructor
+        CLASS( const CLASS & other ) : BASE( other ) {}
+
+        // Move constructor
+        CLASS( CLASS && other ) noexcept : BASE( other ) {}
+
+        virtual ~CLASS() override = default;
+
+    protected:
+
+        using BASE::serialized_data;
+        using BASE::id_matrix;
+
+        struct Bin
+        {
+            Int count = 0;
+            std::array<SReal,AMB_DIM> lower;
+            std::array<SReal,AMB_DIM> upper;
+
+            void Clear()
+            {
+                count = 0;
+                lower.fill( Scalar::Max<SReal> );
+                upper.fill( Scalar::Min<SReal> );
+            }
+
+            void Merge( const Bin & other )
+            {
+                count += other.count;
+
+                for( Int k = 0; k < AMB_DIM; ++k )
+                {
+                    lower[k] = Min( lower[k], other.lower[k] );
+                    upper[k] = Max( upper[k], other.upper[k] );
+                }
+            }
+        };
+
+        // bins[bin_count * k + b] is the b-th bin along the k-th axis.
+        using Bins_T = std::array<Bin,AMB_DIM * bin_count>;
+
+    public:
+
+        using BASE::Size;
+        using BASE::SetPointer;
+        using BASE::FromPrimitives;
+
+    public:
+
+        __ADD_CLONE_CODE__(CLASS)
+
+    public:
+
+        virtual Int Split(
+            PrimitiveSerialized<AMB_DIM,Real,Int,SReal> & P,             // primitive prototype; to be "mapped" over P_serialized, thus not const.
+            mptr<SReal> P_serialized, const Int begin, const Int end,    // which _P_rimitives are in question
+            mptr<Int>   P_ordering,                                      // to keep track of the permutation of the primitives
+            mptr<SReal> C_data,       const Int C_ID,                    // where to get   the bounding volume info for _C_urrent bounding volume
+            mptr<SReal> L_serialized, const Int L_ID,                    // where to store the bounding volume info for _L_eft  child (if successful!)
+            mptr<SReal> R_serialized, const Int R_ID,                    // where to store the bounding volume info for _R_ight child (if successful!)
+            mptr<SReal> score,                                           // some scratch buffer for one scalar per primitive
+            mptr<Int>   perm,                                            // some scratch buffer for one Int per primitive (for storing local permutation)
+            mptr<Int>   inv_perm,                                        // some scratch buffer for one Int per primitive (for storing inverse of local permutation)
+            Int thread_count = 1                                         // how many threads to utilize
+        ) override
+        {
+//            ptic(ClassName()+"::Split");
+
+            (void)C_data;
+            (void)C_ID;
+
+            const Int P_Size = P.Size();
+            const Int n      = end - begin;
+
+            if( n < 2 )
+            {
+                return -1;
+            }
+
+            const bool parallelQ = (thread_count > 1) && (n >= ParallelSplitThreshold<Int>);
+
+            const Int threads = parallelQ ? thread_count : Int(1);
+
+            // WARNING: For performance reasons, we do NOT use P.InteriorPoint for reading out the coordinates!
+            cptr<SReal> p = P_serialized + 1;
+
+            // Bounding box of the InteriorPoints; it determines the bins.
+            std::array<SReal,AMB_DIM> c_lower;
+            std::array<SReal,AMB_DIM> c_upper;
+
+            {
+                std::vector<std::array<SReal,AMB_DIM>> thread_lower ( threads );
+                std::vector<std::array<SReal,AMB_DIM>> thread_upper ( threads );
+
+                ParallelDo(
+                    [&]( const Int thread )
+                    {
+                        const Int i_begin = begin + JobPointer( n, threads, thread    );
+                        const Int i_end   = begin + JobPointer( n, threads, thread +1 );
+
+                        mref<std::array<SReal,AMB_DIM>> lo = thread_lower[thread];
+                        mref<std::array<SReal,AMB_DIM>> hi = thread_upper[thread];
+
+                        lo.fill( Scalar::Max<SReal> );
+                        hi.fill( Scalar::Min<SReal> );
+
+                        for( Int i = i_begin; i < i_end; ++i )
+                        {
+                            for( Int k = 0; k < AMB_DIM; ++k )
+                            {
+                                const SReal x = p[ P_Size * i + k ];
+
+                                lo[k] = Min( lo[k], x );
+                                hi[k] = Max( hi[k], x );
+                            }
+                        }
+                    },
+                    threads
+                );
+
+                c_lower = thread_lower[0];
+                c_upper = thread_upper[0];
+
+                for( Int thread = 1; thread < threads; ++thread )
+                {
+                    for( Int k = 0; k < AMB_DIM; ++k )
+                    {
+                        c_lower[k] = Min( c_lower[k], thread_lower[thread][k] );
+                        c_upper[k] = Max( c_upper[k], thread_upper[thread][k] );
+                    }
+                }
+            }
+
+            // Maps coordinates to bins; axes of zero extent are not binned.
+            std::array<SReal,AMB_DIM> bin_scale;
+
+            bool degenerateQ = true;
+
+            for( Int k = 0; k < AMB_DIM; ++k )
+            {
+                const SReal extent = c_upper[k] - c_lower[k];
+
+                if( extent > Scalar::Zero<SReal> )
+                {
+                    bin_scale[k] = static_cast<SReal>(bin_count) / extent;
+                    degenerateQ = false;
+                }
+                else
+                {
+                    bin_scale[k] = Scalar::Zero<SReal>;
+                }
+            }
+
+            auto bin_index = [&]( const Int i, const Int k ) -> Int
+            {
+                return Min(
+                    bin_count - 1,
+                    static_cast<Int>( bin_scale[k] * ( p[ P_Size * i + k ] - c_lower[k] ) )
+                );
+            };
+
+            // Binning. Every primitive's bounding box is computed once and merged into its bin along each axis.
+            Bins_T bins;
+
+            {
+                std::vector<Bins_T> thread_bins ( threads );
+
+                ParallelDo(
+                    [&]( const Int thread )
+                    {
+                        std::shared_ptr<PrimitiveSerialized<AMB_DIM,Real,Int,SReal>> Q = P.Clone();
+
+                        const Int i_begin = begin + JobPointer( n, threads, thread    );
+                        const Int i_end   = begin + JobPointer( n, threads, thread +1 );
+
+                        mref<Bins_T> B = thread_bins[thread];
+
+                        for( Bin & bin : B )
+                        {
+                            bin.Clear();
+                        }
+
+                        for( Int i = i_begin; i < i_end; ++i )
+                        {
+                            Q->SetPointer( P_serialized, i );
+
+                            std::array<SReal,AMB_DIM> lower;
+                            std::array<SReal,AMB_DIM> upper;
+
+                            for( Int j = 0; j < AMB_DIM; ++j )
+                            {
+                                Real min_val;
+                                Real max_val;
+
+                                Q->MinMaxSupportValue( &id_matrix[j][0], min_val, max_val );
+
+                                lower[j] = static_cast<SReal>(min_val);
+                                upper[j] = static_cast<SReal>(max_val);
+                            }
+
+                            for( Int k = 0; k < AMB_DIM; ++k )
+                            {
+                                mref<Bin> bin = B[ bin_count * k + bin_index(i,k) ];
+
+                                ++bin.count;
+
+                                for( Int j = 0; j < AMB_DIM; ++j )
+                                {
+                                    bin.lower[j] = Min( bin.lower[j], lower[j] );
+                                    bin.upper[j] = Max( bin.upper[j], upper[j] );
+                                }
+                            }
+                        }
+                    },
+                    threads
+                );
+
+                bins = thread_bins[0];
+
+                for( Int thread = 1; thread < threads; ++thread )
+                {
+                    for( Int b = 0; b < AMB_DIM * bin_count; ++b )
+                    {
+                        bins[b].Merge( thread_bins[thread][b] );
+                    }
+                }
+            }
+
+            // Sweep over the planes between the bins. Plane b separates the bins 0,...,b-1 from the bins b,...,bin_count-1.
+            Int   split_dir  = -1;
+            Int   split_bin  = 0;
+            SReal best_cost  = Scalar::Max<SReal>;
+            Bin   best_left;
+            Bin   best_right;
+
+            best_left.Clear();
+            best_right.Clear();
+
+            if( !degenerateQ )
+            {
+                for( Int k = 0; k < AMB_DIM; ++k )
+                {
+                    if( bin_scale[k] <= Scalar::Zero<SReal> )
+                    {
+                        continue;
+                    }
+
+                    cptr<Bin> B = &bins[ bin_count * k ];
+
+                    // right_sweep[b] is the union of the bins b,...,bin_count-1.
+                    std::array<Bin,bin_count> right_sweep;
+
+                    right_sweep[bin_count-1] = B[bin_count-1];
+
+                    for( Int b = bin_count - 1; b --> 0; )
+                    {
+                        right_sweep[b] = right_sweep[b+1];
+                        right_sweep[b].Merge( B[b] );
+                    }
+
+                    Bin left;
+                    left.Clear();
+
+                    for( Int b = 1; b < bin_count; ++b )
+                    {
+                        left.Merge( B[b-1] );
+
+                        const Bin & right = right_sweep[b];
+
+                        if( (left.count == 0) || (right.count == 0) )
+                        {
+                            continue;
+                        }
+
+                        const SReal cost =
+                            SurfaceArea( left  ) * static_cast<SReal>(left.count)
+                            +
+                            SurfaceArea( right ) * static_cast<SReal>(right.count);
+
+                        if( cost < best_cost )
+                        {
+                            best_cost  = cost;
+                            split_dir  = k;
+                            split_bin  = b;
+                            best_left  = left;
+                            best_right = right;
+                        }
+                    }
+                }
+            }
+
+            if( split_dir < 0 )
+            {
+                // All InteriorPoints coincide; any split is as good as any other. We split in the middle without reordering.
+
+                const Int split_index = begin + n/2;
+
+                SetPointer( L_serialized, L_ID );
+                FromPrimitives( P, P_serialized, begin,       split_index,   threads );
+                SetPointer( R_serialized, R_ID );
+                FromPrimitives( P, P_serialized, split_index, end,           threads );
+
+//                ptoc(ClassName()+"::Split");
+
+                return split_index;
+            }
+
+            const Int split_index = begin + best_left.count;
+
+            // Move the primitives in the bins 0,...,split_bin-1 along split_dir to the front.
+            if( parallelQ )
+            {
+                // Large nodes (the top levels of a tree): the bin indices are used as scores; since split_index - begin is precisely the number of primitives with bin index < split_bin, ParallelSplitPermutation puts exactly these to the left. See ParallelSelect.hpp.
+                ParallelDo(
+                    [&]( const Int thread )
+                    {
+                        const Int i_begin = begin + JobPointer( n, threads, thread    );
+                        const Int i_end   = begin + JobPointer( n, threads, thread +1 );
+
+                        for( Int i = i_begin; i < i_end; ++i )
+                        {
+                            score[i] = static_cast<SReal>( bin_index(i,split_dir) );
+                        }
+                    },
+                    threads
+                );
+
+                ParallelSplitPermutation( score, begin, split_index, end, perm, threads );
+
+                ParallelGatherPrimitives( P_Size, P_serialized, P_ordering, perm, begin, end, inv_perm, threads );
+            }
+            else
+            {
+                Int i = begin;
+
+                for( Int j = begin; j < end; ++j )
+                {
+                    if( bin_index(j,split_dir) < split_bin )
+                    {
+                        std::swap( P_ordering[i], P_ordering[j] );
+
+                        P.Swap( P_serialized, i, P_serialized, j );
+
+                        ++i;
+                    }
+                }
+            }
+
+            // The bounding volumes of the children are the unions of the bins' boxes.
+            SetPointer( L_serialized, L_ID );
+            FromBin( best_left );
+            SetPointer( R_serialized, R_ID );
+            FromBin( best_right );
+
+//            ptoc(ClassName()+"::Split");
+
+            return split_index;
+
+        } // Split
+
+    protected:
+
+        // Half the surface area of the bin's bounding box (the length of the box if AMB_DIM == 1); only ratios matter.
+        static SReal SurfaceArea( const Bin & bin )
+        {
+            if constexpr ( AMB_DIM == 1 )
+            {
+                return bin.upper[0] - bin.lower[0];
+            }
+            else
+            {
+                SReal area = 0;
+
+                for( Int k = 0; k < AMB_DIM; ++k )
+                {
+                    SReal face = 1;
+
+                    for( Int j = 0; j < AMB_DIM; ++j )
+                    {
+                        if( j != k )
+                        {
+                            face *= bin.upper[j] - bin.lower[j];
+                        }
+                    }
+
+                    area += face;
+                }
+
+                return area;
+            }
+        }
+
+        void FromBin( const Bin & bin ) const
+        {
+            SReal r2 = Scalar::Zero<SReal>;
+
+            for( Int k = 0; k < AMB_DIM; ++k )
+            {
+                const SReal diff = Scalar::Half<SReal> * (bin.upper[k] - bin.lower[k]);
+
+                r2 += diff * diff;
+
+                serialized_data[1 + k          ] = bin.lower[k] + diff;
+                serialized_data[1 + AMB_DIM + k] = diff;
+            }
+
+            serialized_data[0] = r2;
+        }
+
+    public:
+
+        virtual std::string ClassName() const override
+        {
+            return TO_STD_STRING(CLASS)+"<"+ToString(AMB_DIM)+","+TypeName<Real>+","+TypeName<Int>+","+TypeName<SReal>+">";
+        }
+
+    }; // CLASS
+
+} // namespace GJK
+
+#undef CLASS
+#undef BASE
@@ -49,7 +49,8 @@ namespace GJK
             mptr<SReal> P_data,
             const Int begin,
             const Int end,           // which _P_primitives are in question
-            Int thread_count = 1     // how many threads to utilize
+            Int thread_count = 1,    // how many threads to utilize
+            const Int chunk_size = 0 // chunk size of the dynamic schedule; see GJK_JobScheduler
         ) const = 0;
         
         virtual Int Split(
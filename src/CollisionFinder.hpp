@@ -4,6 +4,16 @@
 
 namespace GJK
 {
+    // How CollisionFinder searches for the maximal safe step size.
+    //
+    // Bisection: Tests the space-time polytopes swept over [a,b] for intersection and halves the interval until its relative length is below the tolerance. Needs about log2(1/eps) calls to GJK.
+    //
+    // ConservativeAdvancement: Computes the closest points of the polytopes at the current time t by GJK. Their difference n is a separating direction. The vertices move linearly, so the gap between the supporting planes orthogonal to n is the minimum of linear functions of time, one per pair of vertices. Its first root is a time up to which the polytopes cannot intersect, and the search jumps almost there (by the factor 1 - eps). This repeats until the jumps are shorter than the tolerance. Typically it needs only a few calls to GJK.
+    enum class CollisionFinderMethod
+    {
+        Bisection,
+        ConservativeAdvancement
+    };
     
     template <int AMB_DIM, typename Real, typename Int, typename SReal>
     class CLASS
@@ -22,17 +32,20 @@ namespace GJK
         CLASS(
             cref<MovingPrimitive_T> P_,
             cref<MovingPrimitive_T> Q_,
-            const SReal TOL
+            const SReal TOL,
+            const CollisionFinderMethod method_ = CollisionFinderMethod::Bisection
         )
         :   P{ P_.Clone() }
         ,   Q{ Q_.Clone() }
         ,   eps(TOL)
+        ,   method(method_)
         {}
         
         CLASS( const CLASS & other )
         :   P { other.P->Clone() }
         ,   Q { other.Q->Clone() }
         ,   eps(other.eps)
+        ,   method(other.method)
         {}
       
     protected:
@@ -46,6 +59,8 @@ namespace GJK
         
         mutable Int max_iter = 128;
         mutable SReal b_stack[128] = {};
+        
+        CollisionFinderMethod method = CollisionFinderMethod::Bisection;
 
     public:
  
@@ -59,13 +74,41 @@ namespace GJK
 //            eps = eps_;
 //        }
         
+        // Prototypes of the moving primitives; e.g., for the sizes of the serialized data.
+        cref<MovingPrimitive_T> FirstPrimitive() const
+        {
+            return *P;
+        }
+        
+        cref<MovingPrimitive_T> SecondPrimitive() const
+        {
+            return *Q;
+        }
+        
+        CollisionFinderMethod Method() const
+        {
+            return method;
+        }
+        
+        void SetMethod( const CollisionFinderMethod method_ )
+        {
+            method = method_;
+        }
+        
+        // If t_cap is given, the search stops as soon as the pair is proven to be safe up to the value of *t_cap, and then returns a value >= *t_cap. This pays off if only the minimum over many pairs matters: *t_cap is then the running minimum, which other threads may lower concurrently (see CollisionFinder_MaximumSafeStepSize_Batch).
         SReal FindMaximumSafeStepSize(
             cptr<SReal> p, cptr<SReal> u,
             cptr<SReal> q, cptr<SReal> v,
             const SReal tinit,
-            const bool reuse_direction = true
+            const bool reuse_direction = true,
+            const std::atomic<SReal> * t_cap = nullptr
         ) const
         {
+            if( method == CollisionFinderMethod::ConservativeAdvancement )
+            {
+                return FindMaximumSafeStepSize_ConservativeAdvancement( p, u, q, v, tinit, reuse_direction, t_cap );
+            }
+            
             GJK_tic(ClassName()+"::FindMaximumSafeStepSize");
             
             SReal a = Scalar::Zero<SReal>;
@@ -105,6 +148,26 @@ namespace GJK
             {
                 ++iter;
                 
+                if( t_cap != nullptr )
+                {
+                    const SReal cap = t_cap->load( std::memory_order_relaxed );
+                    
+                    if( a >= cap )
+                    {
+                        GJK_print("Terminating because the step size cap is reached.");
+                        GJK_toc(ClassName()+"::FindMaximumSafeStepSize");
+                        return a;
+                    }
+                    
+                    // Nothing beyond the cap needs to be tested.
+                    if( b > cap )
+                    {
+                        b = cap;
+                        P->SetSecondTime(b);
+                        Q->SetSecondTime(b);
+                    }
+                }
+                
                 GJK_DUMP(iter);
                 GJK_DUMP(a);
                 GJK_DUMP(b);
@@ -169,6 +232,136 @@ namespace GJK
             }
         }
         
+    protected:
+        
+        // p and q are serialized as by WriteCoordinatesSerialized, u and v as by WriteVelocitiesSerialized; in both formats, the coordinates of point j start at index 1 + AMB_DIM + AMB_DIM * j.
+        SReal FindMaximumSafeStepSize_ConservativeAdvancement(
+            cptr<SReal> p, cptr<SReal> u,
+            cptr<SReal> q, cptr<SReal> v,
+            const SReal tinit,
+            const bool reuse_direction,
+            const std::atomic<SReal> * t_cap
+        ) const
+        {
+            GJK_tic(ClassName()+"::FindMaximumSafeStepSize_ConservativeAdvancement");
+            
+            P->ReadCoordinatesSerialized(p);
+            P->ReadVelocitiesSerialized(u);
+            P->SetTimeScale(Scalar::One<SReal>);
+            
+            Q->ReadCoordinatesSerialized(q);
+            Q->ReadVelocitiesSerialized(v);
+            Q->SetTimeScale(Scalar::One<SReal>);
+            
+            const Int P_count = P->PointCount();
+            const Int Q_count = Q->PointCount();
+            
+            cptr<SReal> P_x = p + 1 + AMB_DIM;
+            cptr<SReal> P_v = u + 1 + AMB_DIM;
+            cptr<SReal> Q_x = q + 1 + AMB_DIM;
+            cptr<SReal> Q_v = v + 1 + AMB_DIM;
+            
+            GJK_Real x [AMB_DIM+1];
+            GJK_Real y [AMB_DIM+1];
+            
+            SReal t = Scalar::Zero<SReal>;
+            
+            for( Int iter = 0; iter < max_iter; ++iter )
+            {
+                const SReal t_max = (t_cap != nullptr) ? Min( tinit, t_cap->load( std::memory_order_relaxed ) ) : tinit;
+                
+                if( t >= t_max )
+                {
+                    GJK_toc(ClassName()+"::FindMaximumSafeStepSize_ConservativeAdvancement");
+                    return t;
+                }
+                
+                // With equal first and second time, the space-time polytopes are the polytopes at time t; their time coordinates coincide.
+                P->SetFirstTime(t);
+                P->SetSecondTime(t);
+                Q->SetFirstTime(t);
+                Q->SetSecondTime(t);
+                
+                const SReal d2 = static_cast<SReal>( G.Witnesses( *P, &x[0], *Q, &y[0], reuse_direction && (iter > 0) ) );
+                
+                GJK_DUMP(iter);
+                GJK_DUMP(t);
+                GJK_DUMP(d2);
+                
+                if( d2 <= Scalar::Zero<SReal> )
+                {
+                    // Touching or intersecting at t; t == 0 only if they intersect already at the start.
+                    GJK_toc(ClassName()+"::FindMaximumSafeStepSize_ConservativeAdvancement");
+                    return t;
+                }
+                
+                // Unit separating direction from P to Q.
+                SReal n [AMB_DIM];
+                
+                const SReal d_inv = Scalar::One<SReal> / Sqrt(d2);
+                
+                for( Int k = 0; k < AMB_DIM; ++k )
+                {
+                    n[k] = static_cast<SReal>( y[k] - x[k] ) * d_inv;
+                }
+                
+                // The gap between point i of P and point j of Q along n is (b_j - a_i) + (s - t) (beta_j - alpha_i) at time s; it is positive at s = t. Find the first time at which one of them vanishes.
+                SReal dt = Scalar::Max<SReal>;
+                
+                for( Int i = 0; i < P_count; ++i )
+                {
+                    SReal a_i     = Scalar::Zero<SReal>;
+                    SReal alpha_i = Scalar::Zero<SReal>;
+                    
+                    for( Int k = 0; k < AMB_DIM; ++k )
+                    {
+                        a_i     += ( P_x[AMB_DIM * i + k] + t * P_v[AMB_DIM * i + k] ) * n[k];
+                        alpha_i += P_v[AMB_DIM * i + k] * n[k];
+                    }
+                    
+                    for( Int j = 0; j < Q_count; ++j )
+                    {
+                        SReal b_j    = Scalar::Zero<SReal>;
+                        SReal beta_j = Scalar::Zero<SReal>;
+                        
+                        for( Int k = 0; k < AMB_DIM; ++k )
+                        {
+                            b_j    += ( Q_x[AMB_DIM * j + k] + t * Q_v[AMB_DIM * j + k] ) * n[k];
+                            beta_j += Q_v[AMB_DIM * j + k] * n[k];
+                        }
+                        
+                        const SReal closing = alpha_i - beta_j;
+                        
+                        if( closing > Scalar::Zero<SReal> )
+                        {
+                            dt = Min( dt, Max( Scalar::Zero<SReal>, b_j - a_i ) / closing );
+                        }
+                    }
+                }
+                
+                // The polytopes do not intersect on [t, t + dt[.
+                if( t + dt > t_max )
+                {
+                    GJK_print("Terminating because full step size is acceptable.");
+                    GJK_toc(ClassName()+"::FindMaximumSafeStepSize_ConservativeAdvancement");
+                    return t_max;
+                }
+                
+                if( dt <= eps * (t + dt) )
+                {
+                    GJK_toc(ClassName()+"::FindMaximumSafeStepSize_ConservativeAdvancement");
+                    return t;
+                }
+                
+                // Stop short of t + dt, where the polytopes may touch. For translations, the next step then terminates.
+                t += (Scalar::One<SReal> - eps) * dt;
+            }
+            
+            GJK_toc(ClassName()+"::FindMaximumSafeStepSize_ConservativeAdvancement");
+            wprint(ClassName()+"::FindMaximumSafeStepSize_ConservativeAdvancement: iter >= max_iter");
+            return t;
+        }
+        
     public:
         
         std::string ClassName() const
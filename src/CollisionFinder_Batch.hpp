@@ -0,0 +1,98 @@
+#pragma once
+
+namespace GJK
+{
+    // Lowers a to x if x is smaller; lock-free for the floating point types.
+    template<typename T>
+    inline void AtomicMin( mref<std::atomic<T>> a, const T x )
+    {
+        T y = a.load( std::memory_order_relaxed );
+
+        while( (x < y) && !a.compare_exchange_weak( y, x, std::memory_order_relaxed ) )
+        {}
+    }
+
+    // Maximal safe step sizes for many pairs of moving primitives.
+    //
+    // Pair k consists of the primitive pairs[2*k] of the first set and the primitive pairs[2*k+1] of the second set. Each thread works on its own copy of the prototype F_ (so the method and tolerance of F_ apply) and pulls the pairs dynamically from a GJK_JobScheduler.
+    //
+    // Returns the minimum of the safe step sizes over all pairs, which is what line searches need. All threads share the running minimum; as soon as it drops below threshold, the threads stop, because the result is already known to be too small. The entries of step_sizes of the pairs skipped this way are set to -1. With threshold <= 0, all pairs are processed.
+    //
+    // With pruneQ == true, the running minimum is also handed to FindMaximumSafeStepSize as cap: a pair is only refined until it is proven safe up to the current minimum. This saves most of the iterations, but then step_sizes[k] is only exact for pairs below the running minimum; for the others it is some value that is at least the final minimum.
+
+    template<int AMB_DIM, typename Real, typename Int, typename SReal>
+    SReal CollisionFinder_MaximumSafeStepSize_Batch
+    (
+        cref<CollisionFinder<AMB_DIM,Real,Int,SReal>> F_,  // prototype collision finder
+        const Int pair_count,                               // number of primitive pairs
+        cptr<Int> pairs,                                    // matrix of size pair_count x 2 of indices into the first and second set
+        cptr<SReal> P_coords,                               // matrix of size (number of first primitives) x F_.FirstPrimitive().CoordinateSize(); see WriteCoordinatesSerialized
+        cptr<SReal> P_velocs,                               // matrix of size (number of first primitives) x F_.FirstPrimitive().VelocitySize(); see WriteVelocitiesSerialized
+        cptr<SReal> Q_coords,                               // same for the second set
+        cptr<SReal> Q_velocs,
+        const SReal tinit,                                  // maximal step size to test
+        mptr<SReal> step_sizes = nullptr,                   // optional vector of size pair_count for the safe step size of each pair
+        const SReal threshold = 0,                          // stop once the minimum is below threshold
+        const Int thread_count = 1,
+        const Int chunk_size = 64,                          // pairs per chunk of the dynamic schedule; small chunks let the threads notice an early exit sooner
+        const bool pruneQ = true                            // pass the running minimum as cap to FindMaximumSafeStepSize
+    )
+    {
+        tic("CollisionFinder_MaximumSafeStepSize_Batch");
+
+        const Int P_coord_size = F_.FirstPrimitive().CoordinateSize();
+        const Int P_veloc_size = F_.FirstPrimitive().VelocitySize();
+        const Int Q_coord_size = F_.SecondPrimitive().CoordinateSize();
+        const Int Q_veloc_size = F_.SecondPrimitive().VelocitySize();
+
+        if( step_sizes != nullptr )
+        {
+            std::fill_n( step_sizes, pair_count, -Scalar::One<SReal> );
+        }
+
+        alignas(ObjectAlignment) std::atomic<SReal> global_min { tinit };
+
+        GJK_JobScheduler<Int> scheduler ( Int(0), pair_count, thread_count, chunk_size );
+
+        ParallelDo(
+            [&]( const Int thread )
+            {
+                CollisionFinder<AMB_DIM,Real,Int,SReal> F ( F_ );
+
+                auto jobs = scheduler.GetWorker( thread );
+
+                Int k;
+
+                while( jobs.Next(k) )
+                {
+                    if( global_min.load( std::memory_order_relaxed ) < threshold )
+                    {
+                        break;
+                    }
+
+                    const Int i = pairs[2 * k    ];
+                    const Int j = pairs[2 * k + 1];
+
+                    const SReal t = F.FindMaximumSafeStepSize(
+                        &P_coords[P_coord_size * i], &P_velocs[P_veloc_size * i],
+                        &Q_coords[Q_coord_size * j], &Q_velocs[Q_veloc_size * j],
+                        tinit, true, pruneQ ? &global_min : nullptr
+                    );
+
+                    if( step_sizes != nullptr )
+                    {
+                        step_sizes[k] = t;
+                    }
+
+                    AtomicMin( global_min, t );
+                }
+            },
+            thread_count
+        );
+
+        toc("CollisionFinder_MaximumSafeStepSize_Batch");
+
+        return global_min.load();
+    }
+
+} // namespace GJK
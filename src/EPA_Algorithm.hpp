@@ -0,0 +1,911 @@
+#pragma once
+
+namespace GJK
+{
+    enum class EPA_Reason
+    {
+        NoReason,
+        Converged,
+        MaxVertexCount,
+        Degenerate
+    };
+
+    // Expanding Polytope Algorithm (cf. van den Bergen 2001) for the penetration depth of two overlapping convex primitives P and Q. Only implemented for AMB_DIM = 2 and AMB_DIM = 3.
+    //
+    // If GJK finds an intersection, the origin lies in the Minkowski difference D = P - Q. The penetration depth is the distance of the origin to the boundary of D, and the closest boundary point z = depth * normal is the shortest translation that separates the primitives: After translating Q by z (or P by -z), they only touch. So the normal points from P towards Q. The witnesses x in P and y in Q satisfy x - y = z.
+    //
+    // EPA starts from the final simplex of GJK (see GJK_Algorithm::WriteSimplex and GJK_Algorithm_Vectorized::WriteSimplex). If the simplex is not full-dimensional (e.g., because GJK stopped with CollisionTolerance), it is first blown up by support points in auxiliary directions. Then EPA repeatedly picks the facet of the polytope that is closest to the origin and adds the support point of D in the direction of the facet's normal; the facets that can see the new point are replaced by a fan of new facets over their horizon. EPA stops once the new point does not lie more than TOL beyond the picked facet.
+    //
+    // For polytopes, the result is exact up to rounding. For smooth primitives like Ellipsoid, the polytope approximates D from inside, so the depth is a lower bound; EPA stops after MAX_VERTEX_COUNT vertices with EPA_Reason::MaxVertexCount.
+    //
+    // If D has no interior (e.g., for two coplanar triangles in 3D), the depth is 0 and the normal is perpendicular to the affine hull of D (EPA_Reason::Degenerate); the witnesses are those of GJK then.
+
+    template<int AMB_DIM, typename Real_, typename Int_>
+    class alignas(ObjectAlignment) EPA_Algorithm
+    {
+        ASSERT_FLOAT(Real_);
+        ASSERT_INT  (Int_ );
+
+        static_assert( (AMB_DIM == 2) || (AMB_DIM == 3), "EPA_Algorithm: Only implemented for AMB_DIM = 2 and AMB_DIM = 3." );
+
+    public:
+
+        using Int  = Int_;
+        using Real = Real_;
+
+        static constexpr Real eps = cSqrt(std::numeric_limits<Real>::epsilon());
+
+        static constexpr Int MAX_VERTEX_COUNT = (AMB_DIM == 2) ? 64 : 128;
+        static constexpr Int MAX_FACET_COUNT  = (AMB_DIM == 2) ? MAX_VERTEX_COUNT : 2 * MAX_VERTEX_COUNT - 4;
+
+    protected:
+
+        static constexpr Real zero = Scalar::Zero<Real>;
+        static constexpr Real one  = Scalar::One <Real>;
+
+        // A facet is an edge in 2D and a triangle in 3D. Its vertices are ordered such that the normal points outwards (counterclockwise in 2D; counterclockwise seen from outside in 3D).
+
+        Real W     [MAX_VERTEX_COUNT][AMB_DIM] = {}; // vertices w = p - q of the polytope
+        Real Q_supp[MAX_VERTEX_COUNT][AMB_DIM] = {}; // support points in Q belonging to the vertices
+
+        Int  facet_vertices [MAX_FACET_COUNT][AMB_DIM] = {};
+        Real facet_normals  [MAX_FACET_COUNT][AMB_DIM] = {}; // outward unit normals
+        Real facet_dist     [MAX_FACET_COUNT]          = {}; // signed distance of the origin to the facet's plane; positive if the origin lies on the inner side
+
+        // Scratch space for Expand.
+        Int  ridges      [3 * MAX_FACET_COUNT][2]       = {};
+        Int  new_vertices[3 * MAX_FACET_COUNT][AMB_DIM] = {};
+        Real new_normals [3 * MAX_FACET_COUNT][AMB_DIM] = {};
+        Real new_dist    [3 * MAX_FACET_COUNT]          = {};
+        bool visibleQ    [MAX_FACET_COUNT]              = {};
+
+        Real normal [AMB_DIM] = {};
+        Real x      [AMB_DIM] = {};
+        Real y      [AMB_DIM] = {};
+
+        Real depth = zero;
+        Real TOL   = zero;
+
+        Int vertex_count = 0;
+        Int facet_count  = 0;
+        Int iter         = 0;
+
+        EPA_Reason reason = EPA_Reason::NoReason;
+
+    public:
+
+        EPA_Algorithm() = default;
+
+        ~EPA_Algorithm() = default;
+
+        static constexpr Int AmbDim()
+        {
+            return AMB_DIM;
+        }
+
+        Real PenetrationDepth() const
+        {
+            return depth;
+        }
+
+        void WriteNormal( mptr<Real> n ) const
+        {
+            copy_buffer<AMB_DIM>( &normal[0], n );
+        }
+
+        // Writes the witnesses x in P and y in Q; x - y = PenetrationDepth() * normal.
+        void WriteWitnesses( mptr<Real> x_out, mptr<Real> y_out ) const
+        {
+            copy_buffer<AMB_DIM>( &x[0], x_out );
+            copy_buffer<AMB_DIM>( &y[0], y_out );
+        }
+
+        EPA_Reason Reason() const
+        {
+            return reason;
+        }
+
+        Int IterationCount() const
+        {
+            return iter;
+        }
+
+        Int VertexCount() const
+        {
+            return vertex_count;
+        }
+
+        // ################################################################
+        // ##########################  Compute  ###########################
+        // ################################################################
+
+        // P_simplex and Q_simplex are matrices of size simplex_size x AMB_DIM holding the support points of the final GJK simplex in P and Q, and lambda holds the barycentric coordinates of GJK's closest point; simplex_size <= AMB_DIM + 1.
+        //
+        // If TOL_ > 0, EPA stops as soon as the support point in the direction of the closest facet lies at most TOL_ beyond the facet. Otherwise, eps times the larger radius of the primitives is used.
+        //
+        // Like GJK_Algorithm::Compute, Compute is templated on the primitive types so that the support functions of concrete classes can be inlined.
+
+        template<typename P_T, typename Q_T>
+        void Compute(
+            cref<P_T> P,
+            cref<Q_T> Q,
+            cptr<Real> P_simplex,
+            cptr<Real> Q_simplex,
+            cptr<Real> lambda,
+            const Int simplex_size,
+            const Real TOL_ = zero
+        )
+        {
+            GJK_tic(ClassName()+"::Compute");
+
+            iter         = 0;
+            vertex_count = 0;
+            facet_count  = 0;
+            depth        = zero;
+            reason       = EPA_Reason::NoReason;
+
+            TOL = (TOL_ > zero) ? TOL_ : eps * Sqrt( Max( P.SquaredRadius(), Q.SquaredRadius() ) );
+
+            // GJK's witnesses; they are kept if D turns out to be degenerate.
+            zerofy_buffer<AMB_DIM>( &x[0] );
+            zerofy_buffer<AMB_DIM>( &y[0] );
+            zerofy_buffer<AMB_DIM>( &normal[0] );
+
+            normal[0] = one;
+
+            for( Int i = 0; i < simplex_size; ++i )
+            {
+                for( Int k = 0; k < AMB_DIM; ++k )
+                {
+                    x[k] += lambda[i] * P_simplex[AMB_DIM * i + k];
+                    y[k] += lambda[i] * Q_simplex[AMB_DIM * i + k];
+                }
+            }
+
+            // Keep the affinely independent vertices of the GJK simplex.
+            for( Int i = 0; i < simplex_size; ++i )
+            {
+                Real w [AMB_DIM];
+
+                for( Int k = 0; k < AMB_DIM; ++k )
+                {
+                    w[k] = P_simplex[AMB_DIM * i + k] - Q_simplex[AMB_DIM * i + k];
+                }
+
+                if( (vertex_count == 0) || (AffineDistance(w) > TOL) )
+                {
+                    PushVertex( w, &Q_simplex[AMB_DIM * i] );
+                }
+            }
+
+            if( (vertex_count == 0) || !BlowUp(P,Q) )
+            {
+                reason = EPA_Reason::Degenerate;
+
+                GJK_toc(ClassName()+"::Compute");
+                return;
+            }
+
+            InitialFacets();
+
+            Int f = ClosestFacet();
+
+            while( true )
+            {
+                Real w [AMB_DIM];
+                Real q [AMB_DIM];
+
+                const Real dist = SupportPoint( P, Q, &facet_normals[f][0], &w[0], &q[0] );
+
+                if( dist - facet_dist[f] <= TOL )
+                {
+                    reason = EPA_Reason::Converged;
+                    break;
+                }
+
+                if( vertex_count >= MAX_VERTEX_COUNT )
+                {
+                    reason = EPA_Reason::MaxVertexCount;
+                    break;
+                }
+
+                PushVertex( w, q );
+
+                if( !Expand( vertex_count - 1 ) )
+                {
+                    // The facets are left untouched, so we report the current closest facet.
+                    --vertex_count;
+                    reason = EPA_Reason::Degenerate;
+                    break;
+                }
+
+                ++iter;
+
+                f = ClosestFacet();
+            }
+
+            WriteResult( f );
+
+            GJK_toc(ClassName()+"::Compute");
+        }
+
+        // Continues from the final simplex of gjk, which must have been computed for P and Q.
+        template<typename P_T, typename Q_T>
+        void Compute(
+            cref<P_T> P,
+            cref<Q_T> Q,
+            cref<GJK_Algorithm<AMB_DIM,Real,Int>> gjk,
+            const Real TOL_ = zero
+        )
+        {
+            Real P_simplex [AMB_DIM+1][AMB_DIM];
+            Real Q_simplex [AMB_DIM+1][AMB_DIM];
+            Real lambda    [AMB_DIM+1];
+
+            const Int simplex_size = gjk.WriteSimplex( &P_simplex[0][0], &Q_simplex[0][0], &lambda[0] );
+
+            Compute( P, Q, &P_simplex[0][0], &Q_simplex[0][0], &lambda[0], simplex_size, TOL_ );
+        }
+
+    protected:
+
+        template<typename P_T, typename Q_T>
+        static Real SupportPoint( cref<P_T> P, cref<Q_T> Q, cptr<Real> dir, mptr<Real> w, mptr<Real> q )
+        {
+            // Support point of D = P - Q in direction dir.
+            const Real a = P.MaxSupportVector( dir, w );
+            const Real b = Q.MinSupportVector( dir, q );
+
+            for( Int k = 0; k < AMB_DIM; ++k )
+            {
+                w[k] -= q[k];
+            }
+
+            return a - b;
+        }
+
+        void PushVertex( cptr<Real> w, cptr<Real> q )
+        {
+            copy_buffer<AMB_DIM>( w, &W     [vertex_count][0] );
+            copy_buffer<AMB_DIM>( q, &Q_supp[vertex_count][0] );
+
+            ++vertex_count;
+        }
+
+        static Real Dot( cptr<Real> a, cptr<Real> b )
+        {
+            return dot_buffers<AMB_DIM>( a, b );
+        }
+
+        static void Cross( cptr<Real> a, cptr<Real> b, mptr<Real> c )
+        {
+            c[0] = a[1] * b[2] - a[2] * b[1];
+            c[1] = a[2] * b[0] - a[0] * b[2];
+            c[2] = a[0] * b[1] - a[1] * b[0];
+        }
+
+        // Distance of w to the affine hull of the first vertex_count vertices; vertex_count must be positive.
+        Real AffineDistance( cptr<Real> w ) const
+        {
+            Real d [AMB_DIM];
+            Real e [AMB_DIM];
+
+            for( Int k = 0; k < AMB_DIM; ++k )
+            {
+                d[k] = w[k] - W[0][k];
+            }
+
+            switch( vertex_count )
+            {
+                case 1:
+                {
+                    return Sqrt( Dot(d,d) );
+                }
+                case 2:
+                {
+                    for( Int k = 0; k < AMB_DIM; ++k )
+                    {
+                        e[k] = W[1][k] - W[0][k];
+                    }
+
+                    const Real ee = Dot(e,e);
+
+                    if constexpr ( AMB_DIM == 2 )
+                    {
+                        return Abs( e[0] * d[1] - e[1] * d[0] ) / Sqrt(ee);
+                    }
+                    else
+                    {
+                        Real c [AMB_DIM];
+
+                        Cross( e, d, c );
+
+                        return Sqrt( Dot(c,c) / ee );
+                    }
+                }
+                case 3:
+                {
+                    // Only reached for AMB_DIM = 3.
+                    if constexpr ( AMB_DIM == 3 )
+                    {
+                        Real a [AMB_DIM];
+                        Real n [AMB_DIM];
+
+                        for( Int k = 0; k < AMB_DIM; ++k )
+                        {
+                            a[k] = W[1][k] - W[0][k];
+                            e[k] = W[2][k] - W[0][k];
+                        }
+
+                        Cross( a, e, n );
+
+                        return Abs( Dot(n,d) ) / Sqrt( Dot(n,n) );
+                    }
+                    else
+                    {
+                        return zero;
+                    }
+                }
+                default:
+                {
+                    return zero;
+                }
+            }
+        }
+
+        // Adds support points in auxiliary directions until the polytope is full-dimensional. Returns false if D is not full-dimensional; then normal is set to a unit vector perpendicular to D.
+        template<typename P_T, typename Q_T>
+        bool BlowUp( cref<P_T> P, cref<Q_T> Q )
+        {
+            while( vertex_count < AMB_DIM + 1 )
+            {
+                // Candidate directions; they are unit vectors perpendicular to the current affine hull.
+                Real dirs [2 * AMB_DIM][AMB_DIM] = {};
+                Int  dir_count = 0;
+
+                if( vertex_count == 1 )
+                {
+                    for( Int k = 0; k < AMB_DIM; ++k )
+                    {
+                        dirs[2 * k    ][k] =  one;
+                        dirs[2 * k + 1][k] = -one;
+                    }
+
+                    dir_count = 2 * AMB_DIM;
+                }
+                else if( vertex_count == 2 )
+                {
+                    Real e [AMB_DIM];
+
+                    for( Int k = 0; k < AMB_DIM; ++k )
+                    {
+                        e[k] = W[1][k] - W[0][k];
+                    }
+
+                    if constexpr ( AMB_DIM == 2 )
+                    {
+                        const Real s = InvSqrt( Dot(e,e) );
+
+                        dirs[0][0] = -e[1] * s;
+                        dirs[0][1] =  e[0] * s;
+                        dirs[1][0] =  e[1] * s;
+                        dirs[1][1] = -e[0] * s;
+
+                        dir_count = 2;
+                    }
+                    else
+                    {
+                        // Cross e with the coordinate axis that is most perpendicular to it.
+                        Int j = 0;
+
+                        for( Int k = 1; k < AMB_DIM; ++k )
+                        {
+                            j = ( Abs(e[k]) < Abs(e[j]) ) ? k : j;
+                        }
+
+                        Real axis [AMB_DIM] = {};
+                        Real u    [AMB_DIM];
+                        Real v    [AMB_DIM];
+
+                        axis[j] = one;
+
+                        Cross( e, axis, u );
+                        Cross( e, u,    v );
+
+                        const Real s_u = InvSqrt( Dot(u,u) );
+                        const Real s_v = InvSqrt( Dot(v,v) );
+
+                        for( Int k = 0; k < AMB_DIM; ++k )
+                        {
+                            dirs[0][k] =  u[k] * s_u;
+                            dirs[1][k] = -u[k] * s_u;
+                            dirs[2][k] =  v[k] * s_v;
+                            dirs[3][k] = -v[k] * s_v;
+                        }
+
+                        dir_count = 4;
+                    }
+                }
+                else
+                {
+                    // vertex_count == 3 and AMB_DIM == 3.
+                    if constexpr ( AMB_DIM == 3 )
+                    {
+                        Real a [AMB_DIM];
+                        Real b [AMB_DIM];
+                        Real n [AMB_DIM];
+
+                        for( Int k = 0; k < AMB_DIM; ++k )
+                        {
+                            a[k] = W[1][k] - W[0][k];
+                            b[k] = W[2][k] - W[0][k];
+                        }
+
+                        Cross( a, b, n );
+
+                        const Real s = InvSqrt( Dot(n,n) );
+
+                        for( Int k = 0; k < AMB_DIM; ++k )
+                        {
+                            dirs[0][k] =  n[k] * s;
+                            dirs[1][k] = -n[k] * s;
+                        }
+
+                        dir_count = 2;
+                    }
+                }
+
+                bool foundQ = false;
+
+                for( Int i = 0; i < dir_count; ++i )
+                {
+                    foundQ = TryDirection( P, Q, &dirs[i][0] );
+
+                    if( foundQ )
+                    {
+                        break;
+                    }
+                }
+
+                if( !foundQ )
+                {
+                    copy_buffer<AMB_DIM>( &dirs[0][0], &normal[0] );
+
+                    return false;
+                }
+            }
+
+            return true;
+        }
+
+        template<typename P_T, typename Q_T>
+        bool TryDirection( cref<P_T> P, cref<Q_T> Q, cptr<Real> dir )
+        {
+            Real w [AMB_DIM];
+            Real q [AMB_DIM];
+
+            (void)SupportPoint( P, Q, dir, &w[0], &q[0] );
+
+            if( AffineDistance(w) > TOL )
+            {
+                PushVertex( w, q );
+
+                return true;
+            }
+            else
+            {
+                return false;
+            }
+        }
+
+        // Computes normal and distance of a facet with vertices vertices[0],...,vertices[AMB_DIM-1]. Returns false if the facet is degenerate.
+        bool FacetData( cptr<Int> vertices, mptr<Real> n, mref<Real> dist ) const
+        {
+            cptr<Real> a = &W[vertices[0]][0];
+            cptr<Real> b = &W[vertices[1]][0];
+
+            Real e [AMB_DIM];
+
+            for( Int k = 0; k < AMB_DIM; ++k )
+            {
+                e[k] = b[k] - a[k];
+            }
+
+            if constexpr ( AMB_DIM == 2 )
+            {
+                n[0] =  e[1];
+                n[1] = -e[0];
+            }
+            else
+            {
+                cptr<Real> c = &W[vertices[2]][0];
+
+                Real f [AMB_DIM];
+
+                for( Int k = 0; k < AMB_DIM; ++k )
+                {
+                    f[k] = c[k] - a[k];
+                }
+
+                Cross( e, f, n );
+            }
+
+            const Real nn = Dot(n,n);
+
+            if( !(nn > zero) )
+            {
+                return false;
+            }
+
+            const Real s = InvSqrt(nn);
+
+            for( Int k = 0; k < AMB_DIM; ++k )
+            {
+                n[k] *= s;
+            }
+
+            dist = Dot(n,a);
+
+            return true;
+        }
+
+        // Sets up the facets of the initial simplex with outward normals.
+        void InitialFacets()
+        {
+            // Point inside the simplex.
+            Real c [AMB_DIM] = {};
+
+            for( Int i = 0; i < AMB_DIM + 1; ++i )
+            {
+                for( Int k = 0; k < AMB_DIM; ++k )
+                {
+                    c[k] += W[i][k];
+                }
+            }
+
+            for( Int k = 0; k < AMB_DIM; ++k )
+            {
+                c[k] *= Inv<Real>(AMB_DIM + 1);
+            }
+
+            facet_count = 0;
+
+            // Facet i is opposite to vertex i.
+            for( Int i = 0; i < AMB_DIM + 1; ++i )
+            {
+                mptr<Int> vertices = &facet_vertices[facet_count][0];
+
+                Int j = 0;
+
+                for( Int v = 0; v < AMB_DIM + 1; ++v )
+                {
+                    if( v != i )
+                    {
+                        vertices[j++] = v;
+                    }
+                }
+
+                // The simplex is nondegenerate, so FacetData succeeds.
+                (void)FacetData( vertices, &facet_normals[facet_count][0], facet_dist[facet_count] );
+
+                if( Dot( &facet_normals[facet_count][0], c ) > facet_dist[facet_count] )
+                {
+                    std::swap( vertices[0], vertices[1] );
+
+                    (void)FacetData( vertices, &facet_normals[facet_count][0], facet_dist[facet_count] );
+                }
+
+                ++facet_count;
+            }
+        }
+
+        Int ClosestFacet() const
+        {
+            Int f = 0;
+
+            for( Int g = 1; g < facet_count; ++g )
+            {
+                f = ( facet_dist[g] < facet_dist[f] ) ? g : f;
+            }
+
+            return f;
+        }
+
+        // Replaces the facets that can see vertex v by the fan from v over their horizon. Returns false (and leaves the facets untouched) if a new facet would be degenerate or if there is no space left.
+        bool Expand( const Int v )
+        {
+            cptr<Real> w = &W[v][0];
+
+            Int visible_count = 0;
+
+            for( Int f = 0; f < facet_count; ++f )
+            {
+                visibleQ[f] = ( Dot( &facet_normals[f][0], w ) > facet_dist[f] );
+
+                visible_count += visibleQ[f];
+            }
+
+            // The horizon consists of the ridges (vertices in 2D, edges in 3D) of visible facets whose other facet is invisible. Since all facets are oriented consistently, the two facets at a ridge traverse it in opposite directions.
+            Int ridge_count = 0;
+
+            for( Int f = 0; f < facet_count; ++f )
+            {
+                if( visibleQ[f] )
+                {
+                    cptr<Int> vertices = &facet_vertices[f][0];
+
+                    for( Int j = 0; j < AMB_DIM; ++j )
+                    {
+                        ridges[ridge_count][0] = vertices[j];
+                        ridges[ridge_count][1] = vertices[(j + 1) % AMB_DIM];
+                        ++ridge_count;
+                    }
+                }
+            }
+
+            Int new_count = 0;
+
+            if constexpr ( AMB_DIM == 2 )
+            {
+                // The visible edges form a chain; its first vertex is never an end point and its last vertex is never a start point of a visible edge.
+                for( Int r = 0; r < ridge_count; r += 2 )
+                {
+                    const Int a = ridges[r][0];
+                    const Int b = ridges[r][1];
+
+                    bool a_endQ   = false;
+                    bool b_startQ = false;
+
+                    for( Int s = 0; s < ridge_count; s += 2 )
+                    {
+                        a_endQ   = a_endQ   || ( ridges[s][1] == a );
+                        b_startQ = b_startQ || ( ridges[s][0] == b );
+                    }
+
+                    if( !a_endQ )
+                    {
+                        new_vertices[new_count][0] = a;
+                        new_vertices[new_count][1] = v;
+                        ++new_count;
+                    }
+
+                    if( !b_startQ )
+                    {
+                        new_vertices[new_count][0] = v;
+                        new_vertices[new_count][1] = b;
+                        ++new_count;
+                    }
+                }
+            }
+            else
+            {
+                for( Int r = 0; r < ridge_count; ++r )
+                {
+                    const Int a = ridges[r][0];
+                    const Int b = ridges[r][1];
+
+                    bool innerQ = false;
+
+                    for( Int s = 0; s < ridge_count; ++s )
+                    {
+                        innerQ = innerQ || ( (ridges[s][0] == b) && (ridges[s][1] == a) );
+                    }
+
+                    if( !innerQ )
+                    {
+                        new_vertices[new_count][0] = a;
+                        new_vertices[new_count][1] = b;
+                        new_vertices[new_count][2] = v;
+                        ++new_count;
+                    }
+                }
+            }
+
+            if( (visible_count == 0) || (facet_count - visible_count + new_count > MAX_FACET_COUNT) )
+            {
+                return false;
+            }
+
+            for( Int f = 0; f < new_count; ++f )
+            {
+                if( !FacetData( &new_vertices[f][0], &new_normals[f][0], new_dist[f] ) )
+                {
+                    return false;
+                }
+            }
+
+            // Remove the visible facets and append the new ones.
+            Int g = 0;
+
+            for( Int f = 0; f < facet_count; ++f )
+            {
+                if( !visibleQ[f] )
+                {
+                    if( g != f )
+                    {
+                        copy_buffer<AMB_DIM>( &facet_vertices[f][0], &facet_vertices[g][0] );
+                        copy_buffer<AMB_DIM>( &facet_normals [f][0], &facet_normals [g][0] );
+                        facet_dist[g] = facet_dist[f];
+                    }
+
+                    ++g;
+                }
+            }
+
+            for( Int f = 0; f < new_count; ++f )
+            {
+                copy_buffer<AMB_DIM>( &new_vertices[f][0], &facet_vertices[g][0] );
+                copy_buffer<AMB_DIM>( &new_normals [f][0], &facet_normals [g][0] );
+                facet_dist[g] = new_dist[f];
+                ++g;
+            }
+
+            facet_count = g;
+
+            return true;
+        }
+
+        // Projects the origin onto facet f and computes depth, normal, and witnesses from it.
+        void WriteResult( const Int f )
+        {
+            cptr<Int>  vertices = &facet_vertices[f][0];
+            cptr<Real> n        = &facet_normals [f][0];
+
+            const Real d = facet_dist[f];
+
+            // If GJK stopped with CollisionTolerance, the origin may lie slightly outside of D; then d is slightly negative.
+            depth = Ramp(d);
+
+            copy_buffer<AMB_DIM>( n, &normal[0] );
+
+            Real z [AMB_DIM];
+
+            for( Int k = 0; k < AMB_DIM; ++k )
+            {
+                z[k] = d * n[k];
+            }
+
+            // Barycentric coordinates of z in the facet.
+            Real lambda [AMB_DIM];
+
+            if constexpr ( AMB_DIM == 2 )
+            {
+                cptr<Real> a = &W[vertices[0]][0];
+                cptr<Real> b = &W[vertices[1]][0];
+
+                Real e [AMB_DIM];
+                Real g [AMB_DIM];
+
+                for( Int k = 0; k < AMB_DIM; ++k )
+                {
+                    e[k] = b[k] - a[k];
+                    g[k] = z[k] - a[k];
+                }
+
+                const Real t = Max( zero, Min( one, Dot(e,g) / Dot(e,e) ) );
+
+                lambda[0] = one - t;
+                lambda[1] = t;
+            }
+            else
+            {
+                // lambda_i is the signed area of the triangle in which vertex i is replaced by z, divided by the area of the facet.
+                Real total = zero;
+
+                for( Int i = 0; i < AMB_DIM; ++i )
+                {
+                    cptr<Real> b = &W[vertices[(i + 1) % AMB_DIM]][0];
+                    cptr<Real> c = &W[vertices[(i + 2) % AMB_DIM]][0];
+
+                    Real e [AMB_DIM];
+                    Real g [AMB_DIM];
+                    Real h [AMB_DIM];
+
+                    for( Int k = 0; k < AMB_DIM; ++k )
+                    {
+                        e[k] = b[k] - z[k];
+                        g[k] = c[k] - z[k];
+                    }
+
+                    Cross( e, g, h );
+
+                    lambda[i] = Ramp( Dot(h,n) );
+
+                    total += lambda[i];
+                }
+
+                const Real s = (total > zero) ? Inv<Real>(total) : Inv<Real>(AMB_DIM);
+
+                for( Int i = 0; i < AMB_DIM; ++i )
+                {
+                    lambda[i] = (total > zero) ? (lambda[i] * s) : s;
+                }
+            }
+
+            for( Int k = 0; k < AMB_DIM; ++k )
+            {
+                y[k] = lambda[0] * Q_supp[vertices[0]][k];
+
+                for( Int i = 1; i < AMB_DIM; ++i )
+                {
+                    y[k] += lambda[i] * Q_supp[vertices[i]][k];
+                }
+
+                x[k] = y[k] + z[k];
+            }
+        }
+
+    public:
+
+        std::string ClassName() const
+        {
+            return "EPA_Algorithm<"+ToString(AMB_DIM)+","+TypeName<Real>+","+TypeName<Int>+">";
+        }
+
+    }; // EPA_Algorithm
+
+
+    // Contact data for the pair that gjk (a GJK_Algorithm_Vectorized) has finished in lane `lane`, with P and Q pointing to that pair; runs epa if the primitives intersect. Returns the signed penetration depth: for separated primitives, it is minus their distance and the normal points from the witness x to the witness y. So x - y = depth * normal holds in both cases.
+    //
+    // With offsets, the depth refers to the thickened primitives (P_offset + Q_offset is added), and the witnesses are moved onto their boundaries along the normal. Note that this requires that gjk was loaded with collision tolerance 0, i.e., without the offsets.
+    template<typename GJK_T, typename P_T, typename Q_T>
+    typename GJK_T::Real EPA_WriteContact(
+        cref<GJK_T> gjk,
+        const typename GJK_T::Int lane,
+        mref<EPA_Algorithm<GJK_T::AmbDim(),typename GJK_T::Real,typename GJK_T::Int>> epa,
+        cref<P_T> P,
+        cref<Q_T> Q,
+        mptr<typename GJK_T::Real> normal,
+        mptr<typename GJK_T::Real> x,
+        mptr<typename GJK_T::Real> y,
+        const typename GJK_T::Real P_offset = 0,
+        const typename GJK_T::Real Q_offset = 0
+    )
+    {
+        using Real = typename GJK_T::Real;
+        using Int  = typename GJK_T::Int;
+
+        constexpr Int AMB_DIM = GJK_T::AmbDim();
+
+        Real depth;
+
+        if( gjk.SeparatedQ(lane) )
+        {
+            const Real dist = Sqrt( gjk.LeastSquaredDistance(lane) );
+            const Real s    = (dist > Scalar::Zero<Real>) ? Inv<Real>(dist) : Scalar::Zero<Real>;
+
+            gjk.WriteWitnesses( lane, x, y );
+
+            for( Int k = 0; k < AMB_DIM; ++k )
+            {
+                normal[k] = s * (y[k] - x[k]);
+            }
+
+            depth = -dist;
+        }
+        else
+        {
+            Real P_simplex [AMB_DIM+1][AMB_DIM];
+            Real Q_simplex [AMB_DIM+1][AMB_DIM];
+            Real lambda    [AMB_DIM+1];
+
+            const Int simplex_size = gjk.WriteSimplex( lane, &P_simplex[0][0], &Q_simplex[0][0], &lambda[0] );
+
+            epa.Compute( P, Q, &P_simplex[0][0], &Q_simplex[0][0], &lambda[0], simplex_size );
+
+            depth = epa.PenetrationDepth();
+
+            epa.WriteNormal( normal );
+            epa.WriteWitnesses( x, y );
+        }
+
+        for( Int k = 0; k < AMB_DIM; ++k )
+        {
+            x[k] += P_offset * normal[k];
+            y[k] -= Q_offset * normal[k];
+        }
+
+        return depth + P_offset + Q_offset;
+    }
+
+} // namespace GJK
@@ -15,6 +15,47 @@ namespace GJK
         return n;
     }
     
+    // Lookup tables for the faces of a simplex with AMB_DIM+1 vertices. Faces are encoded as bit masks of their vertices.
+    //   sizes   [face]    - number of vertices of face
+    //   vertices[face][i] - i-th vertex of face; -1 for i >= sizes[face]
+    //   faces   [face][i] - face without its i-th vertex; -1 for i >= sizes[face]
+    // The tables are computed at compile time and shared by all instances of GJK_Algorithm.
+    template<int AMB_DIM, typename Int>
+    struct GJK_FacetTable
+    {
+        static constexpr Int FACE_COUNT = face_count(AMB_DIM);
+        
+        Int sizes    [FACE_COUNT] = {};
+        Int vertices [FACE_COUNT][AMB_DIM+1] = {};
+        Int faces    [FACE_COUNT][AMB_DIM+1] = {};
+        
+        constexpr GJK_FacetTable()
+        {
+            for( Int facet = 0; facet < FACE_COUNT; ++facet )
+            {
+                Int i = 0;
+                
+                for( Int vertex = 0; vertex < AMB_DIM+1; ++vertex )
+                {
+                    if( (facet >> vertex) & 1 )
+                    {
+                        vertices[facet][i] = vertex;
+                        faces   [facet][i] = facet ^ (static_cast<Int>(1) << vertex);
+                        ++i;
+                    }
+                }
+                
+                sizes[facet] = i;
+                
+                for( Int j = i; j < AMB_DIM+1; ++j )
+                {
+                    vertices[facet][j] = -1;
+                    faces   [facet][j] = -1;
+                }
+            }
+        }
+    };
+    
     enum class GJK_Reason
     {
         NoReason,
@@ -27,6 +68,27 @@ namespace GJK
         Collision,
         Separated
     };
+
+    // Subalgorithm that computes the point of least norm of the current simplex in each GJK iteration.
+    //
+    // GJK_SubAlgorithm::Johnson: Recursive walk over the faces of the simplex (see DistanceSubalgorithm). The barycentric coordinates are computed from the Gram matrix, by Cramer's rule for edges and triangles and by Cholesky decomposition for larger faces.
+    //
+    // GJK_SubAlgorithm::SignedVolumes: Signed-volumes method of Montanari, Petrinic, and Barbieri (2017). The barycentric coordinates are ratios of the signed volume of the simplex and the signed volumes of the simplices in which one vertex is replaced by the origin (projected onto the affine hull of the simplex; triangles in 3D are measured in the coordinate plane in which their projection is largest). A face is only entered if the sign of its opposite coordinate rules out the interior. This needs no Gram matrix and stays accurate for nearly degenerate simplices, e.g., thin sliver triangles. Only implemented for AMB_DIM = 2 and AMB_DIM = 3; otherwise, GJK_Algorithm falls back to Johnson.
+    enum class GJK_SubAlgorithm
+    {
+        Johnson,
+        SignedVolumes
+    };
+
+    // Accelerated GJK (cf. Montaut, Le Lidec, Petrik, Sivic, Carpentier 2022): With SetAcceleration(true), the support functions are not queried in the direction of the current closest point v but in the momentum direction d, the running average of the Nesterov points y:
+    //
+    //     y = delta * v + (1 - delta) * w,   d = delta * d + (1 - delta) * y,   delta = (k + 1) / (k + 3),
+    //
+    // where w is the support point of the previous iteration and k counts the iterations since the momentum was (re)started; a restart sets d = v and lets the next iteration query s(v). The support point s(d) is added to the simplex as an ordinary vertex. Since it need not be a descent point for v, the distance subalgorithm searches all faces of the simplex, not only those that contain s(d); so v still decreases monotonically.
+    //
+    // A query in direction d can separate the primitives, but it cannot certify convergence: The duality gap |v|^2 - <v,w> with w = s(d) underestimates the one with w = s(v). So the duality-gap stop is only evaluated for iterations without momentum. If s(d) is no descent point for v, we query s(v) in the same iteration instead and reset d = v. We restart if the gap with w = s(d) has not shrunk below the gap of the last iteration without momentum, if s(d) is already in the simplex, or if v makes no progress. Hence all results are certified by the same stopping criteria as without acceleration.
+    //
+    // Acceleration is off by default.
     
     template<int AMB_DIM, typename Real_, typename Int_>
     class alignas(ObjectAlignment) GJK_Algorithm
@@ -52,9 +114,12 @@ namespace GJK
         static constexpr Real zero      = Scalar::Zero<Real>;
         static constexpr Real one       = Scalar::One <Real>;
         
+        static constexpr GJK_FacetTable<AMB_DIM,Int> facets {};
+        
         Real coords   [AMB_DIM+1][AMB_DIM  ] = {};  //  position of the corners of the simplex; only the first simplex_size rows are defined.
         Real P_supp   [AMB_DIM+1][AMB_DIM  ] = {};  //  support points of the simplex in primitive P
         Real Q_supp   [AMB_DIM+1][AMB_DIM  ] = {};  //  support points of the simplex in primitive Q
+        Real dirs     [AMB_DIM+1][AMB_DIM  ] = {};  //  search directions in which the support points of the simplex were found (for warm starts)
 
         Real dots     [AMB_DIM+1][AMB_DIM+1] = {};  // simplex_size x simplex_size matrix of dots products of  the vectors coords[0],..., coords[simplex_size-1];
         Real Gram     [AMB_DIM  ][AMB_DIM  ] = {};  // Gram matrix of size = (simplex_size-1) x (simplex_size-1) of frame spanned by the vectors coords[i] - coords[simplex_size-1];
@@ -65,11 +130,11 @@ namespace GJK
         Real Lambda              [AMB_DIM+1] = {}; // For the right hand sides of the linear equations to solve in DistanceSubalgorithm.
         Real best_lambda         [AMB_DIM+1] = {};
         Real facet_closest_point [AMB_DIM  ] = {};
+        Real w                   [AMB_DIM  ] = {}; // most recent support point; only used with acceleration
+        Real y                   [AMB_DIM  ] = {}; // Nesterov point; only used with acceleration
+        Real d                   [AMB_DIM  ] = {}; // momentum direction; only used with acceleration
         
-        Int facet_sizes    [FACE_COUNT] = {};
-        Int facet_vertices [FACE_COUNT][AMB_DIM+1] = {};
-        Int facet_faces    [FACE_COUNT][AMB_DIM+1] = {};
-        bool visited       [FACE_COUNT] = {};
+        bool visited [FACE_COUNT] = {true};
         
         Real dotvv         = std::numeric_limits<Real>::max();
         Real olddotvv      = std::numeric_limits<Real>::max();
@@ -78,54 +143,30 @@ namespace GJK
         Real theta_squared = one;
         
         Int simplex_size = 0; //  index of last added point
+        Int seed_size = 0;    //  number of vertices set by ReadWarmStart for the next call to Compute
         Int closest_facet;
         Int sub_calls = 0;
+        Int iter = 0;
         GJK_Reason reason = GJK_Reason::NoReason;
         bool separatedQ = false;
 
+        GJK_SubAlgorithm sub_algorithm = GJK_SubAlgorithm::Johnson;
+
+        bool acceleratedQ = false; // setting; see SetAcceleration
+
     public:
         
-        GJK_Algorithm()
-        {
-            GJK_print("GJK_Algorithm()");
-            GJK_DUMP(eps);
-            GJK_DUMP(eps_squared);
-            
-            // Initializing facet_sizes, facet_vertices, and facet_faces.
-            // TODO: In principle, the compiler should be possible to populate those at compile time. Dunno how to work this black magic.
-
-            for( Int facet = 0; facet < FACE_COUNT; ++ facet )
-            {
-                Int i = 0;
-                
-                Int * restrict const vertices = &facet_vertices[facet][0];
-                Int * restrict const faces    = &facet_faces   [facet][0];
+        // The facet tables are static, so construction and copying only touch the (small) per-instance work arrays.
+        
+        GJK_Algorithm() = default;
 
-                for( Int vertex = 0; vertex < AMB_DIM+1; ++vertex )
-                {
-                    if( bit(facet,vertex) )
-                    {
-                        vertices[i] = vertex;
-                        faces[i] = set_bit_to_zero(facet,vertex);
-                        ++i;
-                    }
-                }
-                
-                facet_sizes[facet] = i;
-                
-                for( Int j = i; j < AMB_DIM+1; ++j )
-                {
-                    vertices[i] = -1;
-                    faces[i] = -1;
-                }
-            }
-            
-            visited[0] = true;
-        }
+        explicit GJK_Algorithm( const GJK_SubAlgorithm sub_algorithm_ )
+        :   sub_algorithm ( sub_algorithm_ )
+        {}
 
-        GJK_Algorithm( const GJK_Algorithm & other ) : GJK_Algorithm() {};
+        GJK_Algorithm( const GJK_Algorithm & other ) = default;
         
-        GJK_Algorithm( GJK_Algorithm  && other ) : GJK_Algorithm() {};
+        GJK_Algorithm( GJK_Algorithm  && other ) = default;
         
         ~GJK_Algorithm() = default;
         
@@ -154,11 +195,97 @@ namespace GJK
         {
             copy_buffer<AMB_DIM>( &v[0], vec );
         }
+        
+        // Sets the starting direction for the next call to Compute with reuse_direction = true, e.g., the closest point of a previous call for the same pair.
+        template<typename ExtReal>
+        void ReadClosestPoint( const ExtReal * restrict const vec )
+        {
+            copy_buffer<AMB_DIM>( vec, &v[0] );
+            
+            seed_size = 0;
+        }
+        
+        // Size of the records of WriteWarmStart and ReadWarmStart: for each of the AMB_DIM + 1 simplex vertices its barycentric coordinate and search direction, followed by v.
+        static constexpr Int WarmStartSize()
+        {
+            return (AMB_DIM+1) * (AMB_DIM+1) + AMB_DIM;
+        }
+        
+        // Writes the final simplex and the final v of the last call to Compute to record. Vertices are stored by the search directions in which they were found, not by their positions, so that they can be evaluated anew for moved primitives. Unused vertices get barycentric coordinate 0.
+        template<typename ExtReal>
+        void WriteWarmStart( ExtReal * restrict const record ) const
+        {
+            for( Int i = 0; i < AMB_DIM+1; ++i )
+            {
+                const bool usedQ = (i < simplex_size);
+                
+                record[(AMB_DIM+1) * i] = static_cast<ExtReal>( usedQ ? best_lambda[i] : zero );
+                
+                for( Int k = 0; k < AMB_DIM; ++k )
+                {
+                    record[(AMB_DIM+1) * i + 1 + k] = static_cast<ExtReal>( usedQ ? dirs[i][k] : zero );
+                }
+            }
+            
+            copy_buffer<AMB_DIM>( &v[0], &record[(AMB_DIM+1) * (AMB_DIM+1)] );
+        }
+        
+        // Sets the starting simplex for the next call to Compute with reuse_direction = true from a record of WriteWarmStart, usually from the previous time step of the same pair. If the record contains no vertices, only its v is used as starting direction; a record of zeroes gives a cold start.
+        template<typename ExtReal>
+        void ReadWarmStart( const ExtReal * restrict const record )
+        {
+            seed_size = 0;
+            
+            for( Int i = 0; i < AMB_DIM+1; ++i )
+            {
+                // Only vertices with positive barycentric coordinate are used. Their coordinates are recomputed for the new simplex.
+                if( record[(AMB_DIM+1) * i] > 0 )
+                {
+                    copy_buffer<AMB_DIM>( &record[(AMB_DIM+1) * i + 1], &dirs[seed_size][0] );
+                    
+                    ++seed_size;
+                }
+            }
+            
+            copy_buffer<AMB_DIM>( &record[(AMB_DIM+1) * (AMB_DIM+1)], &v[0] );
+        }
 
         Int SubCallCount() const
         {
             return sub_calls;
         }
+        
+        Int IterationCount() const
+        {
+            return iter;
+        }
+
+        GJK_SubAlgorithm SubAlgorithm() const
+        {
+            return sub_algorithm;
+        }
+
+        void SetSubAlgorithm( const GJK_SubAlgorithm sub_algorithm_ )
+        {
+            sub_algorithm = sub_algorithm_;
+        }
+
+        // Whether Compute actually uses the signed-volumes subalgorithm.
+        bool SignedVolumesQ() const
+        {
+            return ( (AMB_DIM == 2) || (AMB_DIM == 3) ) && (sub_algorithm == GJK_SubAlgorithm::SignedVolumes);
+        }
+
+        // Switches the Nesterov-accelerated variant of GJK on or off for the following calls to Compute; see the comment above GJK_Algorithm.
+        void SetAcceleration( const bool acceleratedQ_ )
+        {
+            acceleratedQ = acceleratedQ_;
+        }
+
+        bool AcceleratedQ() const
+        {
+            return acceleratedQ;
+        }
 
     protected:
         
@@ -196,6 +323,9 @@ namespace GJK
             
             // Computes Gram matrix Gram[i][i] = <coords[i] - coords[0], coords[j] - coords[0]>.
             // However, we do that in a convoluted way to save a few flops.
+            // The signed-volumes subalgorithm needs only the diagonal (for the test below).
+            
+            const bool off_diagonalQ = !SignedVolumesQ();
             
             for( Int i = 0; i < simplex_size; ++i )
             {
@@ -215,9 +345,12 @@ namespace GJK
                     return 1;
                 }
 
-                for( Int j = i+1; j < simplex_size; ++j )
+                if( off_diagonalQ )
                 {
-                    Gram[i][j] = dots[i][j] - dots[j][simplex_size] + R2;
+                    for( Int j = i+1; j < simplex_size; ++j )
+                    {
+                        Gram[i][j] = dots[i][j] - dots[j][simplex_size] + R2;
+                    }
                 }
             }
             
@@ -248,17 +381,26 @@ namespace GJK
             
         }
 
-        Int PrepareDistanceSubalgorithm()
+        // If keep_closestQ is true, the search starts with the current v as best candidate. After ShrinkToClosestFacet, v is the closest point of the simplex without its newest vertex, so the search over the faces that contain the newest vertex then amounts to a search over all faces.
+        Int PrepareDistanceSubalgorithm( const bool keep_closestQ = false )
         {
             GJK_tic(ClassName()+"::PrepareDistanceSubalgorithm");
 
             // Compute starting facet.
             Int facet = (static_cast<Int>(1) << simplex_size) - static_cast<Int>(1) ;
             
-            closest_facet = facet;
             olddotvv = dotvv;
             
-            dotvv = std::numeric_limits<Real>::max();
+            if( keep_closestQ )
+            {
+                // best_lambda and v still belong to this facet.
+                closest_facet = facet & ~(static_cast<Int>(1) << (simplex_size - 1));
+            }
+            else
+            {
+                closest_facet = facet;
+                dotvv = std::numeric_limits<Real>::max();
+            }
             
             // Mark subsimplices of `facet` that do not contain the last vertex of the simplex as visited before starting.
             // Facet itself is marked as unvisited; if `facet` is a reasonable starting facet, it _must_ be visited.
@@ -276,14 +418,12 @@ namespace GJK
             return facet;
         }
         
-        void HandlePoints(
-            const PrimitiveBase_T & P,
-            const PrimitiveBase_T & Q
-        )
+        template<typename P_T, typename Q_T>
+        void HandlePoints( cref<P_T> P, cref<Q_T> Q )
         {
             // In the case that both primitices are points, we have to take care that witnesses are computed correctly.
             simplex_size = 1;
-            best_lambda[1] = 1;
+            best_lambda[0] = 1;
             
             P.InteriorPoint(&P_supp[0][0]);
             Q.InteriorPoint(&Q_supp[0][0]);
@@ -293,12 +433,94 @@ namespace GJK
             for( Int k = 0; k < AMB_DIM; ++k )
             {
                 v[k] = P_supp[0][k] - Q_supp[0][k];
+                coords[0][k] = v[k];
                 dotvv += v[k] * v[k];
             }
             
             separatedQ = dotvv > zero;
         }
         
+        // Rebuilds the simplex from the first seed_count search directions in dirs (see ReadWarmStart).
+        // The support points are evaluated anew, so that the simplex is valid for the current positions of P and Q. Then its closest point is computed by a full search over its faces, so that Compute can continue as if it had built the simplex itself.
+        template<typename P_T, typename Q_T>
+        void Seed( cref<P_T> P, cref<Q_T> Q, const Int seed_count )
+        {
+            closest_facet = 1;
+            dotvv = std::numeric_limits<Real>::max();
+            
+            for( Int i = 0; i < seed_count; ++i )
+            {
+                const Int s = simplex_size;
+                
+                if( s != i )
+                {
+                    copy_buffer<AMB_DIM>( &dirs[i][0], &dirs[s][0] );
+                }
+                
+                P.MinSupportVector( &dirs[s][0], &P_supp[s][0] );
+                Q.MaxSupportVector( &dirs[s][0], &Q_supp[s][0] );
+                
+                if( Push() )
+                {
+                    // The vertex coincides with one found before.
+                    --simplex_size;
+                }
+                else if( !SignedVolumesQ() )
+                {
+                    // Johnson's subalgorithm searches only the faces that contain the newest vertex. Since we do not reset dotvv in between, searching after each vertex amounts to a search over all faces.
+                    const Int facet = (static_cast<Int>(1) << simplex_size) - static_cast<Int>(1);
+                    
+                    visited[facet] = false;
+                    
+                    for( Int j = 0; j < facet; ++j )
+                    {
+                        visited[j] = !bit(j,s);
+                    }
+                    
+                    DistanceSubalgorithm( facet );
+                }
+            }
+            
+            if( SignedVolumesQ() )
+            {
+                if( simplex_size == 1 )
+                {
+                    dotvv = dots[0][0];
+                    best_lambda[0] = one;
+                    copy_buffer<AMB_DIM>( &coords[0][0], &v[0] );
+                }
+                else
+                {
+                    SignedVolumes();
+                }
+            }
+            
+            ShrinkToClosestFacet();
+            
+            olddotvv = dotvv;
+        }
+        
+        // Deletes the vertices of the simplex that do not belong to closest_facet and moves the remaining ones to the beginning of the arrays.
+        void ShrinkToClosestFacet()
+        {
+            simplex_size = facets.sizes[closest_facet];
+            const Int * restrict const vertices = facets.vertices[closest_facet];
+            
+            for( Int i = 0; i < simplex_size; ++i )
+            {
+                const Int i_i = vertices[i];
+                
+                copy_buffer<AMB_DIM>( &coords[i_i][0], &coords[i][0] );
+                copy_buffer<AMB_DIM>( &Q_supp[i_i][0], &Q_supp[i][0] );
+                copy_buffer<AMB_DIM>( &dirs  [i_i][0], &dirs  [i][0] );
+
+                for( Int j = i; j < simplex_size; ++j )
+                {
+                    dots[i][j] = dots[i_i][vertices[j]];
+                }
+            }
+        }
+        
         // ################################################################
         // ###################   DistanceSubalgorithm   ###################
         // ################################################################
@@ -309,9 +531,9 @@ namespace GJK
             
             ++sub_calls;
             
-            const Int facet_size = facet_sizes[facet];
-            const Int * restrict const vertices = &facet_vertices[facet][0];
-            const Int * restrict const faces    = &facet_faces   [facet][0];
+            const Int facet_size = facets.sizes[facet];
+            const Int * restrict const vertices = &facets.vertices[facet][0];
+            const Int * restrict const faces    = &facets.faces   [facet][0];
             
             Real lambda [AMB_DIM+1] = {}; // The local contiguous version of Lambda for facets of size > 3.
 
@@ -537,128 +759,475 @@ namespace GJK
             GJK_toc(ClassName()+"::DistanceSubalgorithm");
         }
         
-    public:
-    
         // ################################################################
-        // ##########################  Compute  ###########################
+        // #######################   SignedVolumes   ######################
         // ################################################################
         
-        
-        // If collision_only is set to true, then we abort if at any time, we found a point x in P and a point y in  Q such that:
-        //
-        //   - if TOL_squared_ > 0: theta_squared_ * |x-y|^2 <= TOL_squared_
-        //
-        //   - if TOL_squared_ <=0:
-        //
-        //          - if P.SquaredRadius() and Q.SquaredRadius() are positive:
-        //
-        //                 theta_squared_ * |x-y|^2 <= eps_squared * min( P.SquaredRadius(), Q.SquaredRadius() )
-        //
-        //          - if any of P.SquaredRadius(), Q.SquaredRadius() is nonpositive:
-        //
-        //                 theta_squared_ * |x-y|^2 <= eps_squared * max( P.SquaredRadius(), Q.SquaredRadius() )
-        //
-        // For intersections of thickened objects use
-        //
-        //    theta_squared = 1 and
-        //
-        //    TOL_squared_  = (r_P + r_Q)^2, where r_P and r_Q are the thickening radii of P and Q.
-        //
-        // For multipole acceptance criteria use
-        //
-        //    theta_squared = chi * chi, where chi >= 0 is the separation parameter and
-        //
-        //    TOL_squared_  = max(r_P^2,r_Q^2), where r_P and r_Q are the radii of P and Q and
-        
-        void Compute(
-            const PrimitiveBase_T & P,
-            const PrimitiveBase_T & Q,
-            const bool collision_only  = false,
-            const bool reuse_direction = false,
-            const Real TOL_squared_    = zero,
-            const Real theta_squared_  = one
-        )
+        // Replacement for PrepareDistanceSubalgorithm + DistanceSubalgorithm; see GJK_SubAlgorithm::SignedVolumes.
+        // The helpers SV_* write the barycentric coordinates of the closest point to lambda, indexed by the vertices of the simplex, and return the bit mask of the face that contains it.
+        void SignedVolumes()
         {
-            GJK_tic(ClassName()+"::Compute");
-            
-            separatedQ = false;
+            GJK_tic(ClassName()+"::SignedVolumes");
             
-            Int iter = static_cast<Int>(0);
-
-            int in_simplex;
-
-            theta_squared = theta_squared_;
-
-            if( TOL_squared_ > zero )
-            {
-                TOL_squared = TOL_squared_;
-            }
-            else
+            if constexpr ( (AMB_DIM == 2) || (AMB_DIM == 3) )
             {
-                // Using a tolerance based on the radii of the primitives.
-                
-                GJK_print("Setting TOL_squared to "+ToString(eps)+" times minimum radius of primitives.");
-                TOL_squared = eps_squared * Min( P.SquaredRadius(), Q.SquaredRadius() );
-                if( TOL_squared <= zero )
+                olddotvv = dotvv;
+            
+                Real lambda [AMB_DIM+1] = {};
+            
+                Int facet = 1;
+            
+                if( simplex_size == 2 )
                 {
-                    // One of the primitives must be a point. Use the radius of the other one as tolerance.
-                    
-                    GJK_print("Setting TOL_squared to "+ToString(eps)+" times maximum radius of primitives.");
-                    TOL_squared = eps_squared * Max( P.SquaredRadius(), Q.SquaredRadius() );
-                    
-                    if( TOL_squared <= zero )
-                    {
-                        // Both primitives are points.
-                        
-                        HandlePoints(P,Q);
-                        
-                        GJK_toc(ClassName()+"::Compute");
-                        return;
-                    }
+                    facet = SV_Segment( 0, 1, &lambda[0] );
+                }
+                else if( simplex_size == 3 )
+                {
+                    facet = SV_Triangle( 0, 1, 2, &lambda[0] );
+                }
+                else if constexpr ( AMB_DIM == 3 )
+                {
+                    facet = SV_Tetrahedron( &lambda[0] );
                 }
-            }
             
-            GJK_DUMP(theta_squared);
-            GJK_DUMP(TOL_squared);
-
-            sub_calls = 0;
-            reason = GJK_Reason::NoReason;
-            simplex_size = 0;
+                const Int facet_size = facets.sizes[facet];
+                const Int * restrict const vertices = &facets.vertices[facet][0];
             
-            if( ! reuse_direction )
-            {
-                P.InteriorPoint(&v[0]);
-                Q.InteriorPoint(&Q_supp[0][0]);
-                
-                for( Int k = 0; k < AMB_DIM; ++k )
+                for( Int j = 0; j < facet_size; ++j )
                 {
-                    v[k] -= Q_supp[0][k];
+                    best_lambda[j] = lambda[vertices[j]];
                 }
-            }
-            
-            olddotvv = dotvv = dot_buffers<AMB_DIM>(v,v);
-
-            // Unrolling the first iteration to avoid a call to DistanceSubalgorithm.
             
-            // We use w = p-q, but do not define it explicitly.
-            Real a = P.MinSupportVector( &v[0], &P_supp[0][0] );
-            Real b = Q.MaxSupportVector( &v[0], &Q_supp[0][0] );
-            dotvw  = a-b;
+                closest_facet = facet;
             
-            Push();
+                dotvv = zero;
             
-            closest_facet = 1;
-            dotvv = dots[0][0];
-            best_lambda[0] = one;
-
-            copy_buffer<AMB_DIM>( &coords[0][0], v );
-        
-            while( true )
-            {
-                if( theta_squared * dotvv < TOL_squared )
+                for( Int k = 0; k < AMB_DIM; ++k )
                 {
-                    GJK_print("Stopped because theta_squared * dotvv < TOL_squared. ");
-                    reason = GJK_Reason::CollisionTolerance;
+                    Real x = best_lambda[0] * coords[ vertices[0] ][ k ];
+                
+                    for( Int j = 1; j < facet_size; ++j )
+                    {
+                        x += best_lambda[j] * coords[ vertices[j] ][ k ];
+                    }
+                
+                    dotvv += x * x;
+                    v[k] = x;
+                }
+            }
+            
+            GJK_toc(ClassName()+"::SignedVolumes");
+        }
+        
+        static bool SV_SameSignQ( const Real a, const Real b )
+        {
+            return ( (a > zero) && (b > zero) ) || ( (a < zero) && (b < zero) );
+        }
+        
+        // Squared norm of the point of face `facet` with barycentric coordinates lambda.
+        Real SV_SquaredNorm( const Int facet, cptr<Real> lambda ) const
+        {
+            const Int facet_size = facets.sizes[facet];
+            const Int * restrict const vertices = &facets.vertices[facet][0];
+            
+            Real r2 = zero;
+            
+            for( Int k = 0; k < AMB_DIM; ++k )
+            {
+                Real x = zero;
+                
+                for( Int j = 0; j < facet_size; ++j )
+                {
+                    x += lambda[vertices[j]] * coords[ vertices[j] ][ k ];
+                }
+                
+                r2 += x * x;
+            }
+            
+            return r2;
+        }
+        
+        Int SV_Segment( const Int i_0, const Int i_1, mptr<Real> lambda )
+        {
+            ++sub_calls;
+            
+            cptr<Real> a = &coords[i_0][0];
+            cptr<Real> b = &coords[i_1][0];
+            
+            Real t [AMB_DIM];
+            
+            for( Int k = 0; k < AMB_DIM; ++k )
+            {
+                t[k] = b[k] - a[k];
+            }
+            
+            const Real tt = dot_buffers<AMB_DIM>( &t[0], &t[0] );
+            
+            if( tt > zero )
+            {
+                // Measure along the axis in which the segment is longest.
+                Int I = 0;
+                
+                for( Int k = 1; k < AMB_DIM; ++k )
+                {
+                    if( Abs(t[k]) > Abs(t[I]) )
+                    {
+                        I = k;
+                    }
+                }
+                
+                // I-th coordinate of the projection of the origin onto the line.
+                const Real p_I = a[I] - dot_buffers<AMB_DIM>( a, &t[0] ) / tt * t[I];
+                
+                const Real mu  = a[I] - b[I];
+                const Real C_0 = p_I  - b[I];
+                const Real C_1 = a[I] - p_I;
+                
+                if( SV_SameSignQ( mu, C_0 ) && SV_SameSignQ( mu, C_1 ) )
+                {
+                    lambda[i_0] = C_0 / mu;
+                    lambda[i_1] = C_1 / mu;
+                    
+                    return (Int(1) << i_0) | (Int(1) << i_1);
+                }
+            }
+            
+            // The projection lies outside the segment (or the segment is degenerate); the closest point is the nearer endpoint.
+            const Int i = ( dots[i_0][i_0] <= dots[i_1][i_1] ) ? i_0 : i_1;
+            
+            lambda[i] = one;
+            
+            return Int(1) << i;
+        }
+        
+        Int SV_Triangle( const Int i_0, const Int i_1, const Int i_2, mptr<Real> lambda )
+        {
+            ++sub_calls;
+            
+            const Int i [3] = { i_0, i_1, i_2 };
+            
+            // Projection of the origin onto the plane of the triangle and the two coordinates in which the triangle is measured.
+            Real p [AMB_DIM] = {};
+            
+            Int x = 0;
+            Int y = 1;
+            
+            if constexpr ( AMB_DIM == 3 )
+            {
+                cptr<Real> a = &coords[i_0][0];
+                cptr<Real> b = &coords[i_1][0];
+                cptr<Real> c = &coords[i_2][0];
+                
+                const Real u [3] = { b[0] - a[0], b[1] - a[1], b[2] - a[2] };
+                const Real w [3] = { c[0] - a[0], c[1] - a[1], c[2] - a[2] };
+                
+                const Real n [3] = {
+                    u[1] * w[2] - u[2] * w[1],
+                    u[2] * w[0] - u[0] * w[2],
+                    u[0] * w[1] - u[1] * w[0]
+                };
+                
+                const Real nn = n[0] * n[0] + n[1] * n[1] + n[2] * n[2];
+                
+                if( nn > zero )
+                {
+                    const Real s = ( a[0] * n[0] + a[1] * n[1] + a[2] * n[2] ) / nn;
+                    
+                    for( Int k = 0; k < 3; ++k )
+                    {
+                        p[k] = s * n[k];
+                    }
+                }
+                
+                Int J = 0;
+                
+                for( Int k = 1; k < 3; ++k )
+                {
+                    if( Abs(n[k]) > Abs(n[J]) )
+                    {
+                        J = k;
+                    }
+                }
+                
+                x = (J + 1) % 3;
+                y = (J + 2) % 3;
+            }
+            
+            // Signed area of the triangle (q_0,q_1,q_2) in the coordinates x and y; vertex r is replaced by p (no replacement for r = 3).
+            auto area = [&]( const Int r )
+            {
+                cptr<Real> q_0 = (r == 0) ? &p[0] : &coords[i[0]][0];
+                cptr<Real> q_1 = (r == 1) ? &p[0] : &coords[i[1]][0];
+                cptr<Real> q_2 = (r == 2) ? &p[0] : &coords[i[2]][0];
+                
+                return (q_1[x] - q_0[x]) * (q_2[y] - q_0[y]) - (q_1[y] - q_0[y]) * (q_2[x] - q_0[x]);
+            };
+            
+            const Real nu = area(3);
+            
+            const Real C [3] = { area(0), area(1), area(2) };
+            
+            if( SV_SameSignQ( nu, C[0] ) && SV_SameSignQ( nu, C[1] ) && SV_SameSignQ( nu, C[2] ) )
+            {
+                for( Int j = 0; j < 3; ++j )
+                {
+                    lambda[i[j]] = C[j] / nu;
+                }
+                
+                return (Int(1) << i_0) | (Int(1) << i_1) | (Int(1) << i_2);
+            }
+            
+            // Search the edges opposite to the vertices with wrong sign.
+            Int  best_facet = 0;
+            Real best_r2    = std::numeric_limits<Real>::max();
+            
+            for( Int j = 0; j < 3; ++j )
+            {
+                if( !SV_SameSignQ( nu, C[j] ) )
+                {
+                    Real mu [AMB_DIM+1] = {};
+                    
+                    const Int facet = SV_Segment( i[(j + 1) % 3], i[(j + 2) % 3], &mu[0] );
+                    
+                    const Real r2 = SV_SquaredNorm( facet, &mu[0] );
+                    
+                    if( r2 < best_r2 )
+                    {
+                        best_facet = facet;
+                        best_r2    = r2;
+                        
+                        copy_buffer<AMB_DIM+1>( &mu[0], lambda );
+                    }
+                }
+            }
+            
+            return best_facet;
+        }
+        
+        Int SV_Tetrahedron( mptr<Real> lambda )
+        {
+            ++sub_calls;
+            
+            const Real o [AMB_DIM] = {};
+            
+            // Signed volume of the tetrahedron (coords[0],...,coords[3]) with vertex r replaced by the origin (no replacement for r = 4).
+            auto volume = [&]( const Int r )
+            {
+                cptr<Real> q_0 = (r == 0) ? &o[0] : &coords[0][0];
+                cptr<Real> q_1 = (r == 1) ? &o[0] : &coords[1][0];
+                cptr<Real> q_2 = (r == 2) ? &o[0] : &coords[2][0];
+                cptr<Real> q_3 = (r == 3) ? &o[0] : &coords[3][0];
+                
+                const Real u [3] = { q_1[0] - q_0[0], q_1[1] - q_0[1], q_1[2] - q_0[2] };
+                const Real w [3] = { q_2[0] - q_0[0], q_2[1] - q_0[1], q_2[2] - q_0[2] };
+                const Real z [3] = { q_3[0] - q_0[0], q_3[1] - q_0[1], q_3[2] - q_0[2] };
+                
+                return u[0] * (w[1] * z[2] - w[2] * z[1])
+                     + u[1] * (w[2] * z[0] - w[0] * z[2])
+                     + u[2] * (w[0] * z[1] - w[1] * z[0]);
+            };
+            
+            const Real det = volume(4);
+            
+            const Real C [4] = { volume(0), volume(1), volume(2), volume(3) };
+            
+            if( SV_SameSignQ( det, C[0] ) && SV_SameSignQ( det, C[1] ) && SV_SameSignQ( det, C[2] ) && SV_SameSignQ( det, C[3] ) )
+            {
+                for( Int j = 0; j < 4; ++j )
+                {
+                    lambda[j] = C[j] / det;
+                }
+                
+                return Int(15);
+            }
+            
+            // Search the triangles opposite to the vertices with wrong sign.
+            Int  best_facet = 0;
+            Real best_r2    = std::numeric_limits<Real>::max();
+            
+            for( Int j = 0; j < 4; ++j )
+            {
+                if( !SV_SameSignQ( det, C[j] ) )
+                {
+                    Real mu [AMB_DIM+1] = {};
+                    
+                    const Int facet = (j == 0) ? SV_Triangle( 1, 2, 3, &mu[0] )
+                                    : (j == 1) ? SV_Triangle( 0, 2, 3, &mu[0] )
+                                    : (j == 2) ? SV_Triangle( 0, 1, 3, &mu[0] )
+                                    :            SV_Triangle( 0, 1, 2, &mu[0] );
+                    
+                    const Real r2 = SV_SquaredNorm( facet, &mu[0] );
+                    
+                    if( r2 < best_r2 )
+                    {
+                        best_facet = facet;
+                        best_r2    = r2;
+                        
+                        copy_buffer<AMB_DIM+1>( &mu[0], lambda );
+                    }
+                }
+            }
+            
+            return best_facet;
+        }
+        
+    public:
+    
+        // ################################################################
+        // ##########################  Compute  ###########################
+        // ################################################################
+        
+        
+        // If collision_only is set to true, then we abort if at any time, we found a point x in P and a point y in  Q such that:
+        //
+        //   - if TOL_squared_ > 0: theta_squared_ * |x-y|^2 <= TOL_squared_
+        //
+        //   - if TOL_squared_ <=0:
+        //
+        //          - if P.SquaredRadius() and Q.SquaredRadius() are positive:
+        //
+        //                 theta_squared_ * |x-y|^2 <= eps_squared * min( P.SquaredRadius(), Q.SquaredRadius() )
+        //
+        //          - if any of P.SquaredRadius(), Q.SquaredRadius() is nonpositive:
+        //
+        //                 theta_squared_ * |x-y|^2 <= eps_squared * max( P.SquaredRadius(), Q.SquaredRadius() )
+        //
+        // For intersections of thickened objects use
+        //
+        //    theta_squared = 1 and
+        //
+        //    TOL_squared_  = (r_P + r_Q)^2, where r_P and r_Q are the thickening radii of P and Q.
+        //
+        // For multipole acceptance criteria use
+        //
+        //    theta_squared = chi * chi, where chi >= 0 is the separation parameter and
+        //
+        //    TOL_squared_  = max(r_P^2,r_Q^2), where r_P and r_Q are the radii of P and Q and
+        //
+        // Compute is templated on the primitive types. If P_T and Q_T are concrete classes (like Polytope), the compiler can devirtualize and inline the calls to MinSupportVector, MaxSupportVector, InteriorPoint, and SquaredRadius. Otherwise (e.g. for PrimitiveBase_T) we get the usual virtual dispatch.
+        
+        template<typename P_T, typename Q_T>
+        void Compute(
+            cref<P_T> P,
+            cref<Q_T> Q,
+            const bool collision_only  = false,
+            const bool reuse_direction = false,
+            const Real TOL_squared_    = zero,
+            const Real theta_squared_  = one
+        )
+        {
+            GJK_tic(ClassName()+"::Compute");
+            
+            // A simplex set by ReadWarmStart is used only once.
+            const Int seed_count = reuse_direction ? seed_size : static_cast<Int>(0);
+            
+            seed_size = 0;
+            
+            separatedQ = false;
+            
+            iter = static_cast<Int>(0);
+
+            int in_simplex;
+
+            theta_squared = theta_squared_;
+
+            if( TOL_squared_ > zero )
+            {
+                TOL_squared = TOL_squared_;
+            }
+            else
+            {
+                // Using a tolerance based on the radii of the primitives.
+                
+                GJK_print("Setting TOL_squared to "+ToString(eps)+" times minimum radius of primitives.");
+                TOL_squared = eps_squared * Min( P.SquaredRadius(), Q.SquaredRadius() );
+                if( TOL_squared <= zero )
+                {
+                    // One of the primitives must be a point. Use the radius of the other one as tolerance.
+                    
+                    GJK_print("Setting TOL_squared to "+ToString(eps)+" times maximum radius of primitives.");
+                    TOL_squared = eps_squared * Max( P.SquaredRadius(), Q.SquaredRadius() );
+                    
+                    if( TOL_squared <= zero )
+                    {
+                        // Both primitives are points.
+                        
+                        HandlePoints(P,Q);
+                        
+                        GJK_toc(ClassName()+"::Compute");
+                        return;
+                    }
+                }
+            }
+            
+            GJK_DUMP(theta_squared);
+            GJK_DUMP(TOL_squared);
+
+            sub_calls = 0;
+            reason = GJK_Reason::NoReason;
+            simplex_size = 0;
+            
+            if( seed_count > 0 )
+            {
+                Seed( P, Q, seed_count );
+            }
+            else
+            {
+                // A zero direction (e.g., from a previous call that found an intersection) is useless as starting direction.
+                if( !reuse_direction || (dot_buffers<AMB_DIM>(v,v) <= zero) )
+                {
+                    P.InteriorPoint(&v[0]);
+                    Q.InteriorPoint(&Q_supp[0][0]);
+                    
+                    for( Int k = 0; k < AMB_DIM; ++k )
+                    {
+                        v[k] -= Q_supp[0][k];
+                    }
+                }
+                
+                olddotvv = dotvv = dot_buffers<AMB_DIM>(v,v);
+                
+                // Unrolling the first iteration to avoid a call to DistanceSubalgorithm.
+                
+                // We use w = p-q, but do not define it explicitly.
+                const Real a = P.MinSupportVector( &v[0], &P_supp[0][0] );
+                const Real b = Q.MaxSupportVector( &v[0], &Q_supp[0][0] );
+                dotvw = a-b;
+                
+                best_lambda[0] = one;
+                
+                // The starting direction may already be a separating axis, in particular if it was reused from a previous call for the same pair. Since v is not a point of the simplex yet, the test is scaled by dotvv.
+                if( collision_only && (dotvw > zero) && (theta_squared * dotvw * dotvw > TOL_squared * dotvv) )
+                {
+                    GJK_print("Stopped because the starting direction is a separating axis. ");
+                    separatedQ = true;
+                    reason = GJK_Reason::Separated;
+                    
+                    GJK_toc(ClassName()+"::Compute");
+                    return;
+                }
+                
+                copy_buffer<AMB_DIM>( &v[0], &dirs[0][0] );
+                
+                Push();
+                
+                closest_facet = 1;
+                dotvv = dots[0][0];
+                
+                copy_buffer<AMB_DIM>( &coords[0][0], v );
+            }
+            
+            // State of the Nesterov acceleration; see the comment above GJK_Algorithm. momentum_iter == 0 means that the next iteration queries s(v).
+            Int  momentum_iter = 0;
+            Real restart_gap   = std::numeric_limits<Real>::max(); // duality gap of the last iteration without momentum
+            Real restart_dotvv = std::numeric_limits<Real>::max(); // dotvv at the last restart
+        
+            while( true )
+            {
+                if( theta_squared * dotvv < TOL_squared )
+                {
+                    GJK_print("Stopped because theta_squared * dotvv < TOL_squared. ");
+                    reason = GJK_Reason::CollisionTolerance;
                     break;
                 }
                 
@@ -679,12 +1248,84 @@ namespace GJK
                 
                 GJK_DUMP(iter);
                 
-                // We use w = p-q, but do not define it explicitly.
-                a = P.MinSupportVector( &v[0], &P_supp[simplex_size][0] );
-                b = Q.MaxSupportVector( &v[0], &Q_supp[simplex_size][0] );
-                dotvw = a-b;
-            
-                if( collision_only && (dotvw > zero) && (theta_squared * dotvw * dotvw > TOL_squared) )
+                // Whether this iteration queries the support functions in the momentum direction d instead of v.
+                bool nesterovQ = false;
+                Real dotdd     = dotvv;
+                
+                if( acceleratedQ && (momentum_iter > 0) )
+                {
+                    const Real delta = static_cast<Real>(momentum_iter + 1) / static_cast<Real>(momentum_iter + 3);
+                    
+                    for( Int k = 0; k < AMB_DIM; ++k )
+                    {
+                        y[k] = delta * v[k] + (one - delta) * w[k];
+                        d[k] = delta * d[k] + (one - delta) * y[k];
+                    }
+                    
+                    dotdd = dot_buffers<AMB_DIM>(d,d);
+                    
+                    // A vanishing d is useless as direction; we use v in that case.
+                    nesterovQ = (dotdd > zero);
+                }
+                
+                // <d,w> or <v,w>, depending on the query direction.
+                Real dotdw;
+                
+                while( true )
+                {
+                    // We use w = p-q, but do not define it explicitly (unless we need it for the momentum).
+                    cptr<Real> dir = nesterovQ ? &d[0] : &v[0];
+                    
+                    const Real a = P.MinSupportVector( dir, &P_supp[simplex_size][0] );
+                    const Real b = Q.MaxSupportVector( dir, &Q_supp[simplex_size][0] );
+                    
+                    dotdw = a-b;
+                    
+                    if( !nesterovQ )
+                    {
+                        dotvw = dotdw;
+                        break;
+                    }
+                    
+                    for( Int k = 0; k < AMB_DIM; ++k )
+                    {
+                        w[k] = P_supp[simplex_size][k] - Q_supp[simplex_size][k];
+                    }
+                    
+                    dotvw = dot_buffers<AMB_DIM>(v,w);
+                    
+                    // If s(d) is (almost) no descent point for v, we query s(v) instead, so that the iteration is not wasted. This also resets d to v below.
+                    if( dotvv - dotvw > eps * dotvv )
+                    {
+                        break;
+                    }
+                    
+                    nesterovQ = false;
+                }
+                
+                if( acceleratedQ )
+                {
+                    if( !nesterovQ )
+                    {
+                        for( Int k = 0; k < AMB_DIM; ++k )
+                        {
+                            w[k] = P_supp[simplex_size][k] - Q_supp[simplex_size][k];
+                        }
+                        
+                        copy_buffer<AMB_DIM>( &v[0], &d[0] );
+                        
+                        restart_dotvv = dotvv;
+                    }
+                    
+                    ++momentum_iter;
+                }
+                
+                // With momentum, d is rescaled to the length of v.
+                if( collision_only && (dotdw > zero) && ( nesterovQ
+                        ? (theta_squared * dotdw * dotdw * dotvv > TOL_squared * dotdd)
+                        : (theta_squared * dotdw * dotdw > TOL_squared)
+                    )
+                )
                 {
                     GJK_print("Stopped because separating plane was found. ");
                     separatedQ = true;
@@ -692,17 +1333,31 @@ namespace GJK
                     break;
                 }
                 
-                
-                if( Abs(dotvv - dotvw) <= eps * dotvv )
+                if( nesterovQ )
                 {
-                    GJK_print("Stopping because of abs(dotvv - dotvw) = "+ToString(Abs(dotvv - dotvw))+" <= "+ToString(eps * dotvv)+" = eps * dotvv.");
-                    GJK_DUMP(dotvv);
-                    GJK_DUMP(dotvw);
-                    GJK_DUMP(eps);
-                    reason = GJK_Reason::SmallResidual;
-                    break;
+                    // The gap |v|^2 - <v,s(d)> is only a lower bound for the duality gap of v. So we do not stop here, but we restart if it has not shrunk below the gap of the last iteration without momentum. We also restart when |v| has shrunk by a factor 4 since the last restart; otherwise the older (and longer) terms dominate d.
+                    if( (dotvv - dotvw >= restart_gap) || (static_cast<Real>(16) * dotvv < restart_dotvv) )
+                    {
+                        momentum_iter = 0;
+                    }
+                }
+                else
+                {
+                    restart_gap = dotvv - dotvw;
+                    
+                    if( Abs(dotvv - dotvw) <= eps * dotvv )
+                    {
+                        GJK_print("Stopping because of abs(dotvv - dotvw) = "+ToString(Abs(dotvv - dotvw))+" <= "+ToString(eps * dotvv)+" = eps * dotvv.");
+                        GJK_DUMP(dotvv);
+                        GJK_DUMP(dotvw);
+                        GJK_DUMP(eps);
+                        reason = GJK_Reason::SmallResidual;
+                        break;
+                    }
                 }
                 
+                copy_buffer<AMB_DIM>( nesterovQ ? &d[0] : &v[0], &dirs[simplex_size][0] );
+                
                 in_simplex = Push();
                 
                 if( in_simplex  )
@@ -712,33 +1367,34 @@ namespace GJK
                     // The vertex added most recently to the simplex coincides with one of the previous vertices.
                     // So we stop here and use the old best_lambda. All we have to do is to reduce the simplex_size by 1.
                     --simplex_size;
+                    
+                    if( nesterovQ )
+                    {
+                        // s(d) was not computed for v; so this does not show convergence.
+                        momentum_iter = 0;
+                        continue;
+                    }
+                    
                     reason = GJK_Reason::InSimplex;
                     break;
                 }
                 
-                Int initial_facet = PrepareDistanceSubalgorithm();
-                
-                // This computes closest_facet, v, and dotvv of the current simplex.
-                // If the simplex is degenerate, DistanceSubalgorithm terminates early and returns 1. Otherwise it returns 0.
-                DistanceSubalgorithm( initial_facet );
-                
-                simplex_size = facet_sizes[closest_facet];
-                const Int * restrict const vertices = facet_vertices[closest_facet];
-                
-                // Deleting superfluous vertices in simplex and writing everything to the beginning of the array.
-                
-                for( Int i = 0; i < simplex_size; ++i )
+                // This computes closest_facet, best_lambda, v, and dotvv of the current simplex.
+                if( SignedVolumesQ() )
                 {
-                    const Int i_i = vertices[i];
+                    SignedVolumes();
+                }
+                else
+                {
+                    // s(d) need not be a descent point for v, so then we have to search all faces.
+                    Int initial_facet = PrepareDistanceSubalgorithm( nesterovQ );
                     
-                    copy_buffer<AMB_DIM>( &coords[i_i][0], &coords[i][0] );
-                    copy_buffer<AMB_DIM>( &Q_supp[i_i][0], &Q_supp[i][0] );
-
-                    for( Int j = i; j < simplex_size; ++j )
-                    {
-                        dots[i][j] = dots[i_i][vertices[j]];
-                    }
+                    // If the simplex is degenerate, DistanceSubalgorithm terminates early and returns 1. Otherwise it returns 0.
+                    DistanceSubalgorithm( initial_facet );
                 }
+                
+                // Deleting superfluous vertices in simplex and writing everything to the beginning of the array.
+                ShrinkToClosestFacet();
 
                 GJK_DUMP(simplex_size);
                 GJK_DUMP(olddotvv - dotvv);
@@ -747,6 +1403,12 @@ namespace GJK
                 
                 if( Abs(olddotvv - dotvv) <= eps * dotvv )
                 {
+                    if( nesterovQ )
+                    {
+                        momentum_iter = 0;
+                        continue;
+                    }
+                    
                     reason = GJK_Reason::SmallProgress;
                     break;
                 }
@@ -806,6 +1468,8 @@ namespace GJK
         // #######################   IntersectingQ   ######################
         // ################################################################
         
+        // IntersectingQ, SquaredDistance, and MultipoleAcceptanceCriterion are deliberately not templated on the primitive types: a template would be a better match than the faster AABB overloads below for classes derived from AABB. Callers with statically typed primitives should use Compute directly.
+        
         bool IntersectingQ(
             const PrimitiveBase_T & P,
             const PrimitiveBase_T & Q,
@@ -895,9 +1559,10 @@ namespace GJK
         // ##############################   Witnesses   #############################
         // ##########################################################################
         
+        template<typename P_T, typename Q_T>
         Real Witnesses(
-            const PrimitiveBase_T & P, Real * restrict const x,
-            const PrimitiveBase_T & Q, Real * restrict const y,
+            cref<P_T> P, mptr<Real> x,
+            cref<Q_T> Q, mptr<Real> y,
             const bool reuse_direction_ = false
         )
         {
@@ -908,74 +1573,7 @@ namespace GJK
             
             Compute(P, Q, false, reuse_direction_, zero );
 
-            for( Int k = 0; k < AMB_DIM; ++k )
-            {
-                y[k] = best_lambda[0] * Q_supp[0][k];
-            }
-            
-            switch( simplex_size )
-            {
-                case 1:
-                {
-                    break;
-                }
-                case 2:
-                {
-                    for( Int k = 0; k < AMB_DIM; ++k )
-                    {
-                        y[k] += best_lambda[1] * Q_supp[1][k];
-                    }
-                    break;
-                }
-                case 3:
-                {
-                    for( Int j = 1; j < 3; ++j )
-                    {
-                        for( Int k = 0; k < AMB_DIM; ++k )
-                        {
-                            y[k] += best_lambda[j] * Q_supp[j][k];
-                        }
-                    }
-                    break;
-                }
-                case 4:
-                {
-                    for( Int j = 1; j < 4; ++j )
-                    {
-                        for( Int k = 0; k < AMB_DIM; ++k )
-                        {
-                            y[k] += best_lambda[j] * Q_supp[j][k];
-                        }
-                    }
-                    break;
-                }
-                case 5:
-                {
-                    for( Int j = 1; j < 5; ++j )
-                    {
-                        for( Int k = 0; k < AMB_DIM; ++k )
-                        {
-                            y[k] += best_lambda[j] * Q_supp[j][k];
-                        }
-                    }
-                    break;
-                }
-                default:
-                {
-                    for( Int j = 1; j < simplex_size; ++j )
-                    {
-                        for( Int k = 0; k < AMB_DIM; ++k )
-                        {
-                            y[k] += best_lambda[j] * Q_supp[j][k];
-                        }
-                    }
-                }
-            }
-            
-            for( Int k = 0; k < AMB_DIM; ++k )
-            {
-                x[k] = y[k] + v[k];
-            }
+            WriteWitnesses( x, y );
             
             return dotvv;
         } // Witnesses
@@ -984,9 +1582,10 @@ namespace GJK
         // ####################   Offset_IntersectingQ   ##################
         // ################################################################
         
+        template<typename P_T, typename Q_T>
         bool Offset_IntersectingQ(
-            const PrimitiveBase_T & P, const Real P_offset,
-            const PrimitiveBase_T & Q, const Real Q_offset,
+            cref<P_T> P, const Real P_offset,
+            cref<Q_T> Q, const Real Q_offset,
             const bool reuse_direction_ = false
         )
         {
@@ -1001,9 +1600,10 @@ namespace GJK
         // #################   Offset_SquaredDistance   ##################
         // ################################################################
         
+        template<typename P_T, typename Q_T>
         Real Offset_SquaredDistance(
-            const PrimitiveBase_T & P, const Real P_offset,
-            const PrimitiveBase_T & Q, const Real Q_offset,
+            cref<P_T> P, const Real P_offset,
+            cref<Q_T> Q, const Real Q_offset,
             const bool reuse_direction_ = false
         )
         {
@@ -1020,9 +1620,10 @@ namespace GJK
         // ###########################   Offset_Witnesses   #########################
         // ##########################################################################
         
+        template<typename P_T, typename Q_T>
         Real Offset_Witnesses(
-            const PrimitiveBase_T & P, const Real P_offset, Real * restrict const x,
-            const PrimitiveBase_T & Q, const Real Q_offset, Real * restrict const y,
+            cref<P_T> P, const Real P_offset, mptr<Real> x,
+            cref<Q_T> Q, const Real Q_offset, mptr<Real> y,
             const bool reuse_direction_ = false
         )
         {
@@ -1037,31 +1638,74 @@ namespace GJK
             
             Compute(P, Q, false, reuse_direction_, min_dist * min_dist );
             
+            return WriteOffsetWitnesses( P_offset, x, Q_offset, y );
+            
+        } // Offset_Witnesses
+        
+        // ##########################################################################
+        // ##########################   Witness output   ############################
+        // ##########################################################################
+        
+        // These read out the witnesses of the last call to Compute.
+        // They are meant for callers that call Compute directly with statically typed primitives.
+        
+        void WriteWitnesses( mptr<Real> x, mptr<Real> y ) const
+        {
+            WriteWitnesses( x, y, one, zero );
+        }
+        
+        Real WriteOffsetWitnesses(
+            const Real P_offset, mptr<Real> x,
+            const Real Q_offset, mptr<Real> y
+        ) const
+        {
             const Real dist0 = Sqrt(dotvv);
                   Real dist = dist0 - P_offset - Q_offset;
-                  Real x_scale;
-                  Real y_scale;
             
             if( dist > zero )
             {
                 // If no intersection was detected, we have to set the witnesses onto the bounday of the thickened primitives.
                 
-                // We want y = y_0 + y_scale * v, where y_0 is constructed from Q_supp by barycentric coordinates
-                y_scale =  Q_offset / dist0;
+                // We want y = y_0 + y_scale * v, where y_0 is constructed from Q_supp by barycentric coordinates.
                 // We want x = y + x_scale * v.
-                x_scale = (dist0 - P_offset - Q_offset) / dist0;
+                WriteWitnesses( x, y, (dist0 - P_offset - Q_offset) / dist0, Q_offset / dist0 );
             }
             else
             {
                 // If an intersection was deteced, we just return the witnesses.
                 dist = zero;
-                // We want y = y_0 + y_scale * v, where y_0 is constructed from Q_supp by barycentric coordinates
-                y_scale = zero;
-                // We want x = y + x_scale * v.
-                x_scale = one;
+                
+                WriteWitnesses( x, y, one, zero );
             }
-
-            // Compute y = best_lambda * Q_supp;
+            
+            return dist * dist;
+        }
+        
+        // Writes the support points in P and Q of the final simplex (matrices with at most AMB_DIM + 1 rows and AMB_DIM columns) and the barycentric coordinates of v with respect to it; returns the number of vertices. This is where EPA_Algorithm continues if the primitives intersect.
+        Int WriteSimplex( mptr<Real> P_vertices, mptr<Real> Q_vertices, mptr<Real> lambda ) const
+        {
+            for( Int i = 0; i < simplex_size; ++i )
+            {
+                for( Int k = 0; k < AMB_DIM; ++k )
+                {
+                    // P_supp is not kept in sync with the simplex, but coords and Q_supp are.
+                    P_vertices[AMB_DIM * i + k] = coords[i][k] + Q_supp[i][k];
+                    Q_vertices[AMB_DIM * i + k] = Q_supp[i][k];
+                }
+                
+                lambda[i] = best_lambda[i];
+            }
+            
+            return simplex_size;
+        }
+        
+    protected:
+        
+        void WriteWitnesses(
+            mptr<Real> x, mptr<Real> y, const Real x_scale, const Real y_scale
+        ) const
+        {
+            // Compute y = y_scale * v + best_lambda * Q_supp and x = y + x_scale * v;
             
             for( Int k = 0; k < AMB_DIM; ++k )
             {
@@ -1131,19 +1775,16 @@ namespace GJK
             {
                 x[k] = y[k] + x_scale * v[k];
             }
-            
-            return dist * dist;
-            
-        } // Offset_Witnesses
+        }
+        
+    public:
 
         // ########################################################################
         // ##################   InteriorPoints_SquaredDistance   ##################
         // ########################################################################
         
-        Real InteriorPoints_SquaredDistance(
-            const PrimitiveBase_T & P,
-            const PrimitiveBase_T & Q
-        )
+        template<typename P_T, typename Q_T>
+        Real InteriorPoints_SquaredDistance( cref<P_T> P, cref<Q_T> Q )
         {
             P.InteriorPoint( &coords[0][0] );
             Q.InteriorPoint( &coords[1][0] );
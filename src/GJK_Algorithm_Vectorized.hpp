@@ -0,0 +1,2136 @@
+#pragma once
+
+// GCC completely unrolls short loops over the lanes that are nested in other loops before it tries to vectorize them, and the unrolled code is hardly ever vectorized afterwards. We prevent that for the critical loops.
+#if defined(__GNUC__) && !defined(__clang__)
+    #define GJK_LANE_LOOP _Pragma("GCC unroll 1")
+#else
+    #define GJK_LANE_LOOP
+#endif
+
+namespace GJK
+{
+    // Number of lanes used by the batch routines.
+    //
+    // With AVX-512, we use as many lanes as fit into two SIMD registers; the two independent halves hide much of the latency of the short dependency chains in each step.
+    // Without AVX-512, there are no mask registers, and the blends in the lockstep loop are about as expensive as the scalar algorithm itself. So we return 1, which makes the batch routines fall back to GJK_Algorithm.
+    // Define GJK_LANE_COUNT to override this (e.g., 8 for AVX2 with double precision).
+    template<typename Real>
+    constexpr int GJK_DefaultLaneCount()
+    {
+#if defined(GJK_LANE_COUNT)
+        return GJK_LANE_COUNT;
+#elif defined(__AVX512F__)
+        return 128 / static_cast<int>(sizeof(Real));
+#else
+        return 1;
+#endif
+    }
+
+    // Integer type of the same width as Real. We use it for all per-lane flags and indices; mixing them with Real in the loops over the lanes would otherwise prevent vectorization.
+    template<typename Real>
+    using GJK_LaneInt = std::conditional_t<sizeof(Real) == 8, std::int64_t, std::int32_t>;
+
+    // ################################################################
+    // ########################  SupportLanes  ########################
+    // ################################################################
+
+    // Holds one primitive view per lane and evaluates the support functions for all lanes at once.
+    //
+    // The generic version simply calls the support functions of the views one lane after the other. Specializations for primitives with a known number of points (see Polytope, PolytopeSoA, and IndexedPolytope below) keep a lane-major copy of the points so that the support functions are vectorized across the lanes, too.
+    //
+    // Usage: Point the view operator[](lane) to the lane's primitive with SetPointer and call GJK_Algorithm_Vectorized::Load afterwards; Load calls the member Load(lane) below.
+
+    template<typename Primitive_T, int LANE_COUNT>
+    class SupportLanes
+    {
+    public:
+
+        using Real = typename Primitive_T::Real;
+        using Int  = typename Primitive_T::Int;
+
+        static constexpr Int AMB_DIM = Primitive_T::AmbDim();
+
+    protected:
+
+        std::array<std::shared_ptr<Primitive_T>,LANE_COUNT> views;
+
+    public:
+
+        explicit SupportLanes( cref<Primitive_T> prototype )
+        {
+            for( Int l = 0; l < LANE_COUNT; ++l )
+            {
+                views[l] = prototype.Clone();
+            }
+        }
+
+        Primitive_T & operator[]( const Int lane )
+        {
+            return *views[lane];
+        }
+
+        const Primitive_T & operator[]( const Int lane ) const
+        {
+            return *views[lane];
+        }
+
+        void Load( const Int lane )
+        {
+            (void)lane;
+        }
+
+        // dir and supp are arrays of size AMB_DIM x LANE_COUNT; values is an array of size LANE_COUNT. Only the lanes with mask[l] == true are evaluated.
+
+        void MinSupportVectors( cptr<GJK_LaneInt<Real>> mask, cptr<Real> dir, mptr<Real> supp, mptr<Real> values ) const
+        {
+            for( Int l = 0; l < LANE_COUNT; ++l )
+            {
+                if( mask[l] )
+                {
+                    Real d [AMB_DIM];
+                    Real s [AMB_DIM];
+
+                    for( Int k = 0; k < AMB_DIM; ++k )
+                    {
+                        d[k] = dir[LANE_COUNT * k + l];
+                    }
+
+                    values[l] = views[l]->MinSupportVector( &d[0], &s[0] );
+
+                    for( Int k = 0; k < AMB_DIM; ++k )
+                    {
+                        supp[LANE_COUNT * k + l] = s[k];
+                    }
+                }
+            }
+        }
+
+        void MaxSupportVectors( cptr<GJK_LaneInt<Real>> mask, cptr<Real> dir, mptr<Real> supp, mptr<Real> values ) const
+        {
+            for( Int l = 0; l < LANE_COUNT; ++l )
+            {
+                if( mask[l] )
+                {
+                    Real d [AMB_DIM];
+                    Real s [AMB_DIM];
+
+                    for( Int k = 0; k < AMB_DIM; ++k )
+                    {
+                        d[k] = dir[LANE_COUNT * k + l];
+                    }
+
+                    values[l] = views[l]->MaxSupportVector( &d[0], &s[0] );
+
+                    for( Int k = 0; k < AMB_DIM; ++k )
+                    {
+                        supp[LANE_COUNT * k + l] = s[k];
+                    }
+                }
+            }
+        }
+
+    }; // SupportLanes
+
+
+    // Lane-major copy of the points of LANE_COUNT polytopes with POINT_COUNT points each, so that the support functions are vectorized across the lanes. Common base of the specializations of SupportLanes for Polytope and PolytopeSoA below; they differ only in how Load reads the points.
+
+    template<int POINT_COUNT, int AMB_DIM_, typename Real_, typename Int_, int LANE_COUNT>
+    class PolytopeSupportLanes
+    {
+    public:
+
+        using Real = Real_;
+        using Int  = Int_;
+
+        static constexpr Int AMB_DIM = AMB_DIM_;
+
+    protected:
+
+        alignas(ObjectAlignment) Real coords [POINT_COUNT][AMB_DIM][LANE_COUNT] = {};
+
+    public:
+
+        // All lanes are evaluated, regardless of mask; this is cheaper than branching.
+
+        void MinSupportVectors( cptr<GJK_LaneInt<Real>> mask, cptr<Real> dir, mptr<Real> supp, mptr<Real> values ) const
+        {
+            (void)mask;
+
+            SupportVectors<false>( dir, supp, values );
+        }
+
+        void MaxSupportVectors( cptr<GJK_LaneInt<Real>> mask, cptr<Real> dir, mptr<Real> supp, mptr<Real> values ) const
+        {
+            (void)mask;
+
+            SupportVectors<true>( dir, supp, values );
+        }
+
+    protected:
+
+        template<bool maxQ>
+        void SupportVectors( cptr<Real> dir, mptr<Real> supp, mptr<Real> values ) const
+        {
+            // The support points are blended in local buffers; branching on the comparisons would be unpredictable.
+            alignas(ObjectAlignment) Real best  [LANE_COUNT];
+            alignas(ObjectAlignment) Real value [LANE_COUNT];
+            alignas(ObjectAlignment) Real x     [AMB_DIM][LANE_COUNT];
+
+            GJK_LANE_LOOP
+            for( Int l = 0; l < LANE_COUNT; ++l )
+            {
+                best[l] = coords[0][0][l] * dir[l];
+            }
+
+            for( Int k = 1; k < AMB_DIM; ++k )
+            {
+                GJK_LANE_LOOP
+                for( Int l = 0; l < LANE_COUNT; ++l )
+                {
+                    best[l] += coords[0][k][l] * dir[LANE_COUNT * k + l];
+                }
+            }
+
+            for( Int k = 0; k < AMB_DIM; ++k )
+            {
+                GJK_LANE_LOOP
+                for( Int l = 0; l < LANE_COUNT; ++l )
+                {
+                    x[k][l] = coords[0][k][l];
+                }
+            }
+
+            for( Int j = 1; j < POINT_COUNT; ++j )
+            {
+                GJK_LANE_LOOP
+                for( Int l = 0; l < LANE_COUNT; ++l )
+                {
+                    value[l] = coords[j][0][l] * dir[l];
+                }
+
+                for( Int k = 1; k < AMB_DIM; ++k )
+                {
+                    GJK_LANE_LOOP
+                    for( Int l = 0; l < LANE_COUNT; ++l )
+                    {
+                        value[l] += coords[j][k][l] * dir[LANE_COUNT * k + l];
+                    }
+                }
+
+                for( Int k = 0; k < AMB_DIM; ++k )
+                {
+                    GJK_LANE_LOOP
+                    for( Int l = 0; l < LANE_COUNT; ++l )
+                    {
+                        const Real x_new = coords[j][k][l];
+                        const Real x_old = x[k][l];
+
+                        x[k][l] = ( maxQ ? (value[l] > best[l]) : (value[l] < best[l]) ) ? x_new : x_old;
+                    }
+                }
+
+                GJK_LANE_LOOP
+                for( Int l = 0; l < LANE_COUNT; ++l )
+                {
+                    best[l] = maxQ ? Max(value[l],best[l]) : Min(value[l],best[l]);
+                }
+            }
+
+            copy_buffer<AMB_DIM * LANE_COUNT>( &x[0][0], supp );
+            copy_buffer<LANE_COUNT>( &best[0], values );
+        }
+
+    }; // PolytopeSupportLanes
+
+
+    template<int POINT_COUNT, int AMB_DIM_, typename Real_, typename Int_, typename SReal, typename ExtReal, typename ExtInt, int LANE_COUNT>
+    class SupportLanes<Polytope<POINT_COUNT,AMB_DIM_,Real_,Int_,SReal,ExtReal,ExtInt>,LANE_COUNT>
+    :   public PolytopeSupportLanes<POINT_COUNT,AMB_DIM_,Real_,Int_,LANE_COUNT>
+    {
+    public:
+
+        using Primitive_T = Polytope<POINT_COUNT,AMB_DIM_,Real_,Int_,SReal,ExtReal,ExtInt>;
+
+        using Real = Real_;
+        using Int  = Int_;
+
+        static constexpr Int AMB_DIM = AMB_DIM_;
+
+    protected:
+
+        using PolytopeSupportLanes<POINT_COUNT,AMB_DIM_,Real_,Int_,LANE_COUNT>::coords;
+
+        std::array<std::shared_ptr<Primitive_T>,LANE_COUNT> views;
+
+    public:
+
+        explicit SupportLanes( cref<Primitive_T> prototype )
+        {
+            for( Int l = 0; l < LANE_COUNT; ++l )
+            {
+                views[l] = prototype.Clone();
+            }
+        }
+
+        Primitive_T & operator[]( const Int lane )
+        {
+            return *views[lane];
+        }
+
+        const Primitive_T & operator[]( const Int lane ) const
+        {
+            return *views[lane];
+        }
+
+        void Load( const Int lane )
+        {
+            cptr<SReal> A = &views[lane]->serialized_data[1 + AMB_DIM];
+
+            for( Int j = 0; j < POINT_COUNT; ++j )
+            {
+                for( Int k = 0; k < AMB_DIM; ++k )
+                {
+                    coords[j][k][lane] = static_cast<Real>(A[AMB_DIM * j + k]);
+                }
+            }
+        }
+
+    }; // SupportLanes
+
+
+    template<int POINT_COUNT, int AMB_DIM_, typename Real_, typename Int_, typename SReal, typename ExtReal, typename ExtInt, int LANE_COUNT>
+    class SupportLanes<PolytopeSoA<POINT_COUNT,AMB_DIM_,Real_,Int_,SReal,ExtReal,ExtInt>,LANE_COUNT>
+    :   public PolytopeSupportLanes<POINT_COUNT,AMB_DIM_,Real_,Int_,LANE_COUNT>
+    {
+    public:
+
+        using Primitive_T = PolytopeSoA<POINT_COUNT,AMB_DIM_,Real_,Int_,SReal,ExtReal,ExtInt>;
+
+        using Real = Real_;
+        using Int  = Int_;
+
+        static constexpr Int AMB_DIM = AMB_DIM_;
+
+    protected:
+
+        using PolytopeSupportLanes<POINT_COUNT,AMB_DIM_,Real_,Int_,LANE_COUNT>::coords;
+
+        // PolytopeSoA is a plain view without virtual functions, so we simply keep copies of the prototype (which carry the stride).
+        std::array<Primitive_T,LANE_COUNT> views;
+
+    public:
+
+        explicit SupportLanes( cref<Primitive_T> prototype )
+        {
+            views.fill( prototype );
+        }
+
+        Primitive_T & operator[]( const Int lane )
+        {
+            return views[lane];
+        }
+
+        const Primitive_T & operator[]( const Int lane ) const
+        {
+            return views[lane];
+        }
+
+        void Load( const Int lane )
+        {
+            for( Int j = 0; j < POINT_COUNT; ++j )
+            {
+                for( Int k = 0; k < AMB_DIM; ++k )
+                {
+                    coords[j][k][lane] = views[lane].Coordinate(j,k);
+                }
+            }
+        }
+
+    }; // SupportLanes
+
+
+    // The points are gathered from the shared vertex buffer once per pair, in Load.
+    template<int POINT_COUNT, int AMB_DIM_, typename Real_, typename Int_, typename SReal, typename ExtInt, int LANE_COUNT>
+    class SupportLanes<IndexedPolytope<POINT_COUNT,AMB_DIM_,Real_,Int_,SReal,ExtInt>,LANE_COUNT>
+    :   public PolytopeSupportLanes<POINT_COUNT,AMB_DIM_,Real_,Int_,LANE_COUNT>
+    {
+    public:
+
+        using Primitive_T = IndexedPolytope<POINT_COUNT,AMB_DIM_,Real_,Int_,SReal,ExtInt>;
+
+        using Real = Real_;
+        using Int  = Int_;
+
+        static constexpr Int AMB_DIM = AMB_DIM_;
+
+    protected:
+
+        using PolytopeSupportLanes<POINT_COUNT,AMB_DIM_,Real_,Int_,LANE_COUNT>::coords;
+
+        std::array<std::shared_ptr<Primitive_T>,LANE_COUNT> views;
+
+    public:
+
+        explicit SupportLanes( cref<Primitive_T> prototype )
+        {
+            for( Int l = 0; l < LANE_COUNT; ++l )
+            {
+                views[l] = prototype.Clone();
+            }
+        }
+
+        Primitive_T & operator[]( const Int lane )
+        {
+            return *views[lane];
+        }
+
+        const Primitive_T & operator[]( const Int lane ) const
+        {
+            return *views[lane];
+        }
+
+        void Load( const Int lane )
+        {
+            for( Int j = 0; j < POINT_COUNT; ++j )
+            {
+                cptr<SReal> x = views[lane]->Vertex(j);
+
+                for( Int k = 0; k < AMB_DIM; ++k )
+                {
+                    coords[j][k][lane] = static_cast<Real>(x[k]);
+                }
+            }
+        }
+
+    }; // SupportLanes
+
+
+    // Runs the GJK loop on LANE_COUNT primitive pairs in lockstep.
+    //
+    // All per-pair data is stored with the lane index innermost, so that the loops over lanes in Step can be vectorized by the compiler. We do not use intrinsics; instead, all per-lane decisions are made with integer masks of the same width as Real and with selects, so that the loops are free of branches.
+    //
+    // Differences to GJK_Algorithm:
+    //
+    //   - The simplex is stored in AMB_DIM+1 fixed slots together with a per-lane bit mask of occupied slots. Vertices that are dropped by the distance subalgorithm are simply removed from the mask, so no compaction is necessary.
+    //
+    //   - The distance subalgorithm does not walk the faces recursively. Instead, the faces are solved in lockstep for all lanes, and per lane the closest valid one that contains the newest vertex is selected with masks. This gives the same closest point as Johnson's algorithm. With GJK_SubAlgorithm::SignedVolumes, the barycentric coordinates of the faces are signed volumes instead (see SignedVolumeDeltas); Seed uses Johnson's determinants in either case.
+    //
+    //   - Lanes terminate individually. Process refills finished lanes with new pairs, so that a single slow pair does not keep the other lanes idle.
+    //
+    //   - With SetAcceleration(true), each lane runs the accelerated variant described above GJK_Algorithm. For lanes that query s(d), the old v competes in the face selection, so that all faces are searched. A lane whose s(d) is already in the simplex skips the rest of the step (it is "paused") and queries s(v) in the next one.
+
+    template<int LANE_COUNT, int AMB_DIM, typename Real_, typename Int_>
+    class alignas(ObjectAlignment) GJK_Algorithm_Vectorized
+    {
+        ASSERT_FLOAT(Real_);
+        ASSERT_INT  (Int_ );
+
+        static_assert( LANE_COUNT > 0, "GJK_Algorithm_Vectorized: LANE_COUNT must be positive." );
+
+    public:
+
+        using Int  = Int_;
+        using Real = Real_;
+
+        using LaneInt = GJK_LaneInt<Real>;
+
+        static constexpr Real eps = cSqrt(std::numeric_limits<Real>::epsilon());
+        static constexpr Real eps_squared = eps * eps;
+        static constexpr Int max_iter = 100;
+
+    protected:
+
+        static constexpr Int SLOT_COUNT = AMB_DIM + 1;
+        static constexpr Int FACE_COUNT = face_count(AMB_DIM);
+        static constexpr Int FULL_MASK  = FACE_COUNT - 1;
+        static constexpr Real zero      = Scalar::Zero<Real>;
+        static constexpr Real one       = Scalar::One <Real>;
+
+        static constexpr GJK_FacetTable<AMB_DIM,Int> facets {};
+
+        alignas(ObjectAlignment) Real coords [SLOT_COUNT][AMB_DIM   ][LANE_COUNT] = {}; // simplex vertices w = p - q
+        alignas(ObjectAlignment) Real Q_supp [SLOT_COUNT][AMB_DIM   ][LANE_COUNT] = {}; // support points in Q belonging to the vertices
+        alignas(ObjectAlignment) Real dirs   [SLOT_COUNT][AMB_DIM   ][LANE_COUNT] = {}; // search directions in which the vertices were found (for warm starts)
+        alignas(ObjectAlignment) Real dots   [SLOT_COUNT][SLOT_COUNT][LANE_COUNT] = {}; // dot products of the simplex vertices
+        alignas(ObjectAlignment) Real w      [AMB_DIM][LANE_COUNT] = {};                // most recent support point
+        alignas(ObjectAlignment) Real v      [AMB_DIM][LANE_COUNT] = {};                // current closest point
+        alignas(ObjectAlignment) Real best_lambda [SLOT_COUNT][LANE_COUNT] = {};        // barycentric coordinates of v; 0 for unoccupied slots
+        alignas(ObjectAlignment) Real momentum_dir [AMB_DIM][LANE_COUNT] = {};          // momentum direction d; only used with acceleration
+
+        // Scratch space for the distance subalgorithm.
+        alignas(ObjectAlignment) Real delta    [FACE_COUNT][SLOT_COUNT][LANE_COUNT] = {}; // Johnson's determinants Delta_i(face)
+        alignas(ObjectAlignment) Real best_delta [SLOT_COUNT][LANE_COUNT] = {};           // Deltas of the closest face found so far
+        alignas(ObjectAlignment) Real best_num [LANE_COUNT] = {};
+        alignas(ObjectAlignment) Real best_den [LANE_COUNT] = {};
+
+        alignas(ObjectAlignment) Real dotvv         [LANE_COUNT] = {};
+        alignas(ObjectAlignment) Real olddotvv      [LANE_COUNT] = {};
+        alignas(ObjectAlignment) Real dotvw         [LANE_COUNT] = {};
+        alignas(ObjectAlignment) Real TOL_squared   [LANE_COUNT] = {};
+        alignas(ObjectAlignment) Real theta_squared [LANE_COUNT] = {};
+        alignas(ObjectAlignment) Real restart_gap   [LANE_COUNT] = {}; // duality gap of the last step without momentum; only used with acceleration
+        alignas(ObjectAlignment) Real restart_dotvv [LANE_COUNT] = {}; // dotvv at the last restart of the momentum; only used with acceleration
+
+        LaneInt occupied       [LANE_COUNT] = {}; // bit mask of occupied slots
+        LaneInt new_bit        [LANE_COUNT] = {}; // bit mask of the slot of the most recent support point
+        LaneInt new_face       [LANE_COUNT] = {}; // bit mask of the closest face found so far
+        LaneInt iter           [LANE_COUNT] = {};
+        LaneInt active         [LANE_COUNT] = {};
+        LaneInt collision_only [LANE_COUNT] = {};
+        LaneInt separatedQ     [LANE_COUNT] = {};
+        LaneInt reason         [LANE_COUNT] = {}; // GJK_Reason; stored as LaneInt to keep the masks and the reals of the same width
+        LaneInt momentum_iter  [LANE_COUNT] = {}; // steps since the last restart of the momentum; 0 means that the next step queries s(v)
+
+        Int sub_calls = 0;
+
+        GJK_SubAlgorithm sub_algorithm = GJK_SubAlgorithm::Johnson;
+
+        bool acceleratedQ = false;
+
+    public:
+
+        GJK_Algorithm_Vectorized() = default;
+
+        explicit GJK_Algorithm_Vectorized( const GJK_SubAlgorithm sub_algorithm_ )
+        :   sub_algorithm ( sub_algorithm_ )
+        {}
+
+        ~GJK_Algorithm_Vectorized() = default;
+
+        static constexpr Int AmbDim()
+        {
+            return AMB_DIM;
+        }
+
+        static constexpr Int LaneCount()
+        {
+            return LANE_COUNT;
+        }
+
+        GJK_SubAlgorithm SubAlgorithm() const
+        {
+            return sub_algorithm;
+        }
+
+        void SetSubAlgorithm( const GJK_SubAlgorithm sub_algorithm_ )
+        {
+            sub_algorithm = sub_algorithm_;
+        }
+
+        // Same as GJK_Algorithm::SignedVolumesQ.
+        bool SignedVolumesQ() const
+        {
+            return ( (AMB_DIM == 2) || (AMB_DIM == 3) ) && (sub_algorithm == GJK_SubAlgorithm::SignedVolumes);
+        }
+
+        // See GJK_Algorithm::SetAcceleration.
+        void SetAcceleration( const bool acceleratedQ_ )
+        {
+            acceleratedQ = acceleratedQ_;
+        }
+
+        bool AcceleratedQ() const
+        {
+            return acceleratedQ;
+        }
+
+        bool ActiveQ( const Int lane ) const
+        {
+            return active[lane];
+        }
+
+        bool SeparatedQ( const Int lane ) const
+        {
+            return separatedQ[lane];
+        }
+
+        Real LeastSquaredDistance( const Int lane ) const
+        {
+            return dotvv[lane];
+        }
+
+        GJK_Reason Reason( const Int lane ) const
+        {
+            return static_cast<GJK_Reason>(reason[lane]);
+        }
+
+        Int IterationCount( const Int lane ) const
+        {
+            return static_cast<Int>(iter[lane]);
+        }
+
+        Int SubCallCount() const
+        {
+            return sub_calls;
+        }
+
+        // Same as GJK_Algorithm::WarmStartSize.
+        static constexpr Int WarmStartSize()
+        {
+            return SLOT_COUNT * SLOT_COUNT + AMB_DIM;
+        }
+
+    protected:
+
+        static constexpr LaneInt bit( const LaneInt n, const LaneInt k )
+        {
+            return ( (n >> k) & static_cast<LaneInt>(1) );
+        }
+
+    public:
+
+        // ################################################################
+        // ############################  Load  ############################
+        // ################################################################
+
+        // Initializes lane `lane` with the primitives P[lane] and Q[lane]. The remaining parameters have the same meaning as for GJK_Algorithm::Compute.
+        // If warm_start is not a null pointer, it has to be a record of WriteWarmStart, usually from a previous call for the same pair. Its simplex is evaluated anew right here (see GJK_Algorithm::ReadWarmStart); if it has no vertices, only its v is used as starting direction, unless it is zero.
+        // Otherwise, only the starting direction is computed here; the first GJK iteration is carried out by the next call to Step, together with the other lanes.
+
+        template<typename P_Lanes_T, typename Q_Lanes_T>
+        void Load(
+            const Int lane,
+            P_Lanes_T & P_lanes,
+            Q_Lanes_T & Q_lanes,
+            const bool collision_only_ = false,
+            const Real TOL_squared_    = zero,
+            const Real theta_squared_  = one,
+            cptr<Real> warm_start      = nullptr
+        )
+        {
+            const Int l = lane;
+
+            P_lanes.Load(l);
+            Q_lanes.Load(l);
+
+            const auto & P = P_lanes[l];
+            const auto & Q = Q_lanes[l];
+
+            Real p [AMB_DIM];
+            Real q [AMB_DIM];
+
+            separatedQ    [l] = false;
+            collision_only[l] = collision_only_;
+            theta_squared [l] = theta_squared_;
+            reason        [l] = ReasonCode(GJK_Reason::NoReason);
+            iter          [l] = 0;
+            momentum_iter [l] = 0;
+            restart_gap   [l] = std::numeric_limits<Real>::max();
+            restart_dotvv [l] = std::numeric_limits<Real>::max();
+
+            bool pointsQ = false;
+
+            if( TOL_squared_ > zero )
+            {
+                TOL_squared[l] = TOL_squared_;
+            }
+            else
+            {
+                // Using a tolerance based on the radii of the primitives.
+                TOL_squared[l] = eps_squared * Min( P.SquaredRadius(), Q.SquaredRadius() );
+
+                if( TOL_squared[l] <= zero )
+                {
+                    // One of the primitives must be a point. Use the radius of the other one as tolerance.
+                    TOL_squared[l] = eps_squared * Max( P.SquaredRadius(), Q.SquaredRadius() );
+
+                    // Both primitives are points.
+                    pointsQ = (TOL_squared[l] <= zero);
+                }
+            }
+
+            P.InteriorPoint( &p[0] );
+            Q.InteriorPoint( &q[0] );
+
+            Real r2 = zero;
+
+            for( Int k = 0; k < AMB_DIM; ++k )
+            {
+                v[k][l] = p[k] - q[k];
+                r2 += v[k][l] * v[k][l];
+            }
+
+            if( (warm_start != nullptr) && !pointsQ )
+            {
+                cptr<Real> direction = &warm_start[SLOT_COUNT * SLOT_COUNT];
+
+                Real d2 = zero;
+
+                for( Int k = 0; k < AMB_DIM; ++k )
+                {
+                    d2 += direction[k] * direction[k];
+                }
+
+                if( d2 > zero )
+                {
+                    for( Int k = 0; k < AMB_DIM; ++k )
+                    {
+                        v[k][l] = direction[k];
+                    }
+
+                    r2 = d2;
+                }
+            }
+
+            dotvv[l] = r2;
+
+            if( pointsQ )
+            {
+                // Same as GJK_Algorithm::HandlePoints.
+                for( Int s = 0; s < SLOT_COUNT; ++s )
+                {
+                    best_lambda[s][l] = zero;
+                }
+
+                for( Int k = 0; k < AMB_DIM; ++k )
+                {
+                    Q_supp[0][k][l] = q[k];
+                    coords[0][k][l] = v[k][l];
+                }
+
+                occupied   [l] = 1;
+                best_lambda[0][l] = one;
+                dots[0][0] [l] = r2;
+                separatedQ [l] = r2 > zero;
+                active     [l] = false;
+            }
+            else
+            {
+                // An empty simplex tells Step that this lane is fresh.
+                occupied[l] = 0;
+                active  [l] = true;
+
+                if( warm_start != nullptr )
+                {
+                    Seed( l, P, Q, warm_start );
+                }
+            }
+        }
+
+    protected:
+
+        // Same as GJK_Algorithm::Seed, but for lane l and reading the search directions from a record of WriteWarmStart. Afterwards the lane is not fresh anymore, so the next call to Step treats it like any other lane.
+        template<typename P_T, typename Q_T>
+        void Seed( const Int l, cref<P_T> P, cref<Q_T> Q, cptr<Real> record )
+        {
+            Real p [AMB_DIM];
+            Real q [AMB_DIM];
+
+            Int size = 0;
+
+            for( Int i = 0; i < SLOT_COUNT; ++i )
+            {
+                if( record[SLOT_COUNT * i] <= zero )
+                {
+                    continue;
+                }
+
+                cptr<Real> dir = &record[SLOT_COUNT * i + 1];
+
+                P.MinSupportVector( dir, &p[0] );
+                Q.MaxSupportVector( dir, &q[0] );
+
+                const Int s = size;
+
+                for( Int k = 0; k < AMB_DIM; ++k )
+                {
+                    coords[s][k][l] = p[k] - q[k];
+                    Q_supp[s][k][l] = q[k];
+                    dirs  [s][k][l] = dir[k];
+                }
+
+                for( Int t = 0; t <= s; ++t )
+                {
+                    Real d = zero;
+
+                    for( Int k = 0; k < AMB_DIM; ++k )
+                    {
+                        d += coords[t][k][l] * coords[s][k][l];
+                    }
+
+                    dots[t][s][l] = d;
+                    dots[s][t][l] = d;
+                }
+
+                // Same criterion as in Step.
+                bool dup = false;
+
+                for( Int t = 0; t < s; ++t )
+                {
+                    dup = dup || ( dots[t][t][l] + dots[s][s][l] - dots[t][s][l] - dots[t][s][l] <= zero );
+                }
+
+                size += static_cast<Int>(!dup);
+            }
+
+            if( size == 0 )
+            {
+                return;
+            }
+
+            // Full search over the faces of the seeded simplex, with the same recursion for the Deltas as ComputeDelta and the same criteria as SelectFace. Subfaces have smaller bit masks than their faces, so ascending order is fine.
+            const Int mask = (static_cast<Int>(1) << size) - static_cast<Int>(1);
+
+            Real best_num_l = one;
+            Real best_den_l = zero;
+            Int  best_face  = 0;
+
+            for( Int face = 1; face <= mask; ++face )
+            {
+                if( (face & ~mask) != 0 )
+                {
+                    continue;
+                }
+
+                const Int face_size = facets.sizes[face];
+                const Int * restrict const vertices = facets.vertices[face];
+
+                if( face_size == 1 )
+                {
+                    delta[face][vertices[0]][l] = one;
+                }
+                else
+                {
+                    for( Int r = 0; r < face_size; ++r )
+                    {
+                        const Int j       = vertices[r];
+                        const Int subface = face & ~(static_cast<Int>(1) << j);
+                        const Int k       = vertices[ r == 0 ? 1 : 0 ];
+
+                        Real d = zero;
+
+                        for( Int t = 0; t < face_size; ++t )
+                        {
+                            const Int i = vertices[t];
+
+                            d += (t == r) ? zero : delta[subface][i][l] * ( dots[i][k][l] - dots[i][j][l] );
+                        }
+
+                        delta[face][j][l] = d;
+                    }
+                }
+
+                const Real threshold = (face_size > 1) ? eps : zero;
+
+                Real den = zero;
+                Real num = zero;
+
+                for( Int t = 0; t < face_size; ++t )
+                {
+                    den += delta[face][vertices[t]][l];
+                    num += delta[face][vertices[t]][l] * dots[vertices[t]][vertices[0]][l];
+                }
+
+                bool interior = (den > zero);
+
+                for( Int t = 0; t < face_size; ++t )
+                {
+                    interior = interior && ( delta[face][vertices[t]][l] > threshold * den );
+                }
+
+                if( interior && (num * best_den_l < best_num_l * den) )
+                {
+                    best_num_l = num;
+                    best_den_l = den;
+                    best_face  = face;
+                }
+            }
+
+            // The single vertices are always interior, so best_den_l is positive.
+            const Real inv_den = one / best_den_l;
+
+            for( Int s = 0; s < SLOT_COUNT; ++s )
+            {
+                best_lambda[s][l] = bit(best_face,s) ? delta[best_face][s][l] * inv_den : zero;
+            }
+
+            Real r2 = zero;
+
+            for( Int k = 0; k < AMB_DIM; ++k )
+            {
+                v[k][l] = zero;
+
+                for( Int s = 0; s < size; ++s )
+                {
+                    v[k][l] += best_lambda[s][l] * coords[s][k][l];
+                }
+
+                r2 += v[k][l] * v[k][l];
+            }
+
+            dotvv   [l] = r2;
+            olddotvv[l] = r2;
+            occupied[l] = static_cast<LaneInt>(best_face);
+        }
+
+    public:
+
+        // ################################################################
+        // ############################  Step  ############################
+        // ################################################################
+
+        // Carries out one GJK iteration on all active lanes.
+        //
+        // Each stopping criterion of GJK_Algorithm::Compute is evaluated as a lane mask, and the new support point is blended into its slot. This way, all loops over the lanes are free of branches.
+        // For fresh lanes (empty simplex), the iteration is the initial one of GJK_Algorithm::Compute, so only the separation criterion is checked, as in GJK_Algorithm::Compute.
+
+        template<typename P_Lanes_T, typename Q_Lanes_T>
+        void Step( cref<P_Lanes_T> P_lanes, cref<Q_Lanes_T> Q_lanes )
+        {
+            alignas(ObjectAlignment) LaneInt fresh [LANE_COUNT];
+
+            LaneInt any_active = 0;
+
+            // Stopping criteria.
+            GJK_LANE_LOOP
+            for( Int l = 0; l < LANE_COUNT; ++l )
+            {
+                fresh[l] = active[l] & static_cast<LaneInt>( occupied[l] == 0 );
+
+                const LaneInt old = active[l] & ~fresh[l];
+
+                const LaneInt tol_stop  = old & static_cast<LaneInt>( theta_squared[l] * dotvv[l] < TOL_squared[l] );
+                const LaneInt full_stop = old & ~tol_stop & static_cast<LaneInt>( occupied[l] == FULL_MASK );
+                const LaneInt iter_stop = old & ~tol_stop & ~full_stop & static_cast<LaneInt>( iter[l] >= max_iter );
+
+                reason[l] = tol_stop  ? ReasonCode(GJK_Reason::CollisionTolerance)
+                          : full_stop ? ReasonCode(GJK_Reason::FullSimplex)
+                          : iter_stop ? ReasonCode(GJK_Reason::MaxIteration)
+                          : reason[l];
+
+                active[l] &= ~( tol_stop | full_stop | iter_stop );
+
+                iter[l] += active[l] & ~fresh[l];
+
+                // Lowest unoccupied slot.
+                new_bit[l] = ~occupied[l] & ( occupied[l] + 1 );
+
+                any_active |= active[l];
+            }
+
+            if( !any_active )
+            {
+                UpdateSeparatedQ();
+                return;
+            }
+
+            // Lanes that query the support functions in the momentum direction d in this step, and lanes that skip the rest of this step because s(d) is already in the simplex.
+            alignas(ObjectAlignment) LaneInt nesterov [LANE_COUNT] = {};
+            alignas(ObjectAlignment) LaneInt paused   [LANE_COUNT] = {};
+
+            alignas(ObjectAlignment) Real dir [AMB_DIM][LANE_COUNT];
+            alignas(ObjectAlignment) Real dd  [LANE_COUNT] = {};
+
+            if( acceleratedQ )
+            {
+                MomentumDirections( fresh, nesterov, dir, dd );
+            }
+
+            cptr<Real> query = acceleratedQ ? &dir[0][0] : &v[0][0];
+
+            // We use w = p-q, but do not define it explicitly (unless we need it for the momentum).
+            alignas(ObjectAlignment) Real a [LANE_COUNT];
+            alignas(ObjectAlignment) Real b [LANE_COUNT];
+            alignas(ObjectAlignment) Real p [AMB_DIM][LANE_COUNT];
+            alignas(ObjectAlignment) Real q [AMB_DIM][LANE_COUNT];
+
+            P_lanes.MinSupportVectors( &active[0], query, &p[0][0], &a[0] );
+            Q_lanes.MaxSupportVectors( &active[0], query, &q[0][0], &b[0] );
+
+            for( Int k = 0; k < AMB_DIM; ++k )
+            {
+                GJK_LANE_LOOP
+                for( Int l = 0; l < LANE_COUNT; ++l )
+                {
+                    w[k][l] = p[k][l] - q[k][l];
+                }
+            }
+
+            // <v,w>; for the lanes without momentum, this is a - b.
+            alignas(ObjectAlignment) Real vw [LANE_COUNT] = {};
+
+            if( acceleratedQ )
+            {
+                UpdateMomentum( P_lanes, Q_lanes, fresh, nesterov, dir, a, b, p, q, vw );
+            }
+
+            GJK_LANE_LOOP
+            for( Int l = 0; l < LANE_COUNT; ++l )
+            {
+                // <d,w> or <v,w>, depending on the query direction.
+                const Real dw = a[l] - b[l];
+
+                dotvw[l] = nesterov[l] ? vw[l] : dw;
+
+                const LaneInt old = active[l] & ~fresh[l];
+
+                // On fresh lanes, v is only the starting direction, so the test is scaled by dotvv there. With momentum, d is rescaled to the length of v.
+                const Real sep_tol = fresh[l] ? TOL_squared[l] * dotvv[l] : TOL_squared[l];
+                const Real scale_v = nesterov[l] ? dotvv[l] : one;
+                const Real scale_d = nesterov[l] ? dd[l]    : one;
+
+                const LaneInt sep_stop = active[l] & collision_only[l]
+                    & static_cast<LaneInt>( dw > zero )
+                    & static_cast<LaneInt>( theta_squared[l] * dw * dw * scale_v > sep_tol * scale_d );
+
+                // The duality-gap stop is only evaluated without momentum; see GJK_Algorithm::Compute.
+                const Real    gap      = dotvv[l] - dotvw[l];
+                const LaneInt res_stop = old & ~sep_stop & ~nesterov[l] & static_cast<LaneInt>( Abs(gap) <= eps * dotvv[l] );
+
+                const LaneInt restart = nesterov[l] & (
+                    static_cast<LaneInt>( gap >= restart_gap[l] ) | static_cast<LaneInt>( static_cast<Real>(16) * dotvv[l] < restart_dotvv[l] )
+                );
+
+                momentum_iter[l] = restart ? 0 : momentum_iter[l];
+                restart_gap  [l] = (old & ~nesterov[l]) ? gap : restart_gap[l];
+
+                separatedQ[l] |= sep_stop;
+
+                reason[l] = sep_stop ? ReasonCode(GJK_Reason::Separated)
+                          : res_stop ? ReasonCode(GJK_Reason::SmallResidual)
+                          : reason[l];
+
+                active[l] &= ~( sep_stop | res_stop );
+            }
+
+            // Blend the new support point into its slot and compute its dot products with all slots.
+            alignas(ObjectAlignment) Real    d   [SLOT_COUNT][LANE_COUNT];
+            alignas(ObjectAlignment) LaneInt put [SLOT_COUNT][LANE_COUNT];
+
+            for( Int t = 0; t < SLOT_COUNT; ++t )
+            {
+                GJK_LANE_LOOP
+                for( Int l = 0; l < LANE_COUNT; ++l )
+                {
+                    put[t][l] = active[l] & bit(new_bit[l],t);
+                }
+            }
+
+            for( Int t = 0; t < SLOT_COUNT; ++t )
+            {
+                for( Int k = 0; k < AMB_DIM; ++k )
+                {
+                    GJK_LANE_LOOP
+                    for( Int l = 0; l < LANE_COUNT; ++l )
+                    {
+                        // Loading all operands before selecting keeps the compiler from emitting masked loads, which it cannot vectorize here.
+                        const Real    w_new = w[k][l];
+                        const Real    q_new = q[k][l];
+                        const Real    d_new = query[LANE_COUNT * k + l];
+                        const Real    w_old = coords[t][k][l];
+                        const Real    q_old = Q_supp[t][k][l];
+                        const Real    d_old = dirs  [t][k][l];
+
+                        coords[t][k][l] = put[t][l] ? w_new : w_old;
+                        Q_supp[t][k][l] = put[t][l] ? q_new : q_old;
+                        dirs  [t][k][l] = put[t][l] ? d_new : d_old;
+                    }
+                }
+
+                GJK_LANE_LOOP
+                for( Int l = 0; l < LANE_COUNT; ++l )
+                {
+                    d[t][l] = coords[t][0][l] * w[0][l];
+                }
+
+                for( Int k = 1; k < AMB_DIM; ++k )
+                {
+                    GJK_LANE_LOOP
+                    for( Int l = 0; l < LANE_COUNT; ++l )
+                    {
+                        d[t][l] += coords[t][k][l] * w[k][l];
+                    }
+                }
+            }
+
+            for( Int t = 0; t < SLOT_COUNT; ++t )
+            {
+                for( Int u = 0; u < SLOT_COUNT; ++u )
+                {
+                    GJK_LANE_LOOP
+                    for( Int l = 0; l < LANE_COUNT; ++l )
+                    {
+                        const Real d_u   = d[u][l];
+                        const Real d_t   = d[t][l];
+                        const Real d_old = dots[t][u][l];
+
+                        const Real d_new = put[t][l] ? d_u : d_t;
+
+                        dots[t][u][l] = ( put[t][l] | put[u][l] ) ? d_new : d_old;
+                    }
+                }
+            }
+
+            // Check whether the new vertex coincides with one of the old ones. (Same criterion as in GJK_Algorithm::Compute_Gram.)
+            alignas(ObjectAlignment) Real ww [LANE_COUNT];
+
+            GJK_LANE_LOOP
+            for( Int l = 0; l < LANE_COUNT; ++l )
+            {
+                ww[l] = w[0][l] * w[0][l];
+            }
+
+            for( Int k = 1; k < AMB_DIM; ++k )
+            {
+                GJK_LANE_LOOP
+                for( Int l = 0; l < LANE_COUNT; ++l )
+                {
+                    ww[l] += w[k][l] * w[k][l];
+                }
+            }
+
+            alignas(ObjectAlignment) LaneInt dup [LANE_COUNT] = {};
+
+            for( Int t = 0; t < SLOT_COUNT; ++t )
+            {
+                GJK_LANE_LOOP
+                for( Int l = 0; l < LANE_COUNT; ++l )
+                {
+                    dup[l] |= bit(occupied[l],t) & static_cast<LaneInt>( dots[t][t][l] + ww[l] - d[t][l] - d[t][l] <= zero );
+                }
+            }
+
+            LaneInt calls = 0;
+
+            GJK_LANE_LOOP
+            for( Int l = 0; l < LANE_COUNT; ++l )
+            {
+                // s(d) was not computed for v; so a duplicate does not show convergence then.
+                const LaneInt dup_stop  = active[l] & dup[l] & ~nesterov[l];
+                const LaneInt dup_pause = active[l] & dup[l] &  nesterov[l];
+
+                calls += active[l] & ~dup[l] & ~fresh[l];
+
+                reason[l] = dup_stop ? ReasonCode(GJK_Reason::InSimplex) : reason[l];
+                active[l] &= ~( dup_stop | dup_pause );
+
+                paused       [l]  = dup_pause;
+                momentum_iter[l] = dup_pause ? 0 : momentum_iter[l];
+
+                occupied[l] |= active[l] ? new_bit[l] : 0;
+                olddotvv[l]  = active[l] ? dotvv[l]   : olddotvv[l];
+            }
+
+            sub_calls += static_cast<Int>(calls);
+
+            DistanceSubalgorithm( nesterov );
+
+            // Barycentric coordinates and closest point of the selected faces.
+            // For active lanes, best_den is positive because the new vertex alone is always a valid face. Inactive lanes may produce infinities here, but their results are discarded.
+            alignas(ObjectAlignment) Real inv_den [LANE_COUNT];
+
+            GJK_LANE_LOOP
+            for( Int l = 0; l < LANE_COUNT; ++l )
+            {
+                const LaneInt face     = new_face[l];
+                const LaneInt face_old = occupied[l];
+
+                inv_den [l] = one / best_den[l];
+                occupied[l] = active[l] ? face : face_old;
+            }
+
+            for( Int s = 0; s < SLOT_COUNT; ++s )
+            {
+                GJK_LANE_LOOP
+                for( Int l = 0; l < LANE_COUNT; ++l )
+                {
+                    best_delta[s][l] *= inv_den[l];
+                }
+
+                GJK_LANE_LOOP
+                for( Int l = 0; l < LANE_COUNT; ++l )
+                {
+                    const Real lambda_new = best_delta [s][l];
+                    const Real lambda_old = best_lambda[s][l];
+
+                    best_lambda[s][l] = active[l] ? lambda_new : lambda_old;
+                }
+            }
+
+            alignas(ObjectAlignment) Real x  [AMB_DIM][LANE_COUNT];
+            alignas(ObjectAlignment) Real r2 [LANE_COUNT];
+
+            for( Int k = 0; k < AMB_DIM; ++k )
+            {
+                GJK_LANE_LOOP
+                for( Int l = 0; l < LANE_COUNT; ++l )
+                {
+                    x[k][l] = best_lambda[0][l] * coords[0][k][l];
+                }
+
+                for( Int s = 1; s < SLOT_COUNT; ++s )
+                {
+                    GJK_LANE_LOOP
+                    for( Int l = 0; l < LANE_COUNT; ++l )
+                    {
+                        x[k][l] += best_lambda[s][l] * coords[s][k][l];
+                    }
+                }
+
+                GJK_LANE_LOOP
+                for( Int l = 0; l < LANE_COUNT; ++l )
+                {
+                    const Real x_new = x[k][l];
+                    const Real x_old = v[k][l];
+
+                    v[k][l] = active[l] ? x_new : x_old;
+                }
+            }
+
+            GJK_LANE_LOOP
+            for( Int l = 0; l < LANE_COUNT; ++l )
+            {
+                r2[l] = v[0][l] * v[0][l];
+            }
+
+            for( Int k = 1; k < AMB_DIM; ++k )
+            {
+                GJK_LANE_LOOP
+                for( Int l = 0; l < LANE_COUNT; ++l )
+                {
+                    r2[l] += v[k][l] * v[k][l];
+                }
+            }
+
+            GJK_LANE_LOOP
+            for( Int l = 0; l < LANE_COUNT; ++l )
+            {
+                const Real    r2_new     = r2[l];
+                const Real    r2_old     = dotvv[l];
+                const Real    r2_prev    = olddotvv[l];
+                const LaneInt reason_old = reason[l];
+
+                const LaneInt prog = active[l] & ~fresh[l] & static_cast<LaneInt>( Abs(r2_prev - r2_new) <= eps * r2_new );
+
+                const LaneInt prog_stop = prog & ~nesterov[l];
+
+                dotvv[l] = active[l] ? r2_new : r2_old;
+
+                reason[l] = prog_stop ? ReasonCode(GJK_Reason::SmallProgress) : reason_old;
+                active[l] &= ~prog_stop;
+
+                // Without progress, lanes with momentum restart instead of stopping; paused lanes continue with the next step.
+                momentum_iter[l] = (prog & nesterov[l]) ? 0 : momentum_iter[l];
+                active       [l] |= paused[l];
+            }
+
+            UpdateSeparatedQ();
+        }
+
+    protected:
+
+        // Same as the computation of d in GJK_Algorithm::Compute. For the lanes without momentum (and for fresh lanes, whose w is not defined yet), the query direction is v.
+        void MomentumDirections(
+            cptr<LaneInt> fresh,
+            mptr<LaneInt> nesterov,
+            Real (&dir)[AMB_DIM][LANE_COUNT],
+            Real (&dd) [LANE_COUNT]
+        )
+        {
+            alignas(ObjectAlignment) Real mu [LANE_COUNT];
+
+            GJK_LANE_LOOP
+            for( Int l = 0; l < LANE_COUNT; ++l )
+            {
+                nesterov[l] = active[l] & ~fresh[l] & static_cast<LaneInt>( momentum_iter[l] > 0 );
+                mu      [l] = static_cast<Real>(momentum_iter[l] + 1) / static_cast<Real>(momentum_iter[l] + 3);
+            }
+
+            for( Int k = 0; k < AMB_DIM; ++k )
+            {
+                GJK_LANE_LOOP
+                for( Int l = 0; l < LANE_COUNT; ++l )
+                {
+                    const Real y     = mu[l] * v[k][l] + (one - mu[l]) * w[k][l];
+                    const Real d_new = mu[l] * momentum_dir[k][l] + (one - mu[l]) * y;
+                    const Real d_old = momentum_dir[k][l];
+
+                    momentum_dir[k][l] = nesterov[l] ? d_new : d_old;
+
+                    dd[l] += momentum_dir[k][l] * momentum_dir[k][l];
+                }
+            }
+
+            // A vanishing d is useless as direction; we use v in that case.
+            GJK_LANE_LOOP
+            for( Int l = 0; l < LANE_COUNT; ++l )
+            {
+                nesterov[l] &= static_cast<LaneInt>( dd[l] > zero );
+            }
+
+            for( Int k = 0; k < AMB_DIM; ++k )
+            {
+                GJK_LANE_LOOP
+                for( Int l = 0; l < LANE_COUNT; ++l )
+                {
+                    const Real d_new = momentum_dir[k][l];
+                    const Real d_old = v[k][l];
+
+                    dir[k][l] = nesterov[l] ? d_new : d_old;
+                }
+            }
+        }
+
+        // Computes vw = <v,w> and queries s(v) again on the lanes with momentum whose s(d) is (almost) no descent point for v, as GJK_Algorithm::Compute does. Afterwards, d = v on the lanes without momentum, and the momentum counters are advanced.
+        template<typename P_Lanes_T, typename Q_Lanes_T>
+        void UpdateMomentum(
+            cref<P_Lanes_T> P_lanes, cref<Q_Lanes_T> Q_lanes,
+            cptr<LaneInt> fresh,
+            mptr<LaneInt> nesterov,
+            Real (&dir)[AMB_DIM][LANE_COUNT],
+            Real (&a)  [LANE_COUNT],
+            Real (&b)  [LANE_COUNT],
+            Real (&p)  [AMB_DIM][LANE_COUNT],
+            Real (&q)  [AMB_DIM][LANE_COUNT],
+            Real (&vw) [LANE_COUNT]
+        )
+        {
+            GJK_LANE_LOOP
+            for( Int l = 0; l < LANE_COUNT; ++l )
+            {
+                vw[l] = v[0][l] * w[0][l];
+            }
+
+            for( Int k = 1; k < AMB_DIM; ++k )
+            {
+                GJK_LANE_LOOP
+                for( Int l = 0; l < LANE_COUNT; ++l )
+                {
+                    vw[l] += v[k][l] * w[k][l];
+                }
+            }
+
+            alignas(ObjectAlignment) LaneInt fallback [LANE_COUNT];
+
+            LaneInt any_fallback = 0;
+
+            GJK_LANE_LOOP
+            for( Int l = 0; l < LANE_COUNT; ++l )
+            {
+                fallback[l] = nesterov[l] & static_cast<LaneInt>( dotvv[l] - vw[l] <= eps * dotvv[l] );
+
+                any_fallback |= fallback[l];
+            }
+
+            if( any_fallback )
+            {
+                alignas(ObjectAlignment) Real a_v [LANE_COUNT];
+                alignas(ObjectAlignment) Real b_v [LANE_COUNT];
+                alignas(ObjectAlignment) Real p_v [AMB_DIM][LANE_COUNT];
+                alignas(ObjectAlignment) Real q_v [AMB_DIM][LANE_COUNT];
+
+                P_lanes.MinSupportVectors( &fallback[0], &v[0][0], &p_v[0][0], &a_v[0] );
+                Q_lanes.MaxSupportVectors( &fallback[0], &v[0][0], &q_v[0][0], &b_v[0] );
+
+                for( Int k = 0; k < AMB_DIM; ++k )
+                {
+                    GJK_LANE_LOOP
+                    for( Int l = 0; l < LANE_COUNT; ++l )
+                    {
+                        const Real p_new = p_v[k][l];
+                        const Real q_new = q_v[k][l];
+                        const Real x_new = v  [k][l];
+
+                        p  [k][l] = fallback[l] ? p_new : p  [k][l];
+                        q  [k][l] = fallback[l] ? q_new : q  [k][l];
+                        dir[k][l] = fallback[l] ? x_new : dir[k][l];
+                        w  [k][l] = p[k][l] - q[k][l];
+                    }
+                }
+
+                GJK_LANE_LOOP
+                for( Int l = 0; l < LANE_COUNT; ++l )
+                {
+                    const Real a_new = a_v[l];
+                    const Real b_new = b_v[l];
+
+                    a[l] = fallback[l] ? a_new : a[l];
+                    b[l] = fallback[l] ? b_new : b[l];
+
+                    nesterov[l] &= ~fallback[l];
+                }
+            }
+
+            for( Int k = 0; k < AMB_DIM; ++k )
+            {
+                GJK_LANE_LOOP
+                for( Int l = 0; l < LANE_COUNT; ++l )
+                {
+                    const Real d_new = momentum_dir[k][l];
+                    const Real d_old = v[k][l];
+
+                    momentum_dir[k][l] = nesterov[l] ? d_new : d_old;
+                }
+            }
+
+            GJK_LANE_LOOP
+            for( Int l = 0; l < LANE_COUNT; ++l )
+            {
+                restart_dotvv[l] = (active[l] & ~nesterov[l]) ? dotvv[l] : restart_dotvv[l];
+                momentum_iter[l] += active[l] & ~fresh[l];
+            }
+        }
+
+        static constexpr LaneInt ReasonCode( const GJK_Reason r )
+        {
+            return static_cast<LaneInt>(r);
+        }
+
+        void UpdateSeparatedQ()
+        {
+            // Has no effect on lanes that terminated in an earlier step, since their dotvv does not change anymore.
+            for( Int l = 0; l < LANE_COUNT; ++l )
+            {
+                separatedQ[l] |= ~active[l] & static_cast<LaneInt>( TOL_squared[l] < theta_squared[l] * dotvv[l] );
+            }
+        }
+
+    protected:
+
+        // ################################################################
+        // ###################   DistanceSubalgorithm   ###################
+        // ################################################################
+
+        // We use the determinant formulation of Johnson's subalgorithm (cf. Gilbert, Johnson, Keerthi 1988): For a face X of the simplex and y_j not in X,
+        //
+        //     Delta_j( X + {y_j} ) = sum_{i in X} Delta_i(X) * ( <y_i,y_k> - <y_i,y_j> ),   Delta_i( {y_i} ) = 1,
+        //
+        // where k is a fixed vertex of X. The barycentric coordinates of the point closest to the origin in the affine hull of X are lambda_i = Delta_i(X) / Delta(X) with Delta(X) = sum_{i in X} Delta_i(X), and its squared norm is sum_{i in X} lambda_i <y_i,y_k>.
+        //
+        // This needs no divisions and no branches, so we simply compute the Deltas of all faces for all lanes. Among the faces that contain the new vertex and have positive barycentric coordinates, we pick the one closest to the origin. This gives the same result as the recursive search in GJK_Algorithm::DistanceSubalgorithm.
+        //
+        // The faces are visited in fold expressions, so that all slot indices are compile-time constants and only the loops over the lanes remain.
+        //
+        // If SignedVolumesQ(), SignedVolumeDeltas replaces ComputeDeltas and the distances of the faces are computed from the coordinates; the selection of the face is the same.
+
+        void DistanceSubalgorithm( cptr<LaneInt> keep )
+        {
+            // Faces that are not contained in any of the active simplices can be skipped.
+            Int union_mask = 0;
+
+            for( Int l = 0; l < LANE_COUNT; ++l )
+            {
+                // Lanes in keep start with the current v as best candidate, as GJK_Algorithm::PrepareDistanceSubalgorithm( true ).
+                best_num[l] = keep[l] ? olddotvv[l]                 : one;
+                best_den[l] = keep[l] ? one                         : zero;
+                new_face[l] = keep[l] ? (occupied[l] & ~new_bit[l]) : 0;
+
+                for( Int s = 0; s < SLOT_COUNT; ++s )
+                {
+                    best_delta[s][l] = best_lambda[s][l];
+                }
+
+                union_mask |= active[l] ? occupied[l] : 0;
+            }
+
+            SolveFaces( union_mask, SignedVolumesQ(), std::make_integer_sequence<Int,FACE_COUNT>() );
+        }
+
+        template<Int... faces>
+        void SolveFaces( const Int union_mask, const bool svQ, std::integer_sequence<Int,faces...> )
+        {
+            ( SolveFace<faces>(union_mask,svQ), ... );
+        }
+
+        template<Int face>
+        void SolveFace( const Int union_mask, const bool svQ )
+        {
+            if constexpr ( face > 0 )
+            {
+                if( (face & ~union_mask) != 0 )
+                {
+                    return;
+                }
+
+                constexpr Int face_size = facets.sizes[face];
+
+                if( svQ )
+                {
+                    SignedVolumeDeltas<face>();
+                }
+                else
+                {
+                    ComputeDeltas<face>( std::make_integer_sequence<Int,face_size>() );
+                }
+
+                SelectFace<face>( svQ, std::make_integer_sequence<Int,face_size>() );
+            }
+        }
+
+        template<Int face, Int... r>
+        void ComputeDeltas( std::integer_sequence<Int,r...> seq )
+        {
+            if constexpr ( sizeof...(r) == 1 )
+            {
+                constexpr Int i_0 = facets.vertices[face][0];
+
+                for( Int l = 0; l < LANE_COUNT; ++l )
+                {
+                    delta[face][i_0][l] = one;
+                }
+            }
+            else
+            {
+                ( ComputeDelta<face,r>( seq ), ... );
+            }
+        }
+
+        template<Int face, Int r, Int... q>
+        void ComputeDelta( std::integer_sequence<Int,q...> )
+        {
+            // Removing vertex j from face gives subface with first vertex k.
+            constexpr const Int (&vertices)[SLOT_COUNT] = facets.vertices[face];
+
+            constexpr Int j       = vertices[r];
+            constexpr Int subface = face & ~(static_cast<Int>(1) << j);
+            constexpr Int k       = vertices[ r == 0 ? 1 : 0 ];
+
+            for( Int l = 0; l < LANE_COUNT; ++l )
+            {
+                delta[face][j][l] = (
+                    zero + ... + (
+                        q == r
+                        ? zero
+                        : delta[subface][vertices[q]][l] * ( dots[vertices[q]][k][l] - dots[vertices[q]][j][l] )
+                    )
+                );
+            }
+        }
+
+        // Counterpart of ComputeDeltas for GJK_SubAlgorithm::SignedVolumes, with the same formulas as GJK_Algorithm::SV_Segment, SV_Triangle, and SV_Tetrahedron: delta[face][i] is the signed volume of the face with vertex i replaced by the projection of the origin, multiplied by the sign of the volume of the face itself. These sum up to the absolute volume of the face, so SelectFace can treat them like Johnson's Deltas. They are computed from the coordinates, not from the Gram matrix.
+        template<Int face>
+        void SignedVolumeDeltas()
+        {
+            constexpr const Int (&vertices)[SLOT_COUNT] = facets.vertices[face];
+
+            constexpr Int face_size = facets.sizes[face];
+
+            if constexpr ( face_size == 1 )
+            {
+                for( Int l = 0; l < LANE_COUNT; ++l )
+                {
+                    delta[face][vertices[0]][l] = one;
+                }
+            }
+            else if constexpr ( face_size == 2 )
+            {
+                constexpr Int i_0 = vertices[0];
+                constexpr Int i_1 = vertices[1];
+
+                alignas(ObjectAlignment) Real at  [LANE_COUNT] = {};
+                alignas(ObjectAlignment) Real tt  [LANE_COUNT] = {};
+                alignas(ObjectAlignment) Real a_I [LANE_COUNT];
+                alignas(ObjectAlignment) Real b_I [LANE_COUNT];
+
+                // a_I and b_I are the coordinates of the endpoints along the axis in which the segment is longest.
+                for( Int k = 0; k < AMB_DIM; ++k )
+                {
+                    for( Int l = 0; l < LANE_COUNT; ++l )
+                    {
+                        const Real a_k = coords[i_0][k][l];
+                        const Real b_k = coords[i_1][k][l];
+                        const Real t_k = b_k - a_k;
+
+                        at[l] += a_k * t_k;
+                        tt[l] += t_k * t_k;
+
+                        const bool longerQ = (k == 0) || ( Abs(t_k) > Abs(b_I[l] - a_I[l]) );
+
+                        a_I[l] = longerQ ? a_k : a_I[l];
+                        b_I[l] = longerQ ? b_k : b_I[l];
+                    }
+                }
+
+                for( Int l = 0; l < LANE_COUNT; ++l )
+                {
+                    // I-th coordinate of the projection of the origin onto the line. For a degenerate segment, b_I - a_I vanishes; dividing by one instead of tt keeps the division out of the selects, so that the loop vectorizes.
+                    const Real p_I = a_I[l] - at[l] / ( (tt[l] > zero) ? tt[l] : one ) * (b_I[l] - a_I[l]);
+
+                    const Real sign = (a_I[l] < b_I[l]) ? -one : one;
+
+                    delta[face][i_0][l] = sign * (p_I - b_I[l]);
+                    delta[face][i_1][l] = sign * (a_I[l] - p_I);
+                }
+            }
+            else if constexpr ( face_size == 3 )
+            {
+                constexpr Int i_0 = vertices[0];
+                constexpr Int i_1 = vertices[1];
+                constexpr Int i_2 = vertices[2];
+
+                for( Int l = 0; l < LANE_COUNT; ++l )
+                {
+                    // Projection of the origin onto the plane of the triangle and the vertices, in the two coordinates in which the triangle is measured.
+                    Real p_x = zero;
+                    Real p_y = zero;
+
+                    Real x [3] = { coords[i_0][0][l], coords[i_1][0][l], coords[i_2][0][l] };
+                    Real y [3] = { coords[i_0][1][l], coords[i_1][1][l], coords[i_2][1][l] };
+
+                    if constexpr ( AMB_DIM == 3 )
+                    {
+                        const Real a [3] = { coords[i_0][0][l], coords[i_0][1][l], coords[i_0][2][l] };
+                        const Real b [3] = { coords[i_1][0][l], coords[i_1][1][l], coords[i_1][2][l] };
+                        const Real c [3] = { coords[i_2][0][l], coords[i_2][1][l], coords[i_2][2][l] };
+
+                        const Real u [3] = { b[0] - a[0], b[1] - a[1], b[2] - a[2] };
+                        const Real w [3] = { c[0] - a[0], c[1] - a[1], c[2] - a[2] };
+
+                        const Real n [3] = {
+                            u[1] * w[2] - u[2] * w[1],
+                            u[2] * w[0] - u[0] * w[2],
+                            u[0] * w[1] - u[1] * w[0]
+                        };
+
+                        const Real nn = n[0] * n[0] + n[1] * n[1] + n[2] * n[2];
+
+                        const Real s = ( a[0] * n[0] + a[1] * n[1] + a[2] * n[2] ) / ( (nn > zero) ? nn : one );
+
+                        // The triangle is measured in the coordinates (J+1)%3 and (J+2)%3, where J is the largest component of the normal.
+                        const bool J_0 = (Abs(n[0]) >= Abs(n[1])) && (Abs(n[0]) >= Abs(n[2]));
+                        const bool J_1 = !J_0 && (Abs(n[1]) >= Abs(n[2]));
+
+                        p_x = s * ( J_0 ? n[1] : J_1 ? n[2] : n[0] );
+                        p_y = s * ( J_0 ? n[2] : J_1 ? n[0] : n[1] );
+
+                        for( Int j = 0; j < 3; ++j )
+                        {
+                            const Real z_0 = (j == 0) ? a[0] : (j == 1) ? b[0] : c[0];
+                            const Real z_1 = (j == 0) ? a[1] : (j == 1) ? b[1] : c[1];
+                            const Real z_2 = (j == 0) ? a[2] : (j == 1) ? b[2] : c[2];
+
+                            x[j] = J_0 ? z_1 : J_1 ? z_2 : z_0;
+                            y[j] = J_0 ? z_2 : J_1 ? z_0 : z_1;
+                        }
+                    }
+
+                    // Signed areas of the triangle and of the triangles with one vertex replaced by the projection.
+                    const Real nu  = (x[1] - x[0]) * (y[2] - y[0]) - (y[1] - y[0]) * (x[2] - x[0]);
+                    const Real C_0 = (x[1] - p_x ) * (y[2] - p_y ) - (y[1] - p_y ) * (x[2] - p_x );
+                    const Real C_1 = (p_x  - x[0]) * (y[2] - y[0]) - (p_y  - y[0]) * (x[2] - x[0]);
+                    const Real C_2 = (x[1] - x[0]) * (p_y  - y[0]) - (y[1] - y[0]) * (p_x  - x[0]);
+
+                    const Real sign = (nu < zero) ? -one : one;
+
+                    delta[face][i_0][l] = sign * C_0;
+                    delta[face][i_1][l] = sign * C_1;
+                    delta[face][i_2][l] = sign * C_2;
+                }
+            }
+            else if constexpr ( (face_size == 4) && (AMB_DIM == 3) )
+            {
+                for( Int l = 0; l < LANE_COUNT; ++l )
+                {
+                    // Signed volume of the tetrahedron (q_0,q_1,q_2,q_3).
+                    auto volume = [l,this]( const Int r_0, const Int r_1, const Int r_2, const Int r_3 )
+                    {
+                        // Index SLOT_COUNT stands for the origin.
+                        auto c = [l,this]( const Int r, const Int k )
+                        {
+                            return (r < SLOT_COUNT) ? coords[r][k][l] : zero;
+                        };
+
+                        const Real u [3] = { c(r_1,0) - c(r_0,0), c(r_1,1) - c(r_0,1), c(r_1,2) - c(r_0,2) };
+                        const Real w [3] = { c(r_2,0) - c(r_0,0), c(r_2,1) - c(r_0,1), c(r_2,2) - c(r_0,2) };
+                        const Real z [3] = { c(r_3,0) - c(r_0,0), c(r_3,1) - c(r_0,1), c(r_3,2) - c(r_0,2) };
+
+                        return u[0] * (w[1] * z[2] - w[2] * z[1])
+                             + u[1] * (w[2] * z[0] - w[0] * z[2])
+                             + u[2] * (w[0] * z[1] - w[1] * z[0]);
+                    };
+
+                    constexpr Int o = SLOT_COUNT;
+
+                    const Real sign = ( volume(0,1,2,3) < zero ) ? -one : one;
+
+                    delta[face][0][l] = sign * volume(o,1,2,3);
+                    delta[face][1][l] = sign * volume(0,o,2,3);
+                    delta[face][2][l] = sign * volume(0,1,o,3);
+                    delta[face][3][l] = sign * volume(0,1,2,o);
+                }
+            }
+        }
+
+        template<Int face, Int... q>
+        void SelectFace( const bool svQ, std::integer_sequence<Int,q...> )
+        {
+            constexpr const Int (&vertices)[SLOT_COUNT] = facets.vertices[face];
+
+            constexpr Int i_0 = vertices[0];
+
+            // The signed volumes only have to have the right sign, as in GJK_Algorithm::SignedVolumes.
+            const Real threshold = ( (sizeof...(q) > 1) && !svQ ) ? eps : zero;
+
+            alignas(ObjectAlignment) Real num [LANE_COUNT];
+
+            if( svQ )
+            {
+                // Squared norm of the closest point, computed from the coordinates and scaled by den.
+                alignas(ObjectAlignment) Real r2 [LANE_COUNT] = {};
+
+                for( Int k = 0; k < AMB_DIM; ++k )
+                {
+                    for( Int l = 0; l < LANE_COUNT; ++l )
+                    {
+                        const Real x = ( zero + ... + ( delta[face][vertices[q]][l] * coords[vertices[q]][k][l] ) );
+
+                        r2[l] += x * x;
+                    }
+                }
+
+                for( Int l = 0; l < LANE_COUNT; ++l )
+                {
+                    const Real den = ( zero + ... + delta[face][vertices[q]][l] );
+
+                    // Faces with den <= 0 are not selected anyway.
+                    num[l] = r2[l] / ( (den > zero) ? den : one );
+                }
+            }
+            else
+            {
+                for( Int l = 0; l < LANE_COUNT; ++l )
+                {
+                    num[l] = ( zero + ... + ( delta[face][vertices[q]][l] * dots[vertices[q]][i_0][l] ) );
+                }
+            }
+
+            for( Int l = 0; l < LANE_COUNT; ++l )
+            {
+                const Real den = ( zero + ... + delta[face][vertices[q]][l] );
+
+                const LaneInt interior =
+                    active[l]
+                    & static_cast<LaneInt>( (face & ~occupied[l]) == 0 )
+                    & static_cast<LaneInt>( (face & new_bit[l]) != 0 )
+                    & static_cast<LaneInt>( den > zero )
+                    & ( static_cast<LaneInt>(1) & ... & static_cast<LaneInt>( delta[face][vertices[q]][l] > threshold * den ) );
+
+                // num / den < best_num / best_den without division.
+                const LaneInt update = interior & static_cast<LaneInt>( num[l] * best_den[l] < best_num[l] * den );
+
+                best_num[l] = update ? num[l] : best_num[l];
+                best_den[l] = update ? den    : best_den[l];
+                new_face[l] = update ? face   : new_face[l];
+
+                // delta[face][s] is never written for slots s outside of face, so it stays zero there.
+                for( Int s = 0; s < SLOT_COUNT; ++s )
+                {
+                    best_delta[s][l] = update ? delta[face][s][l] : best_delta[s][l];
+                }
+            }
+        }
+
+    public:
+
+        // ################################################################
+        // ##########################  Process  ###########################
+        // ################################################################
+
+        // Runs the lanes over the pairs handed out by jobs, a GJK_JobScheduler<Int>::Worker (or anything with a member bool Next( Int & i )). P_lanes and Q_lanes are SupportLanes objects (or anything with the same interface).
+        //
+        // prepare( lane, i ) has to point P_lanes[lane] and Q_lanes[lane] to the i-th pair and to call Load( lane, P_lanes, Q_lanes, ... ).
+        // finish ( lane, i ) is called once the i-th pair has terminated in lane `lane`; it is supposed to read out the results.
+        //
+        // Lanes are refilled as soon as they have terminated.
+
+        template<typename Jobs_T, typename P_Lanes_T, typename Q_Lanes_T, typename Prepare_T, typename Finish_T>
+        void Process(
+            Jobs_T & jobs,
+            cref<P_Lanes_T> P_lanes, cref<Q_Lanes_T> Q_lanes,
+            Prepare_T && prepare, Finish_T && finish
+        )
+        {
+            sub_calls = 0;
+
+            Int pair [LANE_COUNT] = {};
+            bool busy[LANE_COUNT] = {};
+
+            Int busy_count = 0;
+
+            for( Int l = 0; l < LANE_COUNT; ++l )
+            {
+                active[l] = 0;
+
+                if( jobs.Next( pair[l] ) )
+                {
+                    busy[l] = true;
+                    prepare( l, pair[l] );
+                    ++busy_count;
+                }
+            }
+
+            while( busy_count > 0 )
+            {
+                Step( P_lanes, Q_lanes );
+
+                // Collect the lanes that have terminated without branching on each lane; which lanes terminate is hard to predict.
+                Int done [LANE_COUNT];
+                Int done_count = 0;
+
+                for( Int l = 0; l < LANE_COUNT; ++l )
+                {
+                    done[done_count] = l;
+                    done_count += static_cast<Int>( busy[l] && !active[l] );
+                }
+
+                for( Int j = 0; j < done_count; ++j )
+                {
+                    const Int l = done[j];
+
+                    finish( l, pair[l] );
+
+                    if( jobs.Next( pair[l] ) )
+                    {
+                        prepare( l, pair[l] );
+                    }
+                    else
+                    {
+                        busy[l] = false;
+                        --busy_count;
+                    }
+                }
+            }
+        }
+
+        // ################################################################
+        // ########################   Witnesses   #########################
+        // ################################################################
+
+        // Same as GJK_Algorithm::WriteWitnesses, but for lane `lane`.
+        void WriteWitnesses( const Int lane, mptr<Real> x_out, mptr<Real> y_out ) const
+        {
+            WriteWitnesses( lane, x_out, y_out, one, zero );
+        }
+
+        // Same as GJK_Algorithm::WriteOffsetWitnesses, but for lane `lane`.
+        Real WriteOffsetWitnesses(
+            const Int lane,
+            const Real P_offset, mptr<Real> x_out,
+            const Real Q_offset, mptr<Real> y_out
+        ) const
+        {
+            const Real dist0 = Sqrt(dotvv[lane]);
+                  Real dist = dist0 - P_offset - Q_offset;
+
+            if( dist > zero )
+            {
+                WriteWitnesses( lane, x_out, y_out, (dist0 - P_offset - Q_offset) / dist0, Q_offset / dist0 );
+            }
+            else
+            {
+                dist = zero;
+
+                WriteWitnesses( lane, x_out, y_out, one, zero );
+            }
+
+            return dist * dist;
+        }
+
+        Real Offset_SquaredDistance( const Int lane, const Real P_offset, const Real Q_offset ) const
+        {
+            const Real dist = Ramp( Sqrt(dotvv[lane]) - P_offset - Q_offset );
+
+            return dist * dist;
+        }
+
+        // Writes the closest point of the Minkowski difference P - Q found for lane `lane`; it can be passed to Load as starting direction for the same pair later on.
+        void WriteClosestPoint( const Int lane, mptr<Real> vec ) const
+        {
+            for( Int k = 0; k < AMB_DIM; ++k )
+            {
+                vec[k] = v[k][lane];
+            }
+        }
+
+        // Same as GJK_Algorithm::WriteWarmStart, but for lane `lane`; the occupied slots are written in ascending order.
+        void WriteWarmStart( const Int lane, mptr<Real> record ) const
+        {
+            const Int l = lane;
+
+            Int i = 0;
+
+            zerofy_buffer<SLOT_COUNT * SLOT_COUNT>( record );
+
+            for( Int s = 0; s < SLOT_COUNT; ++s )
+            {
+                if( bit(occupied[l],s) )
+                {
+                    record[SLOT_COUNT * i] = best_lambda[s][l];
+
+                    for( Int k = 0; k < AMB_DIM; ++k )
+                    {
+                        record[SLOT_COUNT * i + 1 + k] = dirs[s][k][l];
+                    }
+
+                    ++i;
+                }
+            }
+
+            for( Int k = 0; k < AMB_DIM; ++k )
+            {
+                record[SLOT_COUNT * SLOT_COUNT + k] = v[k][l];
+            }
+        }
+
+        // Same as GJK_Algorithm::WriteSimplex, but for lane `lane`; the occupied slots are written in ascending order.
+        Int WriteSimplex( const Int lane, mptr<Real> P_vertices, mptr<Real> Q_vertices, mptr<Real> lambda ) const
+        {
+            const Int l = lane;
+
+            Int i = 0;
+
+            for( Int s = 0; s < SLOT_COUNT; ++s )
+            {
+                if( bit(occupied[l],s) )
+                {
+                    for( Int k = 0; k < AMB_DIM; ++k )
+                    {
+                        P_vertices[AMB_DIM * i + k] = coords[s][k][l] + Q_supp[s][k][l];
+                        Q_vertices[AMB_DIM * i + k] = Q_supp[s][k][l];
+                    }
+
+                    lambda[i] = best_lambda[s][l];
+
+                    ++i;
+                }
+            }
+
+            return i;
+        }
+
+    protected:
+
+        void WriteWitnesses(
+            const Int lane, mptr<Real> x_out, mptr<Real> y_out, const Real x_scale, const Real y_scale
+        ) const
+        {
+            const Int l = lane;
+
+            for( Int k = 0; k < AMB_DIM; ++k )
+            {
+                y_out[k] = y_scale * v[k][l];
+            }
+
+            for( Int s = 0; s < SLOT_COUNT; ++s )
+            {
+                if( bit(occupied[l],s) )
+                {
+                    for( Int k = 0; k < AMB_DIM; ++k )
+                    {
+                        y_out[k] += best_lambda[s][l] * Q_supp[s][k][l];
+                    }
+                }
+            }
+
+            for( Int k = 0; k < AMB_DIM; ++k )
+            {
+                x_out[k] = y_out[k] + x_scale * v[k][l];
+            }
+        }
+
+    public:
+
+        std::string ClassName() const
+        {
+            return "GJK_Algorithm_Vectorized<"+ToString(LANE_COUNT)+","+ToString(AMB_DIM)+","+TypeName<Real>+","+TypeName<Int>+">";
+        }
+
+    }; // GJK_Algorithm_Vectorized
+
+
+    // With a single lane there is nothing to run in lockstep, so we simply forward to GJK_Algorithm. This way, the batch routines can use the same code for all lane counts.
+
+    template<int AMB_DIM, typename Real_, typename Int_>
+    class GJK_Algorithm_Vectorized<1,AMB_DIM,Real_,Int_>
+    {
+    public:
+
+        using Int  = Int_;
+        using Real = Real_;
+
+    protected:
+
+        GJK_Algorithm<AMB_DIM,Real,Int> gjk;
+
+        Int sub_calls = 0;
+
+    public:
+
+        GJK_Algorithm_Vectorized() = default;
+
+        explicit GJK_Algorithm_Vectorized( const GJK_SubAlgorithm sub_algorithm_ )
+        :   gjk ( sub_algorithm_ )
+        {}
+
+        ~GJK_Algorithm_Vectorized() = default;
+
+        static constexpr Int AmbDim()
+        {
+            return AMB_DIM;
+        }
+
+        static constexpr Int LaneCount()
+        {
+            return 1;
+        }
+
+        GJK_SubAlgorithm SubAlgorithm() const
+        {
+            return gjk.SubAlgorithm();
+        }
+
+        void SetSubAlgorithm( const GJK_SubAlgorithm sub_algorithm_ )
+        {
+            gjk.SetSubAlgorithm( sub_algorithm_ );
+        }
+
+        bool SignedVolumesQ() const
+        {
+            return gjk.SignedVolumesQ();
+        }
+
+        void SetAcceleration( const bool acceleratedQ_ )
+        {
+            gjk.SetAcceleration( acceleratedQ_ );
+        }
+
+        bool AcceleratedQ() const
+        {
+            return gjk.AcceleratedQ();
+        }
+
+        bool ActiveQ( const Int lane ) const
+        {
+            (void)lane;
+            return false;
+        }
+
+        bool SeparatedQ( const Int lane ) const
+        {
+            (void)lane;
+            return gjk.SeparatedQ();
+        }
+
+        Real LeastSquaredDistance( const Int lane ) const
+        {
+            (void)lane;
+            return gjk.LeastSquaredDistance();
+        }
+
+        Int IterationCount( const Int lane ) const
+        {
+            (void)lane;
+            return gjk.IterationCount();
+        }
+
+        Int SubCallCount() const
+        {
+            return sub_calls;
+        }
+
+        static constexpr Int WarmStartSize()
+        {
+            return GJK_Algorithm<AMB_DIM,Real,Int>::WarmStartSize();
+        }
+
+        // Runs the complete GJK loop right away.
+        template<typename P_Lanes_T, typename Q_Lanes_T>
+        void Load(
+            const Int lane,
+            P_Lanes_T & P_lanes,
+            Q_Lanes_T & Q_lanes,
+            const bool collision_only_ = false,
+            const Real TOL_squared_    = Scalar::Zero<Real>,
+            const Real theta_squared_  = Scalar::One <Real>,
+            cptr<Real> warm_start      = nullptr
+        )
+        {
+            if( warm_start != nullptr )
+            {
+                gjk.ReadWarmStart( warm_start );
+            }
+
+            gjk.Compute( P_lanes[lane], Q_lanes[lane], collision_only_, warm_start != nullptr, TOL_squared_, theta_squared_ );
+
+            sub_calls += gjk.SubCallCount();
+        }
+
+        template<typename P_Lanes_T, typename Q_Lanes_T>
+        void Step( cref<P_Lanes_T> P_lanes, cref<Q_Lanes_T> Q_lanes )
+        {
+            (void)P_lanes;
+            (void)Q_lanes;
+        }
+
+        template<typename Jobs_T, typename P_Lanes_T, typename Q_Lanes_T, typename Prepare_T, typename Finish_T>
+        void Process(
+            Jobs_T & jobs,
+            cref<P_Lanes_T> P_lanes, cref<Q_Lanes_T> Q_lanes,
+            Prepare_T && prepare, Finish_T && finish
+        )
+        {
+            (void)P_lanes;
+            (void)Q_lanes;
+
+            sub_calls = 0;
+
+            Int i;
+
+            while( jobs.Next(i) )
+            {
+                prepare( 0, i );
+                finish ( 0, i );
+            }
+        }
+
+        void WriteWitnesses( const Int lane, mptr<Real> x_out, mptr<Real> y_out ) const
+        {
+            (void)lane;
+            gjk.WriteWitnesses( x_out, y_out );
+        }
+
+        Int WriteSimplex( const Int lane, mptr<Real> P_vertices, mptr<Real> Q_vertices, mptr<Real> lambda ) const
+        {
+            (void)lane;
+            return gjk.WriteSimplex( P_vertices, Q_vertices, lambda );
+        }
+
+        Real WriteOffsetWitnesses(
+            const Int lane,
+            const Real P_offset, mptr<Real> x_out,
+            const Real Q_offset, mptr<Real> y_out
+        ) const
+        {
+            (void)lane;
+            return gjk.WriteOffsetWitnesses( P_offset, x_out, Q_offset, y_out );
+        }
+
+        Real Offset_SquaredDistance( const Int lane, const Real P_offset, const Real Q_offset ) const
+        {
+            (void)lane;
+
+            const Real dist = Ramp( Sqrt(gjk.LeastSquaredDistance()) - P_offset - Q_offset );
+
+            return dist * dist;
+        }
+
+        void WriteClosestPoint( const Int lane, mptr<Real> vec ) const
+        {
+            (void)lane;
+            gjk.WriteClosestPoint( vec );
+        }
+
+        void WriteWarmStart( const Int lane, mptr<Real> record ) const
+        {
+            (void)lane;
+            gjk.WriteWarmStart( record );
+        }
+
+        std::string ClassName() const
+        {
+            return "GJK_Algorithm_Vectorized<1,"+ToString(AMB_DIM)+","+TypeName<Real>+","+TypeName<Int>+">";
+        }
+
+    }; // GJK_Algorithm_Vectorized<1,...>
+
+} // namespace GJK
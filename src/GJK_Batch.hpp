@@ -2,52 +2,92 @@
 
 namespace GJK
 {
+    // The batch routines are templated on the primitive types P_T and Q_T.
+    // If these are concrete classes like Polytope<3,3,...>, then the calls to SetPointer and to the support functions go through the concrete type, so the compiler can devirtualize them (at least speculatively) and inline them into the GJK loop. The primitive classes are deliberately not final, so they can still be subclassed downstream.
+    // If they are abstract classes like PrimitiveSerialized<...>, we fall back to virtual dispatch.
+    //
+    // Each thread runs GJK_Algorithm_Vectorized on LANE_COUNT pairs at once. SupportLanes holds one primitive view per lane (and, for polytopes, a lane-major copy of the points).
+    // See GJK_DefaultLaneCount for the choice of LANE_COUNT. For LANE_COUNT == 1, GJK_Algorithm_Vectorized simply forwards to GJK_Algorithm.
+    //
+    // P_T and Q_T may also be PolytopeSoA views. Then the prototype carries the stride, and the serialized data is the SoA matrix of size P_.Size() x stride instead of n x P_.Size().
+    //
+    // WARM STARTS
+    // All batch routines (also those in GJK_Offset_Batch.hpp and GJK_Indexed_Batch.hpp) take an optional argument warm_start: a matrix with one row of size (AMB_DIM+1) * (AMB_DIM+1) + AMB_DIM per pair, in the order of the pairs. A row is a record as written by GJK_Algorithm::WriteWarmStart, i.e., the final simplex of the previous call (barycentric weights and search directions) and the final direction v. A row of zeros gives a cold start. Each row is overwritten by the final simplex of its pair, so that calling the same routine again on slightly moved primitives usually needs only a few support queries per pair.
+    //
+    // SUBALGORITHM
+    // All batch routines (and BVH_IntersectingPairs) take an optional argument sub_algorithm, which is passed on to GJK_Algorithm_Vectorized. GJK_SubAlgorithm::SignedVolumes is meant for nearly degenerate simplices, e.g., pairs of thin sliver triangles; it is used both in the lockstep path and, for LANE_COUNT == 1, by GJK_Algorithm.
+    //
+    // ACCELERATION
+    // All batch routines take an optional last argument accelerated (default: false), which switches on the Nesterov-accelerated variant of GJK described above GJK_Algorithm. It pays off for smooth primitives like ellipsoids, where plain GJK needs many iterations; for polytopes with few vertices, it rarely saves an iteration and costs a few additional support queries.
 
-    template<int AMB_DIM, typename Real, typename Int, typename SReal>
+    template<typename P_T, typename Q_T, typename Int, typename SReal>
     void GJK_IntersectingQ_Batch
     (
-        Int n,                                      // number of primitive pairs
-        const PrimitiveSerialized<AMB_DIM,Real,Int,SReal> & P_, // prototype primitive
-        SReal * const P_serialized_data,               // matrix of size n x P_.Size()
-        const PrimitiveSerialized<AMB_DIM,Real,Int,SReal> & Q_, // prototype primitive
-        SReal * const Q_serialized_data,               // matrix of size n x Q_.Size()
-          Int * const intersectingQ,                    // vector of size n for storing the results
-        const Int thread_count = 1
+        const Int n,                                   // number of primitive pairs
+        cref<P_T> P_,                                  // prototype primitive
+        mptr<SReal> P_serialized_data,                 // matrix of size n x P_.Size()
+        cref<Q_T> Q_,                                  // prototype primitive
+        mptr<SReal> Q_serialized_data,                 // matrix of size n x Q_.Size()
+        mptr<Int> intersectingQ,                       // vector of size n for storing the results
+        const Int thread_count = 1,
+        mptr<typename P_T::Real> warm_start = nullptr, // optional warm-start records, one row per pair; see GJK_Batch.hpp
+        const Int chunk_size = GJK_JobScheduler<Int>::DefaultChunkSize, // pairs per chunk of the dynamic schedule; chunk_size <= 0 splits the pairs evenly among the threads instead
+        const GJK_SubAlgorithm sub_algorithm = GJK_SubAlgorithm::Johnson, // distance subalgorithm of the GJK runs; see GJK_SubAlgorithm
+        const bool accelerated = false                 // use the Nesterov-accelerated variant of GJK; see GJK_Algorithm::SetAcceleration
     )
     {
+        constexpr int AMB_DIM = P_T::AmbDim();
+        using Real = typename P_T::Real;
+        constexpr int LANE_COUNT = GJK_DefaultLaneCount<Real>();
+
+        static_assert( Q_T::AmbDim() == AMB_DIM, "GJK_IntersectingQ_Batch: Ambient dimensions of primitives do not match." );
+        static_assert( std::is_same_v<typename Q_T::Real,Real>, "GJK_IntersectingQ_Batch: Real types of primitives do not match." );
+
         tic("GJK_IntersectingQ_Batch");
 
         valprint("Number of primitive pairs",n);
         valprint("Ambient dimension        ",AMB_DIM);
         valprint("thread_count             ",thread_count);
+        valprint("chunk_size               ",chunk_size);
+        valprint("accelerated              ",accelerated);
         print("First  primitive type     = "+P_.ClassName());
         print("Second primitive type     = "+Q_.ClassName());
-        
+
+        GJK_JobScheduler<Int> scheduler ( Int(0), n, thread_count, chunk_size );
+
         const Int sub_calls = ParallelDoReduce(
             [&]( const Int thread ) -> Int
             {
-                Int sub_calls (0);
-                
-                GJK_Algorithm<AMB_DIM,Real,Int> gjk;
-                std::shared_ptr<PrimitiveSerialized<AMB_DIM,Real,Int,SReal>> P = P_.Clone();
-                std::shared_ptr<PrimitiveSerialized<AMB_DIM,Real,Int,SReal>> Q = Q_.Clone();
-
-                const Int i_begin = JobPointer<Int>( n, thread_count, thread    );
-                const Int i_end   = JobPointer<Int>( n, thread_count, thread +1 );
-                
-                for( Int i = i_begin; i < i_end; ++i )
-                {
-                    //print(\"======================================================\");\ valprint(\" i \",i);
-
-                    P->SetPointer( P_serialized_data, i );
-                    Q->SetPointer( Q_serialized_data, i );
-
-                    intersectingQ[i] = gjk.IntersectingQ( *P, *Q );
-                    
-                    sub_calls += gjk.SubCalls();
-                }
-                
-                return sub_calls;
+                GJK_Algorithm_Vectorized<LANE_COUNT,AMB_DIM,Real,Int> gjk ( sub_algorithm );
+                SupportLanes<P_T,LANE_COUNT> P ( P_ );
+                SupportLanes<Q_T,LANE_COUNT> Q ( Q_ );
+
+                gjk.SetAcceleration( accelerated );
+
+                auto jobs = scheduler.GetWorker( thread );
+
+                gjk.Process( jobs, P, Q,
+                    [&]( const Int l, const Int i )
+                    {
+                        P[l].SetPointer( P_serialized_data, i );
+                        Q[l].SetPointer( Q_serialized_data, i );
+
+                        gjk.Load( l, P, Q, true, Scalar::Zero<Real>, Scalar::One<Real>,
+                            warm_start == nullptr ? nullptr : &warm_start[gjk.WarmStartSize() * i]
+                        );
+                    },
+                    [&]( const Int l, const Int i )
+                    {
+                        intersectingQ[i] = !gjk.SeparatedQ(l);
+
+                        if( warm_start != nullptr )
+                        {
+                            gjk.WriteWarmStart( l, &warm_start[gjk.WarmStartSize() * i] );
+                        }
+                    }
+                );
+
+                return gjk.SubCallCount();
             },
             AddReducer<Int, Int>(),
             static_cast<Int>(0),
@@ -57,52 +97,75 @@ namespace GJK
         print("GJK_IntersectingQ_Batch made " + ToString(sub_calls) + " subcalls for n = " + ToString(n) + " primitive pairs.");
         toc("GJK_IntersectingQ_Batch");
     }
-    
-    template<int AMB_DIM, typename Real, typename Int, typename SReal>
+
+    template<typename P_T, typename Q_T, typename Int, typename SReal, typename Real>
     void GJK_SquaredDistances_Batch
     (
-        const Int n,                                      // number of primitive pairs
-        const PrimitiveSerialized<AMB_DIM,Real,Int,SReal> & P_, // prototype primitive
-        SReal * const P_serialized_data,               // matrix of size n x P_.Size()
-        const PrimitiveSerialized<AMB_DIM,Real,Int,SReal> & Q_, // prototype primitive
-        SReal * const Q_serialized_data,               // matrix of size n x P_.Size()
-         Real * const squared_dist,                    // vector of size n for storing the squared distances
-        const Int thread_count = 1
+        const Int n,                                   // number of primitive pairs
+        cref<P_T> P_,                                  // prototype primitive
+        mptr<SReal> P_serialized_data,                 // matrix of size n x P_.Size()
+        cref<Q_T> Q_,                                  // prototype primitive
+        mptr<SReal> Q_serialized_data,                 // matrix of size n x Q_.Size()
+        mptr<Real> squared_dist,                       // vector of size n for storing the squared distances
+        const Int thread_count = 1,
+        mptr<Real> warm_start = nullptr,               // optional warm-start records, one row per pair; see GJK_Batch.hpp
+        const Int chunk_size = GJK_JobScheduler<Int>::DefaultChunkSize, // pairs per chunk of the dynamic schedule; chunk_size <= 0 splits the pairs evenly among the threads instead
+        const GJK_SubAlgorithm sub_algorithm = GJK_SubAlgorithm::Johnson, // distance subalgorithm of the GJK runs; see GJK_SubAlgorithm
+        const bool accelerated = false                 // use the Nesterov-accelerated variant of GJK; see GJK_Algorithm::SetAcceleration
     )
     {
+        constexpr int AMB_DIM = P_T::AmbDim();
+        constexpr int LANE_COUNT = GJK_DefaultLaneCount<Real>();
+
+        static_assert( Q_T::AmbDim() == AMB_DIM, "GJK_SquaredDistances_Batch: Ambient dimensions of primitives do not match." );
+        static_assert( std::is_same_v<typename P_T::Real,Real>, "GJK_SquaredDistances_Batch: Real types of primitives and output do not match." );
+        static_assert( std::is_same_v<typename Q_T::Real,Real>, "GJK_SquaredDistances_Batch: Real types of primitives and output do not match." );
+
         tic("GJK_SquaredDistances_Batch");
 
         valprint("Number of primitive pairs",n);
         valprint("Ambient dimension        ",AMB_DIM);
         valprint("thread_count             ",thread_count);
+        valprint("chunk_size               ",chunk_size);
+        valprint("accelerated              ",accelerated);
         print("First  primitive type     = "+P_.ClassName());
         print("Second primitive type     = "+Q_.ClassName());
 
+        GJK_JobScheduler<Int> scheduler ( Int(0), n, thread_count, chunk_size );
+
         const Int sub_calls = ParallelDoReduce(
             [&]( const Int thread ) -> Int
             {
-                Int sub_calls (0);
-                
-                GJK_Algorithm<AMB_DIM,Real,Int> gjk;
-                std::shared_ptr<PrimitiveSerialized<AMB_DIM,Real,Int,SReal>> P = P_.Clone();
-                std::shared_ptr<PrimitiveSerialized<AMB_DIM,Real,Int,SReal>> Q = Q_.Clone();
-
-                const Int i_begin = JobPointer<Int>( n, thread_count, thread    );
-                const Int i_end   = JobPointer<Int>( n, thread_count, thread +1 );
-                
-                for( Int i = i_begin; i < i_end; ++i )
-                {
-                    //print(\"======================================================\");\ valprint(\" i \",i);
-
-                    P->SetPointer( P_serialized_data, i );
-                    Q->SetPointer( Q_serialized_data, i );
-
-                    squared_dist[i] = gjk.SquaredDistance( *P, *Q );
-                    
-                    sub_calls += gjk.SubCalls();
-                }
-                
-                return sub_calls;
+                GJK_Algorithm_Vectorized<LANE_COUNT,AMB_DIM,Real,Int> gjk ( sub_algorithm );
+                SupportLanes<P_T,LANE_COUNT> P ( P_ );
+                SupportLanes<Q_T,LANE_COUNT> Q ( Q_ );
+
+                gjk.SetAcceleration( accelerated );
+
+                auto jobs = scheduler.GetWorker( thread );
+
+                gjk.Process( jobs, P, Q,
+                    [&]( const Int l, const Int i )
+                    {
+                        P[l].SetPointer( P_serialized_data, i );
+                        Q[l].SetPointer( Q_serialized_data, i );
+
+                        gjk.Load( l, P, Q, false, Scalar::Zero<Real>, Scalar::One<Real>,
+                            warm_start == nullptr ? nullptr : &warm_start[gjk.WarmStartSize() * i]
+                        );
+                    },
+                    [&]( const Int l, const Int i )
+                    {
+                        squared_dist[i] = gjk.LeastSquaredDistance(l);
+
+                        if( warm_start != nullptr )
+                        {
+                            gjk.WriteWarmStart( l, &warm_start[gjk.WarmStartSize() * i] );
+                        }
+                    }
+                );
+
+                return gjk.SubCallCount();
             },
             AddReducer<Int, Int>(),
             static_cast<Int>(0),
@@ -112,51 +175,76 @@ namespace GJK
         print("GJK_SquaredDistances_Batch made " + ToString(sub_calls) + " subcalls for n = " + ToString(n) + " primitive pairs.");
         toc("GJK_SquaredDistances_Batch");
     }
-    
-    template<int AMB_DIM, typename Real, typename Int, typename SReal>
+
+    template<typename P_T, typename Q_T, typename Int, typename SReal, typename Real>
     void GJK_Witnesses_Batch
     (
         const Int n,                                   // number of primitive pairs
-        const PrimitiveSerialized<AMB_DIM,Real,Int,SReal> & P_, // prototype primitive
-        SReal * const P_serialized_data,               // matrix of size n x P_.Size()
-         Real * const x,                               // matrix of size n x AMB_DIM for storing the witnesses in P
-        const PrimitiveSerialized<AMB_DIM,Real,Int,SReal> & Q_, // prototype primitive
-        SReal * const Q_serialized_data,               // matrix of size n x P_.Size()
-         Real * const y,                               // matrix of size n x AMB_DIM for storing the witnesses in P
-        const Int thread_count = 1
+        cref<P_T> P_,                                  // prototype primitive
+        mptr<SReal> P_serialized_data,                 // matrix of size n x P_.Size()
+        mptr<Real> x,                                  // matrix of size n x AMB_DIM for storing the witnesses in P
+        cref<Q_T> Q_,                                  // prototype primitive
+        mptr<SReal> Q_serialized_data,                 // matrix of size n x Q_.Size()
+        mptr<Real> y,                                  // matrix of size n x AMB_DIM for storing the witnesses in Q
+        const Int thread_count = 1,
+        mptr<Real> warm_start = nullptr,               // optional warm-start records, one row per pair; see GJK_Batch.hpp
+        const Int chunk_size = GJK_JobScheduler<Int>::DefaultChunkSize, // pairs per chunk of the dynamic schedule; chunk_size <= 0 splits the pairs evenly among the threads instead
+        const GJK_SubAlgorithm sub_algorithm = GJK_SubAlgorithm::Johnson, // distance subalgorithm of the GJK runs; see GJK_SubAlgorithm
+        const bool accelerated = false                 // use the Nesterov-accelerated variant of GJK; see GJK_Algorithm::SetAcceleration
     )
     {
+        constexpr int AMB_DIM = P_T::AmbDim();
+        constexpr int LANE_COUNT = GJK_DefaultLaneCount<Real>();
+
+        static_assert( Q_T::AmbDim() == AMB_DIM, "GJK_Witnesses_Batch: Ambient dimensions of primitives do not match." );
+        static_assert( std::is_same_v<typename P_T::Real,Real>, "GJK_Witnesses_Batch: Real types of primitives and output do not match." );
+        static_assert( std::is_same_v<typename Q_T::Real,Real>, "GJK_Witnesses_Batch: Real types of primitives and output do not match." );
+
         tic("GJK_Witnesses_Batch");
-        
+
         valprint("Number of primitive pairs",n);
         valprint("Ambient dimension        ",AMB_DIM);
         valprint("thread_count             ",thread_count);
+        valprint("chunk_size               ",chunk_size);
+        valprint("accelerated              ",accelerated);
         print("First  primitive type     = "+P_.ClassName());
         print("Second primitive type     = "+Q_.ClassName());
-        
+
+        GJK_JobScheduler<Int> scheduler ( Int(0), n, thread_count, chunk_size );
+
         const Int sub_calls = ParallelDoReduce(
             [&]( const Int thread ) -> Int
             {
-                Int sub_calls (0);
-                
-                GJK_Algorithm<AMB_DIM,Real,Int> gjk;
-                std::shared_ptr<PrimitiveSerialized<AMB_DIM,Real,Int,SReal>> P = P_.Clone();
-                std::shared_ptr<PrimitiveSerialized<AMB_DIM,Real,Int,SReal>> Q = Q_.Clone();
-
-                const Int i_begin = JobPointer<Int>( n, thread_count, thread    );
-                const Int i_end   = JobPointer<Int>( n, thread_count, thread +1 );
-                
-                for( Int i = i_begin; i < i_end; ++i )
-                {
-                    P->SetPointer( P_serialized_data, i );
-                    Q->SetPointer( Q_serialized_data, i );
-
-                    gjk.Witnesses( *P, x + AMB_DIM * i, *Q, y + AMB_DIM * i );
-                    
-                    sub_calls += gjk.SubCalls();
-                }
-                
-                return sub_calls;
+                GJK_Algorithm_Vectorized<LANE_COUNT,AMB_DIM,Real,Int> gjk ( sub_algorithm );
+                SupportLanes<P_T,LANE_COUNT> P ( P_ );
+                SupportLanes<Q_T,LANE_COUNT> Q ( Q_ );
+
+                gjk.SetAcceleration( accelerated );
+
+                auto jobs = scheduler.GetWorker( thread );
+
+                gjk.Process( jobs, P, Q,
+                    [&]( const Int l, const Int i )
+                    {
+                        P[l].SetPointer( P_serialized_data, i );
+                        Q[l].SetPointer( Q_serialized_data, i );
+
+                        gjk.Load( l, P, Q, false, Scalar::Zero<Real>, Scalar::One<Real>,
+                            warm_start == nullptr ? nullptr : &warm_start[gjk.WarmStartSize() * i]
+                        );
+                    },
+                    [&]( const Int l, const Int i )
+                    {
+                        gjk.WriteWitnesses( l, x + AMB_DIM * i, y + AMB_DIM * i );
+
+                        if( warm_start != nullptr )
+                        {
+                            gjk.WriteWarmStart( l, &warm_start[gjk.WarmStartSize() * i] );
+                        }
+                    }
+                );
+
+                return gjk.SubCallCount();
             },
             AddReducer<Int, Int>(),
             static_cast<Int>(0),
@@ -164,8 +252,157 @@ namespace GJK
         );
 
         print("GJK_Witnesses_Batch made " + ToString(sub_calls) + " subcalls for n = " + ToString(n) + " primitive pairs.");
-        
+
         toc("GJK_Witnesses_Batch");
     }
 
+    // Contact data for n pairs of primitives. For intersecting pairs, GJK is followed by EPA_Algorithm, so depth holds the penetration depth, and translating Q_i by depth[i] * normals_i separates the pair. For separated pairs, depth[i] is minus the distance, and normals_i points from x_i to y_i. In both cases, x_i - y_i = depth[i] * normals_i; see EPA_WriteContact.
+    template<typename P_T, typename Q_T, typename Int, typename SReal, typename Real>
+    void GJK_Penetration_Batch
+    (
+        const Int n,                                   // number of primitive pairs
+        cref<P_T> P_,                                  // prototype primitive
+        mptr<SReal> P_serialized_data,                 // matrix of size n x P_.Size()
+        mptr<Real> x,                                  // matrix of size n x AMB_DIM for storing the witnesses in P
+        cref<Q_T> Q_,                                  // prototype primitive
+        mptr<SReal> Q_serialized_data,                 // matrix of size n x Q_.Size()
+        mptr<Real> y,                                  // matrix of size n x AMB_DIM for storing the witnesses in Q
+        mptr<Real> depth,                              // vector of size n for storing the signed penetration depths
+        mptr<Real> normals,                            // matrix of size n x AMB_DIM for storing the unit contact normals
+        const Int thread_count = 1,
+        mptr<Real> warm_start = nullptr,               // optional warm-start records, one row per pair; see GJK_Batch.hpp
+        const Int chunk_size = GJK_JobScheduler<Int>::DefaultChunkSize, // pairs per chunk of the dynamic schedule; chunk_size <= 0 splits the pairs evenly among the threads instead
+        const GJK_SubAlgorithm sub_algorithm = GJK_SubAlgorithm::Johnson, // distance subalgorithm of the GJK runs; see GJK_SubAlgorithm
+        const bool accelerated = false                 // use the Nesterov-accelerated variant of GJK; see GJK_Algorithm::SetAcceleration
+    )
+    {
+        constexpr int AMB_DIM = P_T::AmbDim();
+        constexpr int LANE_COUNT = GJK_DefaultLaneCount<Real>();
+
+        static_assert( Q_T::AmbDim() == AMB_DIM, "GJK_Penetration_Batch: Ambient dimensions of primitives do not match." );
+        static_assert( std::is_same_v<typename P_T::Real,Real>, "GJK_Penetration_Batch: Real types of primitives and output do not match." );
+        static_assert( std::is_same_v<typename Q_T::Real,Real>, "GJK_Penetration_Batch: Real types of primitives and output do not match." );
+
+        tic("GJK_Penetration_Batch");
+
+        valprint("Number of primitive pairs",n);
+        valprint("Ambient dimension        ",AMB_DIM);
+        valprint("thread_count             ",thread_count);
+        valprint("chunk_size               ",chunk_size);
+        valprint("accelerated              ",accelerated);
+        print("First  primitive type     = "+P_.ClassName());
+        print("Second primitive type     = "+Q_.ClassName());
+
+        GJK_JobScheduler<Int> scheduler ( Int(0), n, thread_count, chunk_size );
+
+        const Int sub_calls = ParallelDoReduce(
+            [&]( const Int thread ) -> Int
+            {
+                GJK_Algorithm_Vectorized<LANE_COUNT,AMB_DIM,Real,Int> gjk ( sub_algorithm );
+                SupportLanes<P_T,LANE_COUNT> P ( P_ );
+                SupportLanes<Q_T,LANE_COUNT> Q ( Q_ );
+
+                gjk.SetAcceleration( accelerated );
+
+                // EPA_Algorithm is too large for the stack.
+                auto epa = std::make_unique<EPA_Algorithm<AMB_DIM,Real,Int>>();
+
+                auto jobs = scheduler.GetWorker( thread );
+
+                gjk.Process( jobs, P, Q,
+                    [&]( const Int l, const Int i )
+                    {
+                        P[l].SetPointer( P_serialized_data, i );
+                        Q[l].SetPointer( Q_serialized_data, i );
+
+                        gjk.Load( l, P, Q, false, Scalar::Zero<Real>, Scalar::One<Real>,
+                            warm_start == nullptr ? nullptr : &warm_start[gjk.WarmStartSize() * i]
+                        );
+                    },
+                    [&]( const Int l, const Int i )
+                    {
+                        depth[i] = EPA_WriteContact( gjk, l, *epa, P[l], Q[l],
+                            normals + AMB_DIM * i, x + AMB_DIM * i, y + AMB_DIM * i
+                        );
+
+                        if( warm_start != nullptr )
+                        {
+                            gjk.WriteWarmStart( l, &warm_start[gjk.WarmStartSize() * i] );
+                        }
+                    }
+                );
+
+                return gjk.SubCallCount();
+            },
+            AddReducer<Int, Int>(),
+            static_cast<Int>(0),
+            thread_count
+        );
+
+        print("GJK_Penetration_Batch made " + ToString(sub_calls) + " subcalls for n = " + ToString(n) + " primitive pairs.");
+
+        toc("GJK_Penetration_Batch");
+    }
+
+
+    // Overloads with explicit template parameters for backward compatibility. These use virtual dispatch.
+
+    template<int AMB_DIM, typename Real, typename Int, typename SReal>
+    void GJK_IntersectingQ_Batch
+    (
+        const Int n,
+        const PrimitiveSerialized<AMB_DIM,Real,Int,SReal> & P_,
+        SReal * const P_serialized_data,
+        const PrimitiveSerialized<AMB_DIM,Real,Int,SReal> & Q_,
+        SReal * const Q_serialized_data,
+          Int * const intersectingQ,
+        const Int thread_count = 1
+    )
+    {
+        using Primitive_T = PrimitiveSerialized<AMB_DIM,Real,Int,SReal>;
+
+        GJK_IntersectingQ_Batch<Primitive_T,Primitive_T>(
+            n, P_, P_serialized_data, Q_, Q_serialized_data, intersectingQ, thread_count
+        );
+    }
+
+    template<int AMB_DIM, typename Real, typename Int, typename SReal>
+    void GJK_SquaredDistances_Batch
+    (
+        const Int n,
+        const PrimitiveSerialized<AMB_DIM,Real,Int,SReal> & P_,
+        SReal * const P_serialized_data,
+        const PrimitiveSerialized<AMB_DIM,Real,Int,SReal> & Q_,
+        SReal * const Q_serialized_data,
+         Real * const squared_dist,
+        const Int thread_count = 1
+    )
+    {
+        using Primitive_T = PrimitiveSerialized<AMB_DIM,Real,Int,SReal>;
+
+        GJK_SquaredDistances_Batch<Primitive_T,Primitive_T>(
+            n, P_, P_serialized_data, Q_, Q_serialized_data, squared_dist, thread_count
+        );
+    }
+
+    template<int AMB_DIM, typename Real, typename Int, typename SReal>
+    void GJK_Witnesses_Batch
+    (
+        const Int n,
+        const PrimitiveSerialized<AMB_DIM,Real,Int,SReal> & P_,
+        SReal * const P_serialized_data,
+         Real * const x,
+        const PrimitiveSerialized<AMB_DIM,Real,Int,SReal> & Q_,
+        SReal * const Q_serialized_data,
+         Real * const y,
+        const Int thread_count = 1
+    )
+    {
+        using Primitive_T = PrimitiveSerialized<AMB_DIM,Real,Int,SReal>;
+
+        GJK_Witnesses_Batch<Primitive_T,Primitive_T>(
+            n, P_, P_serialized_data, x, Q_, Q_serialized_data, y, thread_count
+        );
+    }
+
 } // namespe GJK
@@ -0,0 +1,632 @@
+#pragma once
+
+namespace GJK
+{
+    // Batch routines for pairs of primitives that are given by indices into two arrays of serialized primitives.
+    //
+    // The routines in GJK_Batch.hpp expect one row of P_serialized_data and Q_serialized_data per pair, so every primitive that takes part in several pairs has to be copied once per pair. Here, the primitives are stored only once, and each lane of GJK_Algorithm_Vectorized is pointed directly at rows i and j via SetPointer.
+    //
+    // GJK_Indexed_*_Batch take a list of pairs, i.e., a matrix of size pair_count x 2; the results are stored per pair.
+    // GJK_CSR_*_Batch take a sparse matrix in CSR format whose nonzero pattern is the set of pairs: row i of the pattern lists the primitives j of Q to be tested against primitive i of P. The results are stored per nonzero, i.e., in the order of col_idx. Here, the dynamic schedule hands out chunks of rows.
+    //
+    // See GJK_Batch.hpp for the template parameters P_T and Q_T and for the use of GJK_Algorithm_Vectorized.
+
+    // Job source for GJK_Algorithm_Vectorized::Process that runs over the nonzeros of a CSR pattern, row by row.
+    template<typename Int>
+    class GJK_CSR_Jobs
+    {
+    protected:
+
+        typename GJK_JobScheduler<Int>::Worker worker;
+
+        cptr<Int> rp;
+
+        Int row   = 0;
+        Int k     = 0;
+        Int k_end = 0;
+
+    public:
+
+        GJK_CSR_Jobs( mref<GJK_JobScheduler<Int>> scheduler, const Int thread, cptr<Int> rp_ )
+        :   worker ( scheduler.GetWorker( thread ) )
+        ,   rp     ( rp_                           )
+        {}
+
+        // Writes the index of the next nonzero to k_out; returns false if there is no work left for this thread.
+        bool Next( mref<Int> k_out )
+        {
+            while( k >= k_end )
+            {
+                if( !worker.Next( row ) )
+                {
+                    return false;
+                }
+
+                k     = rp[row    ];
+                k_end = rp[row + 1];
+            }
+
+            k_out = k;
+            ++k;
+
+            return true;
+        }
+
+        // Row of the nonzero that was returned last by Next.
+        Int CurrentRow() const
+        {
+            return row;
+        }
+
+    }; // GJK_CSR_Jobs
+
+
+    template<typename P_T, typename Q_T, typename Int, typename SReal>
+    void GJK_Indexed_IntersectingQ_Batch
+    (
+        const Int pair_count,                          // number of primitive pairs
+        cptr<Int> pairs,                               // matrix of size pair_count x 2; row k holds the indices (i,j) of the k-th pair
+        cref<P_T> P_,                                  // prototype primitive
+        mptr<SReal> P_serialized_data,                 // matrix of size m x P_.Size(), where m > all i
+        cref<Q_T> Q_,                                  // prototype primitive
+        mptr<SReal> Q_serialized_data,                 // matrix of size n x Q_.Size(), where n > all j
+        mptr<Int> intersectingQ,                       // vector of size pair_count for storing the results
+        const Int thread_count = 1,
+        mptr<typename P_T::Real> warm_start = nullptr, // optional warm-start records, one row per pair; see GJK_Batch.hpp
+        const Int chunk_size = GJK_JobScheduler<Int>::DefaultChunkSize, // pairs per chunk of the dynamic schedule; chunk_size <= 0 splits the pairs evenly among the threads instead
+        const GJK_SubAlgorithm sub_algorithm = GJK_SubAlgorithm::Johnson, // distance subalgorithm of the GJK runs; see GJK_SubAlgorithm
+        const bool accelerated = false                 // use the Nesterov-accelerated variant of GJK; see GJK_Algorithm::SetAcceleration
+    )
+    {
+        constexpr int AMB_DIM = P_T::AmbDim();
+        using Real = typename P_T::Real;
+        constexpr int LANE_COUNT = GJK_DefaultLaneCount<Real>();
+
+        static_assert( Q_T::AmbDim() == AMB_DIM, "GJK_Indexed_IntersectingQ_Batch: Ambient dimensions of primitives do not match." );
+        static_assert( std::is_same_v<typename Q_T::Real,Real>, "GJK_Indexed_IntersectingQ_Batch: Real types of primitives do not match." );
+
+        tic("GJK_Indexed_IntersectingQ_Batch");
+
+        valprint("Number of primitive pairs",pair_count);
+        valprint("Ambient dimension        ",AMB_DIM);
+        valprint("thread_count             ",thread_count);
+        valprint("chunk_size               ",chunk_size);
+        valprint("accelerated              ",accelerated);
+        print("First  primitive type     = "+P_.ClassName());
+        print("Second primitive type     = "+Q_.ClassName());
+
+        GJK_JobScheduler<Int> scheduler ( Int(0), pair_count, thread_count, chunk_size );
+
+        const Int sub_calls = ParallelDoReduce(
+            [&]( const Int thread ) -> Int
+            {
+                GJK_Algorithm_Vectorized<LANE_COUNT,AMB_DIM,Real,Int> gjk ( sub_algorithm );
+                SupportLanes<P_T,LANE_COUNT> P ( P_ );
+                SupportLanes<Q_T,LANE_COUNT> Q ( Q_ );
+
+                gjk.SetAcceleration( accelerated );
+
+                auto jobs = scheduler.GetWorker( thread );
+
+                gjk.Process( jobs, P, Q,
+                    [&]( const Int l, const Int k )
+                    {
+                        P[l].SetPointer( P_serialized_data, pairs[2 * k    ] );
+                        Q[l].SetPointer( Q_serialized_data, pairs[2 * k + 1] );
+
+                        gjk.Load( l, P, Q, true, Scalar::Zero<Real>, Scalar::One<Real>,
+                            warm_start == nullptr ? nullptr : &warm_start[gjk.WarmStartSize() * k]
+                        );
+                    },
+                    [&]( const Int l, const Int k )
+                    {
+                        intersectingQ[k] = !gjk.SeparatedQ(l);
+
+                        if( warm_start != nullptr )
+                        {
+                            gjk.WriteWarmStart( l, &warm_start[gjk.WarmStartSize() * k] );
+                        }
+                    }
+                );
+
+                return gjk.SubCallCount();
+            },
+            AddReducer<Int, Int>(),
+            static_cast<Int>(0),
+            thread_count
+        );
+
+        print("GJK_Indexed_IntersectingQ_Batch made " + ToString(sub_calls) + " subcalls for n = " + ToString(pair_count) + " primitive pairs.");
+        toc("GJK_Indexed_IntersectingQ_Batch");
+    }
+
+    template<typename P_T, typename Q_T, typename Int, typename SReal, typename Real>
+    void GJK_Indexed_SquaredDistances_Batch
+    (
+        const Int pair_count,                          // number of primitive pairs
+        cptr<Int> pairs,                               // matrix of size pair_count x 2; row k holds the indices (i,j) of the k-th pair
+        cref<P_T> P_,                                  // prototype primitive
+        mptr<SReal> P_serialized_data,                 // matrix of size m x P_.Size(), where m > all i
+        cref<Q_T> Q_,                                  // prototype primitive
+        mptr<SReal> Q_serialized_data,                 // matrix of size n x Q_.Size(), where n > all j
+        mptr<Real> squared_dist,                       // vector of size pair_count for storing the squared distances
+        const Int thread_count = 1,
+        mptr<Real> warm_start = nullptr,               // optional warm-start records, one row per pair; see GJK_Batch.hpp
+        const Int chunk_size = GJK_JobScheduler<Int>::DefaultChunkSize, // pairs per chunk of the dynamic schedule; chunk_size <= 0 splits the pairs evenly among the threads instead
+        const GJK_SubAlgorithm sub_algorithm = GJK_SubAlgorithm::Johnson, // distance subalgorithm of the GJK runs; see GJK_SubAlgorithm
+        const bool accelerated = false                 // use the Nesterov-accelerated variant of GJK; see GJK_Algorithm::SetAcceleration
+    )
+    {
+        constexpr int AMB_DIM = P_T::AmbDim();
+        constexpr int LANE_COUNT = GJK_DefaultLaneCount<Real>();
+
+        static_assert( Q_T::AmbDim() == AMB_DIM, "GJK_Indexed_SquaredDistances_Batch: Ambient dimensions of primitives do not match." );
+        static_assert( std::is_same_v<typename P_T::Real,Real>, "GJK_Indexed_SquaredDistances_Batch: Real types of primitives and output do not match." );
+        static_assert( std::is_same_v<typename Q_T::Real,Real>, "GJK_Indexed_SquaredDistances_Batch: Real types of primitives and output do not match." );
+
+        tic("GJK_Indexed_SquaredDistances_Batch");
+
+        valprint("Number of primitive pairs",pair_count);
+        valprint("Ambient dimension        ",AMB_DIM);
+        valprint("thread_count             ",thread_count);
+        valprint("chunk_size               ",chunk_size);
+        valprint("accelerated              ",accelerated);
+        print("First  primitive type     = "+P_.ClassName());
+        print("Second primitive type     = "+Q_.ClassName());
+
+        GJK_JobScheduler<Int> scheduler ( Int(0), pair_count, thread_count, chunk_size );
+
+        const Int sub_calls = ParallelDoReduce(
+            [&]( const Int thread ) -> Int
+            {
+                GJK_Algorithm_Vectorized<LANE_COUNT,AMB_DIM,Real,Int> gjk ( sub_algorithm );
+                SupportLanes<P_T,LANE_COUNT> P ( P_ );
+                SupportLanes<Q_T,LANE_COUNT> Q ( Q_ );
+
+                gjk.SetAcceleration( accelerated );
+
+                auto jobs = scheduler.GetWorker( thread );
+
+                gjk.Process( jobs, P, Q,
+                    [&]( const Int l, const Int k )
+                    {
+                        P[l].SetPointer( P_serialized_data, pairs[2 * k    ] );
+                        Q[l].SetPointer( Q_serialized_data, pairs[2 * k + 1] );
+
+                        gjk.Load( l, P, Q, false, Scalar::Zero<Real>, Scalar::One<Real>,
+                            warm_start == nullptr ? nullptr : &warm_start[gjk.WarmStartSize() * k]
+                        );
+                    },
+                    [&]( const Int l, const Int k )
+                    {
+                        squared_dist[k] = gjk.LeastSquaredDistance(l);
+
+                        if( warm_start != nullptr )
+                        {
+                            gjk.WriteWarmStart( l, &warm_start[gjk.WarmStartSize() * k] );
+                        }
+                    }
+                );
+
+                return gjk.SubCallCount();
+            },
+            AddReducer<Int, Int>(),
+            static_cast<Int>(0),
+            thread_count
+        );
+
+        print("GJK_Indexed_SquaredDistances_Batch made " + ToString(sub_calls) + " subcalls for n = " + ToString(pair_count) + " primitive pairs.");
+        toc("GJK_Indexed_SquaredDistances_Batch");
+    }
+
+    template<typename P_T, typename Q_T, typename Int, typename SReal, typename Real>
+    void GJK_Indexed_Witnesses_Batch
+    (
+        const Int pair_count,                          // number of primitive pairs
+        cptr<Int> pairs,                               // matrix of size pair_count x 2; row k holds the indices (i,j) of the k-th pair
+        cref<P_T> P_,                                  // prototype primitive
+        mptr<SReal> P_serialized_data,                 // matrix of size m x P_.Size(), where m > all i
+        mptr<Real> x,                                  // matrix of size pair_count x AMB_DIM for storing the witnesses in P
+        cref<Q_T> Q_,                                  // prototype primitive
+        mptr<SReal> Q_serialized_data,                 // matrix of size n x Q_.Size(), where n > all j
+        mptr<Real> y,                                  // matrix of size pair_count x AMB_DIM for storing the witnesses in Q
+        const Int thread_count = 1,
+        mptr<Real> warm_start = nullptr,               // optional warm-start records, one row per pair; see GJK_Batch.hpp
+        const Int chunk_size = GJK_JobScheduler<Int>::DefaultChunkSize, // pairs per chunk of the dynamic schedule; chunk_size <= 0 splits the pairs evenly among the threads instead
+        const GJK_SubAlgorithm sub_algorithm = GJK_SubAlgorithm::Johnson, // distance subalgorithm of the GJK runs; see GJK_SubAlgorithm
+        const bool accelerated = false                 // use the Nesterov-accelerated variant of GJK; see GJK_Algorithm::SetAcceleration
+    )
+    {
+        constexpr int AMB_DIM = P_T::AmbDim();
+        constexpr int LANE_COUNT = GJK_DefaultLaneCount<Real>();
+
+        static_assert( Q_T::AmbDim() == AMB_DIM, "GJK_Indexed_Witnesses_Batch: Ambient dimensions of primitives do not match." );
+        static_assert( std::is_same_v<typename P_T::Real,Real>, "GJK_Indexed_Witnesses_Batch: Real types of primitives and output do not match." );
+        static_assert( std::is_same_v<typename Q_T::Real,Real>, "GJK_Indexed_Witnesses_Batch: Real types of primitives and output do not match." );
+
+        tic("GJK_Indexed_Witnesses_Batch");
+
+        valprint("Number of primitive pairs",pair_count);
+        valprint("Ambient dimension        ",AMB_DIM);
+        valprint("thread_count             ",thread_count);
+        valprint("chunk_size               ",chunk_size);
+        valprint("accelerated              ",accelerated);
+        print("First  primitive type     = "+P_.ClassName());
+        print("Second primitive type     = "+Q_.ClassName());
+
+        GJK_JobScheduler<Int> scheduler ( Int(0), pair_count, thread_count, chunk_size );
+
+        const Int sub_calls = ParallelDoReduce(
+            [&]( const Int thread ) -> Int
+            {
+                GJK_Algorithm_Vectorized<LANE_COUNT,AMB_DIM,Real,Int> gjk ( sub_algorithm );
+                SupportLanes<P_T,LANE_COUNT> P ( P_ );
+                SupportLanes<Q_T,LANE_COUNT> Q ( Q_ );
+
+                gjk.SetAcceleration( accelerated );
+
+                auto jobs = scheduler.GetWorker( thread );
+
+                gjk.Process( jobs, P, Q,
+                    [&]( const Int l, const Int k )
+                    {
+                        P[l].SetPointer( P_serialized_data, pairs[2 * k    ] );
+                        Q[l].SetPointer( Q_serialized_data, pairs[2 * k + 1] );
+
+                        gjk.Load( l, P, Q, false, Scalar::Zero<Real>, Scalar::One<Real>,
+                            warm_start == nullptr ? nullptr : &warm_start[gjk.WarmStartSize() * k]
+                        );
+                    },
+                    [&]( const Int l, const Int k )
+                    {
+                        gjk.WriteWitnesses( l, x + AMB_DIM * k, y + AMB_DIM * k );
+
+                        if( warm_start != nullptr )
+                        {
+                            gjk.WriteWarmStart( l, &warm_start[gjk.WarmStartSize() * k] );
+                        }
+                    }
+                );
+
+                return gjk.SubCallCount();
+            },
+            AddReducer<Int, Int>(),
+            static_cast<Int>(0),
+            thread_count
+        );
+
+        print("GJK_Indexed_Witnesses_Batch made " + ToString(sub_calls) + " subcalls for n = " + ToString(pair_count) + " primitive pairs.");
+        toc("GJK_Indexed_Witnesses_Batch");
+    }
+
+    // Same as GJK_Penetration_Batch, but for the pairs of indices in pairs.
+    template<typename P_T, typename Q_T, typename Int, typename SReal, typename Real>
+    void GJK_Indexed_Penetration_Batch
+    (
+        const Int pair_count,                          // number of primitive pairs
+        cptr<Int> pairs,                               // matrix of size pair_count x 2; row k holds the indices (i,j) of the k-th pair
+        cref<P_T> P_,                                  // prototype primitive
+        mptr<SReal> P_serialized_data,                 // matrix of size m x P_.Size(), where m > all i
+        mptr<Real> x,                                  // matrix of size pair_count x AMB_DIM for storing the witnesses in P
+        cref<Q_T> Q_,                                  // prototype primitive
+        mptr<SReal> Q_serialized_data,                 // matrix of size n x Q_.Size(), where n > all j
+        mptr<Real> y,                                  // matrix of size pair_count x AMB_DIM for storing the witnesses in Q
+        mptr<Real> depth,                              // vector of size pair_count for storing the signed penetration depths
+        mptr<Real> normals,                            // matrix of size pair_count x AMB_DIM for storing the unit contact normals
+        const Int thread_count = 1,
+        mptr<Real> warm_start = nullptr,               // optional warm-start records, one row per pair; see GJK_Batch.hpp
+        const Int chunk_size = GJK_JobScheduler<Int>::DefaultChunkSize, // pairs per chunk of the dynamic schedule; chunk_size <= 0 splits the pairs evenly among the threads instead
+        const GJK_SubAlgorithm sub_algorithm = GJK_SubAlgorithm::Johnson, // distance subalgorithm of the GJK runs; see GJK_SubAlgorithm
+        const bool accelerated = false                 // use the Nesterov-accelerated variant of GJK; see GJK_Algorithm::SetAcceleration
+    )
+    {
+        constexpr int AMB_DIM = P_T::AmbDim();
+        constexpr int LANE_COUNT = GJK_DefaultLaneCount<Real>();
+
+        static_assert( Q_T::AmbDim() == AMB_DIM, "GJK_Indexed_Penetration_Batch: Ambient dimensions of primitives do not match." );
+        static_assert( std::is_same_v<typename P_T::Real,Real>, "GJK_Indexed_Penetration_Batch: Real types of primitives and output do not match." );
+        static_assert( std::is_same_v<typename Q_T::Real,Real>, "GJK_Indexed_Penetration_Batch: Real types of primitives and output do not match." );
+
+        tic("GJK_Indexed_Penetration_Batch");
+
+        valprint("Number of primitive pairs",pair_count);
+        valprint("Ambient dimension        ",AMB_DIM);
+        valprint("thread_count             ",thread_count);
+        valprint("chunk_size               ",chunk_size);
+        valprint("accelerated              ",accelerated);
+        print("First  primitive type     = "+P_.ClassName());
+        print("Second primitive type     = "+Q_.ClassName());
+
+        GJK_JobScheduler<Int> scheduler ( Int(0), pair_count, thread_count, chunk_size );
+
+        const Int sub_calls = ParallelDoReduce(
+            [&]( const Int thread ) -> Int
+            {
+                GJK_Algorithm_Vectorized<LANE_COUNT,AMB_DIM,Real,Int> gjk ( sub_algorithm );
+                SupportLanes<P_T,LANE_COUNT> P ( P_ );
+                SupportLanes<Q_T,LANE_COUNT> Q ( Q_ );
+
+                gjk.SetAcceleration( accelerated );
+
+                // EPA_Algorithm is too large for the stack.
+                auto epa = std::make_unique<EPA_Algorithm<AMB_DIM,Real,Int>>();
+
+                auto jobs = scheduler.GetWorker( thread );
+
+                gjk.Process( jobs, P, Q,
+                    [&]( const Int l, const Int k )
+                    {
+                        P[l].SetPointer( P_serialized_data, pairs[2 * k    ] );
+                        Q[l].SetPointer( Q_serialized_data, pairs[2 * k + 1] );
+
+                        gjk.Load( l, P, Q, false, Scalar::Zero<Real>, Scalar::One<Real>,
+                            warm_start == nullptr ? nullptr : &warm_start[gjk.WarmStartSize() * k]
+                        );
+                    },
+                    [&]( const Int l, const Int k )
+                    {
+                        depth[k] = EPA_WriteContact( gjk, l, *epa, P[l], Q[l],
+                            normals + AMB_DIM * k, x + AMB_DIM * k, y + AMB_DIM * k
+                        );
+
+                        if( warm_start != nullptr )
+                        {
+                            gjk.WriteWarmStart( l, &warm_start[gjk.WarmStartSize() * k] );
+                        }
+                    }
+                );
+
+                return gjk.SubCallCount();
+            },
+            AddReducer<Int, Int>(),
+            static_cast<Int>(0),
+            thread_count
+        );
+
+        print("GJK_Indexed_Penetration_Batch made " + ToString(sub_calls) + " subcalls for n = " + ToString(pair_count) + " primitive pairs.");
+        toc("GJK_Indexed_Penetration_Batch");
+    }
+
+
+    template<typename P_T, typename Q_T, typename Int, typename SReal>
+    void GJK_CSR_IntersectingQ_Batch
+    (
+        const Int row_count,                           // number of rows of the pattern
+        cptr<Int> rp,                                  // row pointers of the pattern; vector of size row_count + 1
+        cptr<Int> ci,                                  // column indices of the pattern; vector of size rp[row_count]
+        cref<P_T> P_,                                  // prototype primitive
+        mptr<SReal> P_serialized_data,                 // matrix of size row_count x P_.Size()
+        cref<Q_T> Q_,                                  // prototype primitive
+        mptr<SReal> Q_serialized_data,                 // matrix of size n x Q_.Size(), where n > all column indices
+        mptr<Int> intersectingQ,                       // vector of size rp[row_count] for storing the results
+        const Int thread_count = 1,
+        mptr<typename P_T::Real> warm_start = nullptr, // optional warm-start records, one row per pair; see GJK_Batch.hpp
+        const Int chunk_size = GJK_JobScheduler<Int>::DefaultChunkSize, // rows per chunk of the dynamic schedule; chunk_size <= 0 splits the rows evenly among the threads instead
+        const GJK_SubAlgorithm sub_algorithm = GJK_SubAlgorithm::Johnson, // distance subalgorithm of the GJK runs; see GJK_SubAlgorithm
+        const bool accelerated = false                 // use the Nesterov-accelerated variant of GJK; see GJK_Algorithm::SetAcceleration
+    )
+    {
+        constexpr int AMB_DIM = P_T::AmbDim();
+        using Real = typename P_T::Real;
+        constexpr int LANE_COUNT = GJK_DefaultLaneCount<Real>();
+
+        static_assert( Q_T::AmbDim() == AMB_DIM, "GJK_CSR_IntersectingQ_Batch: Ambient dimensions of primitives do not match." );
+        static_assert( std::is_same_v<typename Q_T::Real,Real>, "GJK_CSR_IntersectingQ_Batch: Real types of primitives do not match." );
+
+        tic("GJK_CSR_IntersectingQ_Batch");
+
+        valprint("Number of primitive pairs",rp[row_count]);
+        valprint("Ambient dimension        ",AMB_DIM);
+        valprint("thread_count             ",thread_count);
+        valprint("chunk_size               ",chunk_size);
+        valprint("accelerated              ",accelerated);
+        print("First  primitive type     = "+P_.ClassName());
+        print("Second primitive type     = "+Q_.ClassName());
+
+        GJK_JobScheduler<Int> scheduler ( Int(0), row_count, thread_count, chunk_size );
+
+        const Int sub_calls = ParallelDoReduce(
+            [&]( const Int thread ) -> Int
+            {
+                GJK_Algorithm_Vectorized<LANE_COUNT,AMB_DIM,Real,Int> gjk ( sub_algorithm );
+                SupportLanes<P_T,LANE_COUNT> P ( P_ );
+                SupportLanes<Q_T,LANE_COUNT> Q ( Q_ );
+
+                gjk.SetAcceleration( accelerated );
+
+                GJK_CSR_Jobs<Int> jobs ( scheduler, thread, rp );
+
+                gjk.Process( jobs, P, Q,
+                    [&]( const Int l, const Int k )
+                    {
+                        P[l].SetPointer( P_serialized_data, jobs.CurrentRow() );
+                        Q[l].SetPointer( Q_serialized_data, ci[k] );
+
+                        gjk.Load( l, P, Q, true, Scalar::Zero<Real>, Scalar::One<Real>,
+                            warm_start == nullptr ? nullptr : &warm_start[gjk.WarmStartSize() * k]
+                        );
+                    },
+                    [&]( const Int l, const Int k )
+                    {
+                        intersectingQ[k] = !gjk.SeparatedQ(l);
+
+                        if( warm_start != nullptr )
+                        {
+                            gjk.WriteWarmStart( l, &warm_start[gjk.WarmStartSize() * k] );
+                        }
+                    }
+                );
+
+                return gjk.SubCallCount();
+            },
+            AddReducer<Int, Int>(),
+            static_cast<Int>(0),
+            thread_count
+        );
+
+        print("GJK_CSR_IntersectingQ_Batch made " + ToString(sub_calls) + " subcalls for n = " + ToString(rp[row_count]) + " primitive pairs.");
+        toc("GJK_CSR_IntersectingQ_Batch");
+    }
+
+    template<typename P_T, typename Q_T, typename Int, typename SReal, typename Real>
+    void GJK_CSR_SquaredDistances_Batch
+    (
+        const Int row_count,                           // number of rows of the pattern
+        cptr<Int> rp,                                  // row pointers of the pattern; vector of size row_count + 1
+        cptr<Int> ci,                                  // column indices of the pattern; vector of size rp[row_count]
+        cref<P_T> P_,                                  // prototype primitive
+        mptr<SReal> P_serialized_data,                 // matrix of size row_count x P_.Size()
+        cref<Q_T> Q_,                                  // prototype primitive
+        mptr<SReal> Q_serialized_data,                 // matrix of size n x Q_.Size(), where n > all column indices
+        mptr<Real> squared_dist,                       // vector of size rp[row_count] for storing the squared distances
+        const Int thread_count = 1,
+        mptr<Real> warm_start = nullptr,               // optional warm-start records, one row per pair; see GJK_Batch.hpp
+        const Int chunk_size = GJK_JobScheduler<Int>::DefaultChunkSize, // rows per chunk of the dynamic schedule; chunk_size <= 0 splits the rows evenly among the threads instead
+        const GJK_SubAlgorithm sub_algorithm = GJK_SubAlgorithm::Johnson, // distance subalgorithm of the GJK runs; see GJK_SubAlgorithm
+        const bool accelerated = false                 // use the Nesterov-accelerated variant of GJK; see GJK_Algorithm::SetAcceleration
+    )
+    {
+        constexpr int AMB_DIM = P_T::AmbDim();
+        constexpr int LANE_COUNT = GJK_DefaultLaneCount<Real>();
+
+        static_assert( Q_T::AmbDim() == AMB_DIM, "GJK_CSR_SquaredDistances_Batch: Ambient dimensions of primitives do not match." );
+        static_assert( std::is_same_v<typename P_T::Real,Real>, "GJK_CSR_SquaredDistances_Batch: Real types of primitives and output do not match." );
+        static_assert( std::is_same_v<typename Q_T::Real,Real>, "GJK_CSR_SquaredDistances_Batch: Real types of primitives and output do not match." );
+
+        tic("GJK_CSR_SquaredDistances_Batch");
+
+        valprint("Number of primitive pairs",rp[row_count]);
+        valprint("Ambient dimension        ",AMB_DIM);
+        valprint("thread_count             ",thread_count);
+        valprint("chunk_size               ",chunk_size);
+        valprint("accelerated              ",accelerated);
+        print("First  primitive type     = "+P_.ClassName());
+        print("Second primitive type     = "+Q_.ClassName());
+
+        GJK_JobScheduler<Int> scheduler ( Int(0), row_count, thread_count, chunk_size );
+
+        const Int sub_calls = ParallelDoReduce(
+            [&]( const Int thread ) -> Int
+            {
+                GJK_Algorithm_Vectorized<LANE_COUNT,AMB_DIM,Real,Int> gjk ( sub_algorithm );
+                SupportLanes<P_T,LANE_COUNT> P ( P_ );
+                SupportLanes<Q_T,LANE_COUNT> Q ( Q_ );
+
+                gjk.SetAcceleration( accelerated );
+
+                GJK_CSR_Jobs<Int> jobs ( scheduler, thread, rp );
+
+                gjk.Process( jobs, P, Q,
+                    [&]( const Int l, const Int k )
+                    {
+                        P[l].SetPointer( P_serialized_data, jobs.CurrentRow() );
+                        Q[l].SetPointer( Q_serialized_data, ci[k] );
+
+                        gjk.Load( l, P, Q, false, Scalar::Zero<Real>, Scalar::One<Real>,
+                            warm_start == nullptr ? nullptr : &warm_start[gjk.WarmStartSize() * k]
+                        );
+                    },
+                    [&]( const Int l, const Int k )
+                    {
+                        squared_dist[k] = gjk.LeastSquaredDistance(l);
+
+                        if( warm_start != nullptr )
+                        {
+                            gjk.WriteWarmStart( l, &warm_start[gjk.WarmStartSize() * k] );
+                        }
+                    }
+                );
+
+                return gjk.SubCallCount();
+            },
+            AddReducer<Int, Int>(),
+            static_cast<Int>(0),
+            thread_count
+        );
+
+        print("GJK_CSR_SquaredDistances_Batch made " + ToString(sub_calls) + " subcalls for n = " + ToString(rp[row_count]) + " primitive pairs.");
+        toc("GJK_CSR_SquaredDistances_Batch");
+    }
+
+    template<typename P_T, typename Q_T, typename Int, typename SReal, typename Real>
+    void GJK_CSR_Witnesses_Batch
+    (
+        const Int row_count,                           // number of rows of the pattern
+        cptr<Int> rp,                                  // row pointers of the pattern; vector of size row_count + 1
+        cptr<Int> ci,                                  // column indices of the pattern; vector of size rp[row_count]
+        cref<P_T> P_,                                  // prototype primitive
+        mptr<SReal> P_serialized_data,                 // matrix of size row_count x P_.Size()
+        mptr<Real> x,                                  // matrix of size rp[row_count] x AMB_DIM for storing the witnesses in P
+        cref<Q_T> Q_,                                  // prototype primitive
+        mptr<SReal> Q_serialized_data,                 // matrix of size n x Q_.Size(), where n > all column indices
+        mptr<Real> y,                                  // matrix of size rp[row_count] x AMB_DIM for storing the witnesses in Q
+        const Int thread_count = 1,
+        mptr<Real> warm_start = nullptr,               // optional warm-start records, one row per pair; see GJK_Batch.hpp
+        const Int chunk_size = GJK_JobScheduler<Int>::DefaultChunkSize, // rows per chunk of the dynamic schedule; chunk_size <= 0 splits the rows evenly among the threads instead
+        const GJK_SubAlgorithm sub_algorithm = GJK_SubAlgorithm::Johnson, // distance subalgorithm of the GJK runs; see GJK_SubAlgorithm
+        const bool accelerated = false                 // use the Nesterov-accelerated variant of GJK; see GJK_Algorithm::SetAcceleration
+    )
+    {
+        constexpr int AMB_DIM = P_T::AmbDim();
+        constexpr int LANE_COUNT = GJK_DefaultLaneCount<Real>();
+
+        static_assert( Q_T::AmbDim() == AMB_DIM, "GJK_CSR_Witnesses_Batch: Ambient dimensions of primitives do not match." );
+        static_assert( std::is_same_v<typename P_T::Real,Real>, "GJK_CSR_Witnesses_Batch: Real types of primitives and output do not match." );
+        static_assert( std::is_same_v<typename Q_T::Real,Real>, "GJK_CSR_Witnesses_Batch: Real types of primitives and output do not match." );
+
+        tic("GJK_CSR_Witnesses_Batch");
+
+        valprint("Number of primitive pairs",rp[row_count]);
+        valprint("Ambient dimension        ",AMB_DIM);
+        valprint("thread_count             ",thread_count);
+        valprint("chunk_size               ",chunk_size);
+        valprint("accelerated              ",accelerated);
+        print("First  primitive type     = "+P_.ClassName());
+        print("Second primitive type     = "+Q_.ClassName());
+
+        GJK_JobScheduler<Int> scheduler ( Int(0), row_count, thread_count, chunk_size );
+
+        const Int sub_calls = ParallelDoReduce(
+            [&]( const Int thread ) -> Int
+            {
+                GJK_Algorithm_Vectorized<LANE_COUNT,AMB_DIM,Real,Int> gjk ( sub_algorithm );
+                SupportLanes<P_T,LANE_COUNT> P ( P_ );
+                SupportLanes<Q_T,LANE_COUNT> Q ( Q_ );
+
+                gjk.SetAcceleration( accelerated );
+
+                GJK_CSR_Jobs<Int> jobs ( scheduler, thread, rp );
+
+                gjk.Process( jobs, P, Q,
+                    [&]( const Int l, const Int k )
+                    {
+                        P[l].SetPointer( P_serialized_data, jobs.CurrentRow() );
+                        Q[l].SetPointer( Q_serialized_data, ci[k] );
+
+                        gjk.Load( l, P, Q, false, Scalar::Zero<Real>, Scalar::One<Real>,
+                            warm_start == nullptr ? nullptr : &warm_start[gjk.WarmStartSize() * k]
+                        );
+                    },
+                    [&]( const Int l, const Int k )
+                    {
+                        gjk.WriteWitnesses( l, x + AMB_DIM * k, y + AMB_DIM * k );
+
+                        if( warm_start != nullptr )
+                        {
+                            gjk.WriteWarmStart( l, &warm_start[gjk.WarmStartSize() * k] );
+                        }
+                    }
+                );
+
+                return gjk.SubCallCount();
+            },
+            AddReducer<Int, Int>(),
+            static_cast<Int>(0),
+            thread_count
+        );
+
+        print("GJK_CSR_Witnesses_Batch made " + ToString(sub_calls) + " subcalls for n = " + ToString(rp[row_count]) + " primitive pairs.");
+        toc("GJK_CSR_Witnesses_Batch");
+    }
+
+} // namespace GJK
@@ -0,0 +1,151 @@
+#pragma once
+
+namespace GJK
+{
+    // Distributes the indices in [begin,end[ over thread_count threads.
+    //
+    // chunk_size <= 0: Static schedule. Thread t gets the contiguous range [begin + JobPointer(n,thread_count,t), begin + JobPointer(n,thread_count,t+1)[. This is cheapest if the work per index is uniform.
+    //
+    // chunk_size >  0: Dynamic schedule. The threads repeatedly grab the next chunk_size indices from a shared atomic counter. GJK iteration counts vary a lot between touching and far-apart pairs; with the dynamic schedule, threads that got cheap pairs simply grab more chunks, and no thread waits for a slow one at the end.
+    //
+    // Usage: Create one scheduler for all threads; each thread calls GetWorker(thread) and pulls indices with Worker::Next (or whole chunks with NextChunk).
+
+    template<typename Int>
+    class alignas(ObjectAlignment) GJK_JobScheduler
+    {
+        ASSERT_INT(Int);
+
+    public:
+
+        static constexpr Int DefaultChunkSize = 256;
+
+    protected:
+
+        const Int begin;
+        const Int end;
+        const Int thread_count;
+        const Int chunk_size;
+
+        // Separate cache line; the counter is hammered by all threads.
+        alignas(ObjectAlignment) std::atomic<Int> counter;
+
+    public:
+
+        GJK_JobScheduler(
+            const Int begin_,
+            const Int end_,
+            const Int thread_count_,
+            const Int chunk_size_ = DefaultChunkSize
+        )
+        :   begin        ( begin_                         )
+        ,   end          ( end_                           )
+        ,   thread_count ( Max( thread_count_, Int(1) )   )
+        ,   chunk_size   ( chunk_size_                    )
+        ,   counter      ( begin_                         )
+        {}
+
+        GJK_JobScheduler( const GJK_JobScheduler & other ) = delete;
+
+        ~GJK_JobScheduler() = default;
+
+        bool DynamicQ() const
+        {
+            return chunk_size > 0;
+        }
+
+        Int ChunkSize() const
+        {
+            return chunk_size;
+        }
+
+        Int ThreadCount() const
+        {
+            return thread_count;
+        }
+
+        // Writes the next chunk [chunk_begin,chunk_end[ of the dynamic schedule; returns false if all indices have been handed out.
+        bool NextChunk( mref<Int> chunk_begin, mref<Int> chunk_end )
+        {
+            if( counter.load( std::memory_order_relaxed ) >= end )
+            {
+                return false;
+            }
+
+            chunk_begin = counter.fetch_add( chunk_size, std::memory_order_relaxed );
+            chunk_end   = Min( chunk_begin + chunk_size, end );
+
+            return chunk_begin < end;
+        }
+
+        // Calls f( chunk_begin, chunk_end ) for all chunks that are assigned to thread `thread`.
+        template<typename F>
+        void ForEachChunk( const Int thread, F && f )
+        {
+            if( DynamicQ() )
+            {
+                Int chunk_begin;
+                Int chunk_end;
+
+                while( NextChunk( chunk_begin, chunk_end ) )
+                {
+                    f( chunk_begin, chunk_end );
+                }
+            }
+            else
+            {
+                const Int chunk_begin = begin + JobPointer( end - begin, thread_count, thread    );
+                const Int chunk_end   = begin + JobPointer( end - begin, thread_count, thread +1 );
+
+                if( chunk_begin < chunk_end )
+                {
+                    f( chunk_begin, chunk_end );
+                }
+            }
+        }
+
+        // Hands out single indices to one thread.
+        class Worker
+        {
+        protected:
+
+            GJK_JobScheduler & S;
+
+            Int i     = 0;
+            Int i_end = 0;
+
+        public:
+
+            Worker( GJK_JobScheduler & S_, const Int thread )
+            :   S ( S_ )
+            {
+                if( !S.DynamicQ() )
+                {
+                    i     = S.begin + JobPointer( S.end - S.begin, S.thread_count, thread    );
+                    i_end = S.begin + JobPointer( S.end - S.begin, S.thread_count, thread +1 );
+                }
+            }
+
+            // Writes the next index to k; returns false if there is no work left for this thread.
+            bool Next( mref<Int> k )
+            {
+                if( (i >= i_end) && !( S.DynamicQ() && S.NextChunk( i, i_end ) ) )
+                {
+                    return false;
+                }
+
+                k = i;
+                ++i;
+
+                return true;
+            }
+
+        }; // Worker
+
+        Worker GetWorker( const Int thread )
+        {
+            return Worker( *this, thread );
+        }
+
+    }; // GJK_JobScheduler
+
+} // namespace GJK
@@ -2,111 +2,162 @@
 
 namespace GJK
 {
+    // See GJK_Batch.hpp for the rationale behind the template parameters P_T and Q_T and for the use of GJK_Algorithm_Vectorized.
 
-    template<int AMB_DIM, typename Real, typename Int, typename SReal>
+    template<typename P_T, typename Q_T, typename Int, typename SReal, typename Real>
     void GJK_Offset_IntersectingQ_Batch
     (
         const Int n,                                   // number of primitive pairs
-        const PrimitiveSerialized<AMB_DIM,Real,Int,SReal> & P_, // prototype primitive
-              SReal * const P_serialized_data,         // matrix of size n x (1 + AMB_DIM + POINT_COUNT_1 x AMB_DIM)
-        const Real * const P_off_set,                  // vector of size n storing the thickness of the primitive
-        const PrimitiveSerialized<AMB_DIM,Real,Int,SReal> & Q_, // prototype primitive
-              SReal * const Q_serialized_data,         // matrix of size n x (1 + AMB_DIM + POINT_COUNT_1 x AMB_DIM)
-        const Real * const Q_off_set,                 // vector of size n storing the thickness of the primitive
-              Int * const intersectingQ,               // vector of size n for storing the result
-        const Int thread_count = 1
+        cref<P_T> P_,                                  // prototype primitive
+        mptr<SReal> P_serialized_data,                 // matrix of size n x P_.Size()
+        cptr<Real> P_off_set,                          // vector of size n storing the thickness of the primitive
+        cref<Q_T> Q_,                                  // prototype primitive
+        mptr<SReal> Q_serialized_data,                 // matrix of size n x Q_.Size()
+        cptr<Real> Q_off_set,                          // vector of size n storing the thickness of the primitive
+        mptr<Int> intersectingQ,                       // vector of size n for storing the result
+        const Int thread_count = 1,
+        mptr<Real> warm_start = nullptr,               // optional warm-start records, one row per pair; see GJK_Batch.hpp
+        const Int chunk_size = GJK_JobScheduler<Int>::DefaultChunkSize, // pairs per chunk of the dynamic schedule; chunk_size <= 0 splits the pairs evenly among the threads instead
+        const GJK_SubAlgorithm sub_algorithm = GJK_SubAlgorithm::Johnson, // distance subalgorithm of the GJK runs; see GJK_SubAlgorithm
+        const bool accelerated = false                 // use the Nesterov-accelerated variant of GJK; see GJK_Algorithm::SetAcceleration
     )
     {
+        constexpr int AMB_DIM = P_T::AmbDim();
+        constexpr int LANE_COUNT = GJK_DefaultLaneCount<Real>();
+
+        static_assert( Q_T::AmbDim() == AMB_DIM, "GJK_Offset_IntersectingQ_Batch: Ambient dimensions of primitives do not match." );
+        static_assert( std::is_same_v<typename P_T::Real,Real>, "GJK_Offset_IntersectingQ_Batch: Real types of primitives and offsets do not match." );
+        static_assert( std::is_same_v<typename Q_T::Real,Real>, "GJK_Offset_IntersectingQ_Batch: Real types of primitives and offsets do not match." );
+
         tic("GJK_Offset_IntersectingQ_Batch");
-        
+
         valprint("Number of primitive pairs",n);
         valprint("Ambient dimension        ",AMB_DIM);
         valprint("thread_count             ",thread_count);
+        valprint("chunk_size               ",chunk_size);
+        valprint("accelerated              ",accelerated);
         print("First  primitive type     = "+P_.ClassName());
         print("Second primitive type     = "+Q_.ClassName());
 
+        GJK_JobScheduler<Int> scheduler ( Int(0), n, thread_count, chunk_size );
+
         const Int sub_calls = ParallelDoReduce(
             [&]( const Int thread ) -> Int
             {
-                Int sub_calls (0);
-                
-                GJK_Algorithm<AMB_DIM,Real,Int> gjk;
-                std::shared_ptr<PrimitiveSerialized<AMB_DIM,Real,Int,SReal>> P = P_.Clone();
-                std::shared_ptr<PrimitiveSerialized<AMB_DIM,Real,Int,SReal>> Q = Q_.Clone();
-
-                const Int i_begin = JobPointer<Int>( n, thread_count, thread    );
-                const Int i_end   = JobPointer<Int>( n, thread_count, thread +1 );
-                
-                for( Int i = i_begin; i < i_end; ++i )
-                {
-                    //print(\"======================================================\");\ valprint(\" i \",i);
-
-                    P->SetPointer( P_serialized_data, i );
-                    Q->SetPointer( Q_serialized_data, i );
-
-                    intersectingQ[i] = gjk.Offset_IntersectingQ( *P, P_off_set[i], *Q, Q_off_set[i] );
-                    
-                    sub_calls += gjk.SubCalls();
-                }
-                
-                return sub_calls;
+                GJK_Algorithm_Vectorized<LANE_COUNT,AMB_DIM,Real,Int> gjk ( sub_algorithm );
+                SupportLanes<P_T,LANE_COUNT> P ( P_ );
+                SupportLanes<Q_T,LANE_COUNT> Q ( Q_ );
+
+                gjk.SetAcceleration( accelerated );
+
+                auto jobs = scheduler.GetWorker( thread );
+
+                gjk.Process( jobs, P, Q,
+                    [&]( const Int l, const Int i )
+                    {
+                        P[l].SetPointer( P_serialized_data, i );
+                        Q[l].SetPointer( Q_serialized_data, i );
+
+                        const Real r = P_off_set[i] + Q_off_set[i];
+
+                        gjk.Load( l, P, Q, true, r * r, Scalar::One<Real>,
+                            warm_start == nullptr ? nullptr : &warm_start[gjk.WarmStartSize() * i]
+                        );
+                    },
+                    [&]( const Int l, const Int i )
+                    {
+                        intersectingQ[i] = !gjk.SeparatedQ(l);
+
+                        if( warm_start != nullptr )
+                        {
+                            gjk.WriteWarmStart( l, &warm_start[gjk.WarmStartSize() * i] );
+                        }
+                    }
+                );
+
+                return gjk.SubCallCount();
             },
             AddReducer<Int, Int>(),
             static_cast<Int>(0),
             thread_count
         );
-        
+
         print("GJK_Offset_IntersectingQ_Batch made " + ToString(sub_calls) + " subcalls for n = " + ToString(n) + " primitive pairs.");
         toc("GJK_Offset_IntersectingQ_Batch");
     }
-    
-    template<int AMB_DIM,typename Real, typename Int, typename SReal>
+
+    template<typename P_T, typename Q_T, typename Int, typename SReal, typename Real>
     void GJK_Offset_SquaredDistances_Batch
     (
-        const Int n,                                         // number of primitive pairs
-        const PrimitiveSerialized<AMB_DIM,Real,Int,SReal> & P_,       // prototype primitive
-              SReal * const P_serialized_data,               // matrix of size n x (1 + AMB_DIM + POINT_COUNT_1 x AMB_DIM)
-        const Real * const P_off_set,                        // vector of size n storing the thickness of the primitive
-        const PrimitiveSerialized<AMB_DIM,Real,Int,SReal> & Q_,       // prototype primitive
-              SReal * const Q_serialized_data,               // matrix of size n x (1 + AMB_DIM + POINT_COUNT_1 x AMB_DIM)
-        const Real * const Q_off_set,                        // vector of size n storing the thickness of the primitive
-              Real * const squared_dist,                     // vector of size n for storing the squared distances
-        const Int thread_count = 1
+        const Int n,                                   // number of primitive pairs
+        cref<P_T> P_,                                  // prototype primitive
+        mptr<SReal> P_serialized_data,                 // matrix of size n x P_.Size()
+        cptr<Real> P_off_set,                          // vector of size n storing the thickness of the primitive
+        cref<Q_T> Q_,                                  // prototype primitive
+        mptr<SReal> Q_serialized_data,                 // matrix of size n x Q_.Size()
+        cptr<Real> Q_off_set,                          // vector of size n storing the thickness of the primitive
+        mptr<Real> squared_dist,                       // vector of size n for storing the squared distances
+        const Int thread_count = 1,
+        mptr<Real> warm_start = nullptr,               // optional warm-start records, one row per pair; see GJK_Batch.hpp
+        const Int chunk_size = GJK_JobScheduler<Int>::DefaultChunkSize, // pairs per chunk of the dynamic schedule; chunk_size <= 0 splits the pairs evenly among the threads instead
+        const GJK_SubAlgorithm sub_algorithm = GJK_SubAlgorithm::Johnson, // distance subalgorithm of the GJK runs; see GJK_SubAlgorithm
+        const bool accelerated = false                 // use the Nesterov-accelerated variant of GJK; see GJK_Algorithm::SetAcceleration
     )
     {
+        constexpr int AMB_DIM = P_T::AmbDim();
+        constexpr int LANE_COUNT = GJK_DefaultLaneCount<Real>();
+
+        static_assert( Q_T::AmbDim() == AMB_DIM, "GJK_Offset_SquaredDistances_Batch: Ambient dimensions of primitives do not match." );
+        static_assert( std::is_same_v<typename P_T::Real,Real>, "GJK_Offset_SquaredDistances_Batch: Real types of primitives and offsets do not match." );
+        static_assert( std::is_same_v<typename Q_T::Real,Real>, "GJK_Offset_SquaredDistances_Batch: Real types of primitives and offsets do not match." );
+
         tic("GJK_Offset_SquaredDistances_Batch");
-        
+
         valprint("Number of primitive pairs",n);
         valprint("Ambient dimension        ",AMB_DIM);
         valprint("thread_count             ",thread_count);
+        valprint("chunk_size               ",chunk_size);
+        valprint("accelerated              ",accelerated);
         print("First  primitive type     = "+P_.ClassName());
         print("Second primitive type     = "+Q_.ClassName());
 
+        GJK_JobScheduler<Int> scheduler ( Int(0), n, thread_count, chunk_size );
+
         const Int sub_calls = ParallelDoReduce(
             [&]( const Int thread ) -> Int
             {
-                Int sub_calls (0);
-                
-                GJK_Algorithm<AMB_DIM,Real,Int> gjk;
-                std::shared_ptr<PrimitiveSerialized<AMB_DIM,Real,Int,SReal>> P = P_.Clone();
-                std::shared_ptr<PrimitiveSerialized<AMB_DIM,Real,Int,SReal>> Q = Q_.Clone();
-
-                const Int i_begin = JobPointer<Int>( n, thread_count, thread    );
-                const Int i_end   = JobPointer<Int>( n, thread_count, thread +1 );
-                
-                for( Int i = i_begin; i < i_end; ++i )
-                {
-                    //print(\"======================================================\");\ valprint(\" i \",i);
-
-                    P->SetPointer( P_serialized_data, i );
-                    Q->SetPointer( Q_serialized_data, i );
-
-                    squared_dist[i] = gjk.Offset_SquaredDistance( *P, P_off_set[i], *Q, Q_off_set[i] );
-                    
-                    sub_calls += gjk.SubCalls();
-                }
-                
-                return sub_calls;
+                GJK_Algorithm_Vectorized<LANE_COUNT,AMB_DIM,Real,Int> gjk ( sub_algorithm );
+                SupportLanes<P_T,LANE_COUNT> P ( P_ );
+                SupportLanes<Q_T,LANE_COUNT> Q ( Q_ );
+
+                gjk.SetAcceleration( accelerated );
+
+                auto jobs = scheduler.GetWorker( thread );
+
+                gjk.Process( jobs, P, Q,
+                    [&]( const Int l, const Int i )
+                    {
+                        P[l].SetPointer( P_serialized_data, i );
+                        Q[l].SetPointer( Q_serialized_data, i );
+
+                        const Real r = P_off_set[i] + Q_off_set[i];
+
+                        gjk.Load( l, P, Q, false, r * r, Scalar::One<Real>,
+                            warm_start == nullptr ? nullptr : &warm_start[gjk.WarmStartSize() * i]
+                        );
+                    },
+                    [&]( const Int l, const Int i )
+                    {
+                        squared_dist[i] = gjk.Offset_SquaredDistance( l, P_off_set[i], Q_off_set[i] );
+
+                        if( warm_start != nullptr )
+                        {
+                            gjk.WriteWarmStart( l, &warm_start[gjk.WarmStartSize() * i] );
+                        }
+                    }
+                );
+
+                return gjk.SubCallCount();
             },
             AddReducer<Int, Int>(),
             static_cast<Int>(0),
@@ -116,56 +167,80 @@ namespace GJK
         print("GJK_Offset_SquaredDistances_Batch made " + ToString(sub_calls) + " subcalls for n = " + ToString(n) + " primitive pairs.");
         toc("GJK_Offset_SquaredDistances_Batch");
     }
-    
-    template<int AMB_DIM,typename Real, typename Int, typename SReal>
+
+    template<typename P_T, typename Q_T, typename Int, typename SReal, typename Real>
     void GJK_Offset_Witnesses_Batch
     (
-        const Int n,                                         // number of primitive pairs
-        const PrimitiveSerialized<AMB_DIM,Real,Int,SReal> & P_,       // prototype primitive
-              SReal * const P_serialized_data,               // matrix of size n x (1 + AMB_DIM + POINT_COUNT_1 x AMB_DIM)
-        const Real * const P_off_set,                        // vector of size n storing the thickness of the primitive
-              Real * const x,                                // matrix of size n x AMB_DIM for storing the witnesses in P
-        const PrimitiveSerialized<AMB_DIM,Real,Int,SReal> & Q_,       // prototype primitive
-              SReal * const Q_serialized_data,               // matrix of size n x (1 + AMB_DIM + POINT_COUNT_1 x AMB_DIM)
-        const Real * const Q_off_set,                        // vector of size n storing the thickness of the primitive
-              Real * const y,                                // matrix of size n x AMB_DIM for storing the witnesses in P
-        const Int thread_count = 1
+        const Int n,                                   // number of primitive pairs
+        cref<P_T> P_,                                  // prototype primitive
+        mptr<SReal> P_serialized_data,                 // matrix of size n x P_.Size()
+        cptr<Real> P_off_set,                          // vector of size n storing the thickness of the primitive
+        mptr<Real> x,                                  // matrix of size n x AMB_DIM for storing the witnesses in P
+        cref<Q_T> Q_,                                  // prototype primitive
+        mptr<SReal> Q_serialized_data,                 // matrix of size n x Q_.Size()
+        cptr<Real> Q_off_set,                          // vector of size n storing the thickness of the primitive
+        mptr<Real> y,                                  // matrix of size n x AMB_DIM for storing the witnesses in Q
+        const Int thread_count = 1,
+        mptr<Real> warm_start = nullptr,               // optional warm-start records, one row per pair; see GJK_Batch.hpp
+        const Int chunk_size = GJK_JobScheduler<Int>::DefaultChunkSize, // pairs per chunk of the dynamic schedule; chunk_size <= 0 splits the pairs evenly among the threads instead
+        const GJK_SubAlgorithm sub_algorithm = GJK_SubAlgorithm::Johnson, // distance subalgorithm of the GJK runs; see GJK_SubAlgorithm
+        const bool accelerated = false                 // use the Nesterov-accelerated variant of GJK; see GJK_Algorithm::SetAcceleration
     )
     {
+        constexpr int AMB_DIM = P_T::AmbDim();
+        constexpr int LANE_COUNT = GJK_DefaultLaneCount<Real>();
+
+        static_assert( Q_T::AmbDim() == AMB_DIM, "GJK_Offset_Witnesses_Batch: Ambient dimensions of primitives do not match." );
+        static_assert( std::is_same_v<typename P_T::Real,Real>, "GJK_Offset_Witnesses_Batch: Real types of primitives and offsets do not match." );
+        static_assert( std::is_same_v<typename Q_T::Real,Real>, "GJK_Offset_Witnesses_Batch: Real types of primitives and offsets do not match." );
+
         tic("GJK_Offset_Witnesses_Batch");
-        
+
         valprint("Number of primitive pairs",n);
         valprint("Ambient dimension        ",AMB_DIM);
         valprint("thread_count             ",thread_count);
+        valprint("chunk_size               ",chunk_size);
+        valprint("accelerated              ",accelerated);
         print(   "First  primitive type     = "+P_.ClassName());
         print(   "Second primitive type     = "+Q_.ClassName());
 
+        GJK_JobScheduler<Int> scheduler ( Int(0), n, thread_count, chunk_size );
+
         const Int sub_calls = ParallelDoReduce(
             [&]( const Int thread ) -> Int
             {
-                Int sub_calls (0);
-                
-                GJK_Algorithm<AMB_DIM,Real,Int> gjk;
-                std::shared_ptr<PrimitiveSerialized<AMB_DIM,Real,Int,SReal>> P = P_.Clone();
-                std::shared_ptr<PrimitiveSerialized<AMB_DIM,Real,Int,SReal>> Q = Q_.Clone();
-
-                const Int i_begin = JobPointer<Int>( n, thread_count, thread    );
-                const Int i_end   = JobPointer<Int>( n, thread_count, thread +1 );
-                
-                for( Int i = i_begin; i < i_end; ++i )
-                {
-                    //print(\"======================================================\");\ valprint(\" i \",i);
-
-                    P->SetPointer( P_serialized_data, i );
-                    Q->SetPointer( Q_serialized_data, i );
-
-                    gjk.Offset_Witnesses( *P, P_off_set[i], x + AMB_DIM * i, *Q, Q_off_set[i], y + AMB_DIM * i );
-                    
-                    sub_calls += gjk.SubCalls();
-                }
-
-                
-                return sub_calls;
+                GJK_Algorithm_Vectorized<LANE_COUNT,AMB_DIM,Real,Int> gjk ( sub_algorithm );
+                SupportLanes<P_T,LANE_COUNT> P ( P_ );
+                SupportLanes<Q_T,LANE_COUNT> Q ( Q_ );
+
+                gjk.SetAcceleration( accelerated );
+
+                auto jobs = scheduler.GetWorker( thread );
+
+                gjk.Process( jobs, P, Q,
+                    [&]( const Int l, const Int i )
+                    {
+                        P[l].SetPointer( P_serialized_data, i );
+                        Q[l].SetPointer( Q_serialized_data, i );
+
+                        const Real r = P_off_set[i] + Q_off_set[i];
+
+                        gjk.Load( l, P, Q, false, r * r, Scalar::One<Real>,
+                            warm_start == nullptr ? nullptr : &warm_start[gjk.WarmStartSize() * i]
+                        );
+                    },
+                    [&]( const Int l, const Int i )
+                    {
+                        gjk.WriteOffsetWitnesses( l, P_off_set[i], x + AMB_DIM * i, Q_off_set[i], y + AMB_DIM * i );
+
+                        if( warm_start != nullptr )
+                        {
+                            gjk.WriteWarmStart( l, &warm_start[gjk.WarmStartSize() * i] );
+                        }
+                    }
+                );
+
+                return gjk.SubCallCount();
             },
             AddReducer<Int, Int>(),
             static_cast<Int>(0),
@@ -176,4 +251,162 @@ namespace GJK
         toc("GJK_Offset_Witnesses_Batch");
     }
 
+    // Same as GJK_Penetration_Batch, but for the thickened primitives: depth[i] is the penetration depth of the thickened pair (negative if they are separated), and the witnesses lie on the boundaries of the thickened primitives. This replaces shrinking the offsets until Offset_SquaredDistance becomes positive.
+    template<typename P_T, typename Q_T, typename Int, typename SReal, typename Real>
+    void GJK_Offset_Penetration_Batch
+    (
+        const Int n,                                   // number of primitive pairs
+        cref<P_T> P_,                                  // prototype primitive
+        mptr<SReal> P_serialized_data,                 // matrix of size n x P_.Size()
+        cptr<Real> P_off_set,                          // vector of size n storing the thickness of the primitive
+        mptr<Real> x,                                  // matrix of size n x AMB_DIM for storing the witnesses in P
+        cref<Q_T> Q_,                                  // prototype primitive
+        mptr<SReal> Q_serialized_data,                 // matrix of size n x Q_.Size()
+        cptr<Real> Q_off_set,                          // vector of size n storing the thickness of the primitive
+        mptr<Real> y,                                  // matrix of size n x AMB_DIM for storing the witnesses in Q
+        mptr<Real> depth,                              // vector of size n for storing the signed penetration depths
+        mptr<Real> normals,                            // matrix of size n x AMB_DIM for storing the unit contact normals
+        const Int thread_count = 1,
+        mptr<Real> warm_start = nullptr,               // optional warm-start records, one row per pair; see GJK_Batch.hpp
+        const Int chunk_size = GJK_JobScheduler<Int>::DefaultChunkSize, // pairs per chunk of the dynamic schedule; chunk_size <= 0 splits the pairs evenly among the threads instead
+        const GJK_SubAlgorithm sub_algorithm = GJK_SubAlgorithm::Johnson, // distance subalgorithm of the GJK runs; see GJK_SubAlgorithm
+        const bool accelerated = false                 // use the Nesterov-accelerated variant of GJK; see GJK_Algorithm::SetAcceleration
+    )
+    {
+        constexpr int AMB_DIM = P_T::AmbDim();
+        constexpr int LANE_COUNT = GJK_DefaultLaneCount<Real>();
+
+        static_assert( Q_T::AmbDim() == AMB_DIM, "GJK_Offset_Penetration_Batch: Ambient dimensions of primitives do not match." );
+        static_assert( std::is_same_v<typename P_T::Real,Real>, "GJK_Offset_Penetration_Batch: Real types of primitives and offsets do not match." );
+        static_assert( std::is_same_v<typename Q_T::Real,Real>, "GJK_Offset_Penetration_Batch: Real types of primitives and offsets do not match." );
+
+        tic("GJK_Offset_Penetration_Batch");
+
+        valprint("Number of primitive pairs",n);
+        valprint("Ambient dimension        ",AMB_DIM);
+        valprint("thread_count             ",thread_count);
+        valprint("chunk_size               ",chunk_size);
+        valprint("accelerated              ",accelerated);
+        print(   "First  primitive type     = "+P_.ClassName());
+        print(   "Second primitive type     = "+Q_.ClassName());
+
+        GJK_JobScheduler<Int> scheduler ( Int(0), n, thread_count, chunk_size );
+
+        const Int sub_calls = ParallelDoReduce(
+            [&]( const Int thread ) -> Int
+            {
+                GJK_Algorithm_Vectorized<LANE_COUNT,AMB_DIM,Real,Int> gjk ( sub_algorithm );
+                SupportLanes<P_T,LANE_COUNT> P ( P_ );
+                SupportLanes<Q_T,LANE_COUNT> Q ( Q_ );
+
+                gjk.SetAcceleration( accelerated );
+
+                // EPA_Algorithm is too large for the stack.
+                auto epa = std::make_unique<EPA_Algorithm<AMB_DIM,Real,Int>>();
+
+                auto jobs = scheduler.GetWorker( thread );
+
+                gjk.Process( jobs, P, Q,
+                    [&]( const Int l, const Int i )
+                    {
+                        P[l].SetPointer( P_serialized_data, i );
+                        Q[l].SetPointer( Q_serialized_data, i );
+
+                        // In contrast to GJK_Offset_Witnesses_Batch, GJK must not stop once the thickened primitives intersect: We need the distance of the cores, or the simplex for EPA if the cores intersect.
+                        gjk.Load( l, P, Q, false, Scalar::Zero<Real>, Scalar::One<Real>,
+                            warm_start == nullptr ? nullptr : &warm_start[gjk.WarmStartSize() * i]
+                        );
+                    },
+                    [&]( const Int l, const Int i )
+                    {
+                        depth[i] = EPA_WriteContact( gjk, l, *epa, P[l], Q[l],
+                            normals + AMB_DIM * i, x + AMB_DIM * i, y + AMB_DIM * i,
+                            P_off_set[i], Q_off_set[i]
+                        );
+
+                        if( warm_start != nullptr )
+                        {
+                            gjk.WriteWarmStart( l, &warm_start[gjk.WarmStartSize() * i] );
+                        }
+                    }
+                );
+
+                return gjk.SubCallCount();
+            },
+            AddReducer<Int, Int>(),
+            static_cast<Int>(0),
+            thread_count
+        );
+
+        print("GJK_Offset_Penetration_Batch made " + ToString(sub_calls) + " subcalls for n = " + ToString(n) + " primitive pairs.");
+        toc("GJK_Offset_Penetration_Batch");
+    }
+
+
+    // Overloads with explicit template parameters for backward compatibility. These use virtual dispatch.
+
+    template<int AMB_DIM, typename Real, typename Int, typename SReal>
+    void GJK_Offset_IntersectingQ_Batch
+    (
+        const Int n,
+        const PrimitiveSerialized<AMB_DIM,Real,Int,SReal> & P_,
+              SReal * const P_serialized_data,
+        const Real * const P_off_set,
+        const PrimitiveSerialized<AMB_DIM,Real,Int,SReal> & Q_,
+              SReal * const Q_serialized_data,
+        const Real * const Q_off_set,
+              Int * const intersectingQ,
+        const Int thread_count = 1
+    )
+    {
+        using Primitive_T = PrimitiveSerialized<AMB_DIM,Real,Int,SReal>;
+
+        GJK_Offset_IntersectingQ_Batch<Primitive_T,Primitive_T>(
+            n, P_, P_serialized_data, P_off_set, Q_, Q_serialized_data, Q_off_set, intersectingQ, thread_count
+        );
+    }
+
+    template<int AMB_DIM,typename Real, typename Int, typename SReal>
+    void GJK_Offset_SquaredDistances_Batch
+    (
+        const Int n,
+        const PrimitiveSerialized<AMB_DIM,Real,Int,SReal> & P_,
+              SReal * const P_serialized_data,
+        const Real * const P_off_set,
+        const PrimitiveSerialized<AMB_DIM,Real,Int,SReal> & Q_,
+              SReal * const Q_serialized_data,
+        const Real * const Q_off_set,
+              Real * const squared_dist,
+        const Int thread_count = 1
+    )
+    {
+        using Primitive_T = PrimitiveSerialized<AMB_DIM,Real,Int,SReal>;
+
+        GJK_Offset_SquaredDistances_Batch<Primitive_T,Primitive_T>(
+            n, P_, P_serialized_data, P_off_set, Q_, Q_serialized_data, Q_off_set, squared_dist, thread_count
+        );
+    }
+
+    template<int AMB_DIM,typename Real, typename Int, typename SReal>
+    void GJK_Offset_Witnesses_Batch
+    (
+        const Int n,
+        const PrimitiveSerialized<AMB_DIM,Real,Int,SReal> & P_,
+              SReal * const P_serialized_data,
+        const Real * const P_off_set,
+              Real * const x,
+        const PrimitiveSerialized<AMB_DIM,Real,Int,SReal> & Q_,
+              SReal * const Q_serialized_data,
+        const Real * const Q_off_set,
+              Real * const y,
+        const Int thread_count = 1
+    )
+    {
+        using Primitive_T = PrimitiveSerialized<AMB_DIM,Real,Int,SReal>;
+
+        GJK_Offset_Witnesses_Batch<Primitive_T,Primitive_T>(
+            n, P_, P_serialized_data, P_off_set, x, Q_, Q_serialized_data, Q_off_set, y, thread_count
+        );
+    }
+
 } // namespe GJK
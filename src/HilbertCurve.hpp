@@ -0,0 +1,71 @@
+#pragma once
+
+namespace GJK
+{
+    // Hilbert codes of quantized points.
+    //
+    // Same input and output conventions as MortonCode (see MortonCode.hpp), but the points are ordered along the Hilbert curve. Consecutive cells of the Hilbert curve are always face-adjacent, so ranges of the ordering tend to be more compact than with the Z-order curve; the price is a few more bit operations per point.
+    //
+    // The coordinates are first converted to the "transposed" Hilbert index by J. Skilling's algorithm (Programming the Hilbert curve, AIP Conf. Proc. 707, 2004); the transposed index is then interleaved just like a Morton code.
+
+    template<int AMB_DIM>
+    constexpr std::uint64_t HilbertCode( cptr<std::uint64_t> q )
+    {
+        constexpr int bits = 63 / AMB_DIM;
+
+        std::uint64_t x [AMB_DIM] = {};
+
+        for( int k = 0; k < AMB_DIM; ++k )
+        {
+            x[k] = q[k] & ((std::uint64_t(1) << bits) - 1);
+        }
+
+        const std::uint64_t M = std::uint64_t(1) << (bits - 1);
+
+        // Inverse undo.
+        for( std::uint64_t Q = M; Q > 1; Q >>= 1 )
+        {
+            const std::uint64_t P = Q - 1;
+
+            for( int k = 0; k < AMB_DIM; ++k )
+            {
+                if( x[k] & Q )
+                {
+                    // Invert.
+                    x[0] ^= P;
+                }
+                else
+                {
+                    // Exchange.
+                    const std::uint64_t t = (x[0] ^ x[k]) & P;
+                    x[0] ^= t;
+                    x[k] ^= t;
+                }
+            }
+        }
+
+        // Gray encode.
+        for( int k = 1; k < AMB_DIM; ++k )
+        {
+            x[k] ^= x[k-1];
+        }
+
+        std::uint64_t t = 0;
+
+        for( std::uint64_t Q = M; Q > 1; Q >>= 1 )
+        {
+            if( x[AMB_DIM-1] & Q )
+            {
+                t ^= Q - 1;
+            }
+        }
+
+        for( int k = 0; k < AMB_DIM; ++k )
+        {
+            x[k] ^= t;
+        }
+
+        return MortonCode<AMB_DIM>( &x[0] );
+    }
+
+} // namespace GJK
@@ -0,0 +1,69 @@
+#pragma once
+
+namespace GJK
+{
+    // Morton codes (Z-order curve) of quantized points.
+    //
+    // A point with AMB_DIM integer coordinates q[k] in [0, 2^bits[ with bits = 63 / AMB_DIM is mapped to a single 64-bit integer by interleaving the bits of its coordinates. q[0] contributes the most significant bit of each group. Sorting points by their codes orders them along the Z-order curve; points close in the ordering are close in space.
+    //
+    // AABB::QuantizeCoordinates produces suitable integer coordinates.
+
+    // Inserts AMB_DIM - 1 zero bits after each of the lowest 63 / AMB_DIM bits of x.
+    template<int AMB_DIM>
+    constexpr std::uint64_t MortonSpreadBits( std::uint64_t x )
+    {
+        static_assert( (AMB_DIM >= 1) && (AMB_DIM <= 63), "MortonSpreadBits: AMB_DIM must be in [1,63]." );
+
+        constexpr int bits = 63 / AMB_DIM;
+
+        if constexpr ( AMB_DIM == 1 )
+        {
+            return x & ((std::uint64_t(1) << bits) - 1);
+        }
+        else if constexpr ( AMB_DIM == 2 )
+        {
+            x &= 0x000000007fffffffull;
+            x = (x | (x << 16)) & 0x0000ffff0000ffffull;
+            x = (x | (x <<  8)) & 0x00ff00ff00ff00ffull;
+            x = (x | (x <<  4)) & 0x0f0f0f0f0f0f0f0full;
+            x = (x | (x <<  2)) & 0x3333333333333333ull;
+            x = (x | (x <<  1)) & 0x5555555555555555ull;
+            return x;
+        }
+        else if constexpr ( AMB_DIM == 3 )
+        {
+            x &= 0x00000000001fffffull;
+            x = (x | (x << 32)) & 0x001f00000000ffffull;
+            x = (x | (x << 16)) & 0x001f0000ff0000ffull;
+            x = (x | (x <<  8)) & 0x100f00f00f00f00full;
+            x = (x | (x <<  4)) & 0x10c30c30c30c30c3ull;
+            x = (x | (x <<  2)) & 0x1249249249249249ull;
+            return x;
+        }
+        else
+        {
+            std::uint64_t y = 0;
+
+            for( int b = 0; b < bits; ++b )
+            {
+                y |= ((x >> b) & std::uint64_t(1)) << (AMB_DIM * b);
+            }
+
+            return y;
+        }
+    }
+
+    template<int AMB_DIM>
+    constexpr std::uint64_t MortonCode( cptr<std::uint64_t> q )
+    {
+        std::uint64_t code = 0;
+
+        for( int k = 0; k < AMB_DIM; ++k )
+        {
+            code |= MortonSpreadBits<AMB_DIM>( q[k] ) << (AMB_DIM - 1 - k);
+        }
+
+        return code;
+    }
+
+} // namespace GJK
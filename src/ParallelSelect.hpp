@@ -0,0 +1,289 @@
+#pragma once
+
+namespace GJK
+{
+    // Parallel building blocks for median splits of large nodes (see AABB_MedianSplit and OBB_MedianSplit).
+    //
+    // ParallelNthValue selects the k-th smallest value by quickselect: the pivot is taken from a small sorted sample at the quantile of k, all threads count the values below and equal to the pivot, and the values on the side that contains k are compacted into a buffer for the next round. A few rounds reduce the candidates to a size that is finished serially by std::nth_element.
+    //
+    // ParallelSplitPermutation turns the selected value into a permutation like the one computed by std::nth_element; ParallelGatherPrimitives applies a permutation out of place to the serialized primitives and to their ordering.
+    //
+    // All routines split [begin,end[ statically over the threads (JobPointer).
+
+    // Below this node size the serial routines are faster.
+    template<typename Int>
+    constexpr Int ParallelSplitThreshold = Int(1) << 14;
+
+    // Returns the k-th smallest (k = 0,...,n-1) of values[0],...,values[n-1].
+    template<typename SReal, typename Int>
+    SReal ParallelNthValue( cptr<SReal> values, const Int n, Int k, const Int thread_count )
+    {
+        constexpr Int sample_count    = 63;
+        constexpr Int serial_cutoff   = Int(1) << 12;
+
+        std::vector<SReal> buffer_0;
+        std::vector<SReal> buffer_1;
+
+        std::vector<Int> thread_lt ( thread_count );
+        std::vector<Int> thread_eq ( thread_count );
+
+        const SReal * a = values;
+        Int m = n;
+
+        while( m > serial_cutoff )
+        {
+            // Pivot at the quantile of k within an evenly spaced sample.
+            std::array<SReal,sample_count> sample;
+
+            // 64-bit arithmetic, because m * sample_count may overflow Int.
+            for( Int s = 0; s < sample_count; ++s )
+            {
+                sample[s] = a[ static_cast<Int>( static_cast<std::int64_t>(m - 1) * s / (sample_count - 1) ) ];
+            }
+
+            const Int s_k = static_cast<Int>( Min( std::int64_t(sample_count - 1), static_cast<std::int64_t>(k) * sample_count / m ) );
+
+            std::nth_element( sample.begin(), sample.begin() + s_k, sample.end() );
+
+            const SReal pivot = sample[s_k];
+
+            ParallelDo(
+                [&]( const Int thread )
+                {
+                    const Int i_begin = JobPointer( m, thread_count, thread    );
+                    const Int i_end   = JobPointer( m, thread_count, thread +1 );
+
+                    Int lt = 0;
+                    Int eq = 0;
+
+                    for( Int i = i_begin; i < i_end; ++i )
+                    {
+                        lt += (a[i] <  pivot);
+                        eq += (a[i] == pivot);
+                    }
+
+                    thread_lt[thread] = lt;
+                    thread_eq[thread] = eq;
+                },
+                thread_count
+            );
+
+            Int lt = 0;
+            Int eq = 0;
+
+            for( Int thread = 0; thread < thread_count; ++thread )
+            {
+                lt += thread_lt[thread];
+                eq += thread_eq[thread];
+            }
+
+            if( (lt <= k) && (k < lt + eq) )
+            {
+                return pivot;
+            }
+
+            const bool leftQ = (k < lt);
+
+            // Compact the side that contains the k-th value.
+            std::vector<SReal> & target = (a == buffer_0.data()) ? buffer_1 : buffer_0;
+
+            const Int m_new = leftQ ? lt : m - lt - eq;
+
+            std::vector<Int> offsets ( thread_count + 1, Int(0) );
+
+            for( Int thread = 0; thread < thread_count; ++thread )
+            {
+                const Int i_begin = JobPointer( m, thread_count, thread    );
+                const Int i_end   = JobPointer( m, thread_count, thread +1 );
+
+                offsets[thread+1] = offsets[thread] + ( leftQ
+                    ? thread_lt[thread]
+                    : (i_end - i_begin) - thread_lt[thread] - thread_eq[thread]
+                );
+            }
+
+            target.resize( m_new );
+
+            SReal * b = target.data();
+
+            ParallelDo(
+                [&]( const Int thread )
+                {
+                    const Int i_begin = JobPointer( m, thread_count, thread    );
+                    const Int i_end   = JobPointer( m, thread_count, thread +1 );
+
+                    Int pos = offsets[thread];
+
+                    for( Int i = i_begin; i < i_end; ++i )
+                    {
+                        if( leftQ ? (a[i] < pivot) : (a[i] > pivot) )
+                        {
+                            b[pos++] = a[i];
+                        }
+                    }
+                },
+                thread_count
+            );
+
+            if( !leftQ )
+            {
+                k -= lt + eq;
+            }
+
+            a = b;
+            m = m_new;
+        }
+
+        std::vector<SReal> rest ( a, a + m );
+
+        std::nth_element( rest.begin(), rest.begin() + k, rest.end() );
+
+        return rest[k];
+    }
+
+    // Writes a permutation of [begin,end[ to perm[begin],...,perm[end-1] such that the primitives perm[begin],...,perm[split_index-1] have the split_index - begin smallest scores.
+    template<typename SReal, typename Int>
+    void ParallelSplitPermutation(
+        cptr<SReal> score, const Int begin, const Int split_index, const Int end,
+        mptr<Int> perm,
+        const Int thread_count
+    )
+    {
+        const Int n = end - begin;
+        const Int k = split_index - begin;
+
+        const SReal v = ParallelNthValue( score + begin, n, k, thread_count );
+
+        std::vector<Int> thread_lt ( thread_count );
+        std::vector<Int> thread_eq ( thread_count );
+
+        ParallelDo(
+            [&]( const Int thread )
+            {
+                const Int i_begin = begin + JobPointer( n, thread_count, thread    );
+                const Int i_end   = begin + JobPointer( n, thread_count, thread +1 );
+
+                Int lt = 0;
+                Int eq = 0;
+
+                for( Int i = i_begin; i < i_end; ++i )
+                {
+                    lt += (score[i] <  v);
+                    eq += (score[i] == v);
+                }
+
+                thread_lt[thread] = lt;
+                thread_eq[thread] = eq;
+            },
+            thread_count
+        );
+
+        // The primitives with score < v go left, those with score > v go right. The ones with score == v fill up the left side first, in the order of the threads.
+        Int lt_total = 0;
+
+        for( Int thread = 0; thread < thread_count; ++thread )
+        {
+            lt_total += thread_lt[thread];
+        }
+
+        std::vector<Int> left_lt  ( thread_count );
+        std::vector<Int> left_eq  ( thread_count );
+        std::vector<Int> right    ( thread_count );
+        std::vector<Int> eq_left  ( thread_count );
+
+        Int pos_lt    = begin;
+        Int pos_eq    = begin + lt_total;
+        Int pos_right = split_index;
+        Int eq_rest   = k - lt_total;
+
+        for( Int thread = 0; thread < thread_count; ++thread )
+        {
+            eq_left[thread] = Min( thread_eq[thread], eq_rest );
+            eq_rest -= eq_left[thread];
+
+            left_lt[thread] = pos_lt;
+            left_eq[thread] = pos_eq;
+            right  [thread] = pos_right;
+
+            const Int i_count = JobPointer( n, thread_count, thread + 1 ) - JobPointer( n, thread_count, thread );
+
+            pos_lt    += thread_lt[thread];
+            pos_eq    += eq_left[thread];
+            pos_right += i_count - thread_lt[thread] - eq_left[thread];
+        }
+
+        ParallelDo(
+            [&]( const Int thread )
+            {
+                const Int i_begin = begin + JobPointer( n, thread_count, thread    );
+                const Int i_end   = begin + JobPointer( n, thread_count, thread +1 );
+
+                Int p_lt    = left_lt[thread];
+                Int p_eq    = left_eq[thread];
+                Int p_right = right  [thread];
+                Int eq_todo = eq_left[thread];
+
+                for( Int i = i_begin; i < i_end; ++i )
+                {
+                    if( score[i] < v )
+                    {
+                        perm[p_lt++] = i;
+                    }
+                    else if( (score[i] == v) && (eq_todo > 0) )
+                    {
+                        perm[p_eq++] = i;
+                        --eq_todo;
+                    }
+                    else
+                    {
+                        perm[p_right++] = i;
+                    }
+                }
+            },
+            thread_count
+        );
+    }
+
+    // Moves primitive perm[i] to row i for i in [begin,end[, and permutes P_ordering alongside. buffer[begin],...,buffer[end-1] are used as scratch space.
+    template<typename SReal, typename Int>
+    void ParallelGatherPrimitives(
+        const Int P_Size, mptr<SReal> P_serialized, mptr<Int> P_ordering,
+        cptr<Int> perm, const Int begin, const Int end,
+        mptr<Int> buffer,
+        const Int thread_count
+    )
+    {
+        const Int n = end - begin;
+
+        std::vector<SReal> P_buffer ( n * P_Size );
+
+        ParallelDo(
+            [&]( const Int thread )
+            {
+                const Int i_begin = begin + JobPointer( n, thread_count, thread    );
+                const Int i_end   = begin + JobPointer( n, thread_count, thread +1 );
+
+                for( Int i = i_begin; i < i_end; ++i )
+                {
+                    std::copy_n( &P_serialized[P_Size * perm[i]], P_Size, &P_buffer[P_Size * (i - begin)] );
+
+                    buffer[i] = P_ordering[perm[i]];
+                }
+            },
+            thread_count
+        );
+
+        ParallelDo(
+            [&]( const Int thread )
+            {
+                const Int i_begin = JobPointer( n, thread_count, thread    );
+                const Int i_end   = JobPointer( n, thread_count, thread +1 );
+
+                std::copy_n( P_buffer.data() + P_Size * i_begin, P_Size * (i_end - i_begin), P_serialized + P_Size * (begin + i_begin) );
+                std::copy_n( buffer + (begin + i_begin), i_end - i_begin, P_ordering + (begin + i_begin) );
+            },
+            thread_count
+        );
+    }
+
+} // namespace GJK
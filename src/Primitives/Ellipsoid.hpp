@@ -1,7 +1,5 @@
 #pragma once
 
-// TODO: Implement MinMaxSupportValue
-
 #define BASE PrimitiveSerialized<AMB_DIM,Real,Int,SReal>
 #define CLASS Ellipsoid
 
@@ -51,6 +49,8 @@ namespace GJK
         
         __ADD_CLONE_CODE__(CLASS)
         
+    public:
+        
         void FromTransform(  cptr<SReal> center,  cptr<SReal> transform ) const
         {
             mref<SReal> r2 = this->serialized_data[0];
@@ -95,7 +95,7 @@ namespace GJK
             
             for( Int i = 0; i < AMB_DIM; ++i )
             {
-                b[i] = static_cast<Real>(A[AMB_DIM * i]) * dir[0];
+                b[i] = static_cast<Real>(A[i]) * dir[0];
 
                 for( Int j = 1; j < AMB_DIM; ++j )
                 {
@@ -119,7 +119,7 @@ namespace GJK
             // Transform the point back to the ellipsoid.
             for( Int i = 0; i < AMB_DIM; ++i )
             {
-                supp[i] = x[i] + static_cast<Real>(A[i]) * b[0];
+                supp[i] = x[i] + static_cast<Real>(A[AMB_DIM * i]) * b[0];
 
                 for( Int j = 1; j < AMB_DIM; ++j )
                 {
@@ -144,7 +144,7 @@ namespace GJK
             
             for( Int i = 0; i < AMB_DIM; ++i )
             {
-                b[i] = A[AMB_DIM * i] * dir[0];
+                b[i] = static_cast<Real>(A[i]) * dir[0];
 
                 for( Int j = 1; j < AMB_DIM; ++j )
                 {
@@ -168,7 +168,7 @@ namespace GJK
             // Transform the point back to the ellipsoid.
             for( Int i = 0; i < AMB_DIM; ++i )
             {
-                supp[i] = static_cast<Real>(x[i]) + static_cast<Real>(A[i]) * b[0];
+                supp[i] = static_cast<Real>(x[i]) + static_cast<Real>(A[AMB_DIM * i]) * b[0];
 
                 for( Int j = 1; j < AMB_DIM; ++j )
                 {
@@ -181,10 +181,32 @@ namespace GJK
             return R1;
         }
         
+        // The support values are <center,dir> -/+ |transform^T * dir|. (The support vector functions use Real_buffer as scratch space, so we must not pass it to them as output.)
         virtual void MinMaxSupportValue( cptr<Real> dir, mref<Real> min_val, mref<Real> max_val ) const override
         {
-            min_val = MinSupportVector( dir, &this->Real_buffer[0] );
-            max_val = MaxSupportVector( dir, &this->Real_buffer[AMB_DIM] );
+            const SReal * restrict const x = this->serialized_data+ 1;
+            const SReal * restrict const A = this->serialized_data+ 1 + AMB_DIM;
+
+            Real center_val = Scalar::Zero<Real>;
+            Real R2         = Scalar::Zero<Real>;
+
+            for( Int i = 0; i < AMB_DIM; ++i )
+            {
+                Real b_i = static_cast<Real>(A[i]) * dir[0];
+
+                for( Int j = 1; j < AMB_DIM; ++j )
+                {
+                    b_i += dir[j] * static_cast<Real>(A[AMB_DIM * j + i]);
+                }
+
+                R2         += b_i * b_i;
+                center_val += static_cast<Real>(x[i]) * dir[i];
+            }
+
+            const Real R = Sqrt(R2);
+
+            min_val = center_val - R;
+            max_val = center_val + R;
         }
         
         virtual std::string ClassName() const override
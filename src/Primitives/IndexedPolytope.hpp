@@ -0,0 +1,245 @@
+#pragma once
+
+#define CLASS IndexedPolytope
+#define BASE  PolytopeBase<AMB_DIM,Real,Int,SReal>
+
+namespace GJK
+{
+    // A polytope whose vertices live in a shared vertex buffer.
+    //
+    // Polytope stores the coordinates of its POINT_COUNT vertices in its serialized record, so in a triangle mesh every vertex is stored once per incident triangle. IndexedPolytope stores only the indices of its vertices; the support functions read the coordinates from the vertex buffer (a matrix of size vertex_count x AMB_DIM) that is handed to the prototype. All views cloned from the prototype (e.g., by SupportLanes or by the BVH) share the buffer.
+    //
+    // For a deforming mesh, it suffices to overwrite the vertex buffer and to call UpdateBounds on the records, which recomputes only the squared radii and interior points; afterwards, BVH::Refit() updates the bounding volumes.
+    //
+    // The indices are stored as SReal, so they are exact below 2^24 for float and below 2^53 for double.
+
+    // DATA LAYOUT
+    // serialized_data[0] = squared radius
+    // serialized_data[1],...,serialized_data[AMB_DIM] = interior_point
+    // serialized_data[AMB_DIM + 1],...,serialized_data[AMB_DIM + POINT_COUNT] = indices of the vertices in the vertex buffer.
+
+    template<int POINT_COUNT, int AMB_DIM, typename Real, typename Int, typename SReal, typename ExtInt = Int>
+    class CLASS : public BASE
+    {
+        ASSERT_INT(ExtInt);
+
+    protected:
+
+        const SReal * vertex_coords = nullptr;
+
+    public:
+
+        CLASS() : BASE() {}
+
+        explicit CLASS( cptr<SReal> vertex_coords_ )
+        :   BASE()
+        ,   vertex_coords ( vertex_coords_ )
+        {}
+
+        // Copy constructor
+        CLASS( const CLASS & other )
+        :   BASE( other )
+        ,   vertex_coords ( other.vertex_coords )
+        {}
+
+        // Move constructor
+        CLASS( CLASS && other ) noexcept
+        :   BASE( other )
+        ,   vertex_coords ( other.vertex_coords )
+        {}
+
+        virtual ~CLASS() override = default;
+
+        static constexpr Int SIZE = 1 + AMB_DIM + POINT_COUNT;
+
+        virtual constexpr Int Size() const override
+        {
+            return SIZE;
+        }
+
+        virtual constexpr Int PointCount() const override
+        {
+            return POINT_COUNT;
+        }
+
+#include "Primitive_Common.hpp"
+
+        __ADD_CLONE_CODE__(CLASS)
+
+    public:
+
+        // Only affects this view and the views cloned from it afterwards.
+        void SetVertexCoordinates( cptr<SReal> vertex_coords_ )
+        {
+            vertex_coords = vertex_coords_;
+        }
+
+        const SReal * VertexCoordinates() const
+        {
+            return vertex_coords;
+        }
+
+        Int VertexIndex( const Int j ) const
+        {
+            return static_cast<Int>(this->serialized_data[1 + AMB_DIM + j]);
+        }
+
+        // Returns a pointer to the coordinates of the j-th vertex of the current primitive.
+        const SReal * Vertex( const Int j ) const
+        {
+            return &vertex_coords[AMB_DIM * VertexIndex(j)];
+        }
+
+        // tuples is a matrix of size n x POINT_COUNT; writes the i-th tuple to the current record.
+        void FromIndexList( cptr<ExtInt> tuples, const Int i = 0 ) const
+        {
+            cptr<ExtInt> s = tuples + POINT_COUNT * i;
+
+            for( Int j = 0; j < POINT_COUNT; ++j )
+            {
+                this->serialized_data[1 + AMB_DIM + j] = static_cast<SReal>(s[j]);
+            }
+
+            ComputeBounds();
+        }
+
+        // Recomputes squared radius and interior point of the current record from the vertex buffer.
+        void ComputeBounds() const
+        {
+            constexpr SReal w = Inv<SReal>(POINT_COUNT);
+
+            mref<SReal> r2     = this->serialized_data[0];
+            mptr<SReal> center = &this->serialized_data[1];
+
+            for( Int k = 0; k < AMB_DIM; ++k )
+            {
+                center[k] = Vertex(0)[k];
+
+                for( Int j = 1; j < POINT_COUNT; ++j )
+                {
+                    center[k] += Vertex(j)[k];
+                }
+
+                center[k] *= w;
+            }
+
+            r2 = Scalar::Zero<SReal>;
+
+            for( Int j = 0; j < POINT_COUNT; ++j )
+            {
+                cptr<SReal> x = Vertex(j);
+
+                SReal square = Scalar::Zero<SReal>;
+
+                for( Int k = 0; k < AMB_DIM; ++k )
+                {
+                    const SReal diff = x[k] - center[k];
+                    square += diff * diff;
+                }
+
+                r2 = Max( r2, square );
+            }
+        }
+
+        // Calls ComputeBounds for all records of P_serialized, a matrix of size n x SIZE; to be called after the vertex buffer has changed.
+        void UpdateBounds( mptr<SReal> P_serialized, const Int n, const Int thread_count = 1 ) const
+        {
+            ParallelDo(
+                [&]( const Int thread )
+                {
+                    const Int i_begin = JobPointer( n, thread_count, thread    );
+                    const Int i_end   = JobPointer( n, thread_count, thread +1 );
+
+                    CLASS P ( *this );
+
+                    for( Int i = i_begin; i < i_end; ++i )
+                    {
+                        P.SetPointer( P_serialized, i );
+                        P.ComputeBounds();
+                    }
+                },
+                thread_count
+            );
+        }
+
+        //Computes support vector supp of dir.
+        virtual Real MinSupportVector( cptr<Real> dir, mptr<Real> supp ) const override
+        {
+            return SupportVector<false>( dir, supp );
+        }
+
+        //Computes support vector supp of dir.
+        virtual Real MaxSupportVector( cptr<Real> dir, mptr<Real> supp ) const override
+        {
+            return SupportVector<true>( dir, supp );
+        }
+
+        // Computes only the values of min/max support function. Usefull to compute bounding boxes.
+        virtual void MinMaxSupportValue( cptr<Real> dir, mref<Real> min_val, mref<Real> max_val ) const override
+        {
+            Real value = dot_buffers<AMB_DIM>( Vertex(0), dir );
+
+            min_val = value;
+            max_val = value;
+
+            for( Int j = 1; j < POINT_COUNT; ++j )
+            {
+                value = dot_buffers<AMB_DIM>( Vertex(j), dir );
+
+                min_val = Min( min_val, value );
+                max_val = Max( max_val, value );
+            }
+        }
+
+        // Same as Polytope::BoxMinMax.
+        virtual void BoxMinMax( mptr<SReal> box_min, mptr<SReal> box_max ) const override
+        {
+            for( Int j = 0; j < POINT_COUNT; ++j )
+            {
+                cptr<SReal> x = Vertex(j);
+
+                for( Int k = 0; k < AMB_DIM; ++k )
+                {
+                    box_min[k] = Min( box_min[k], x[k] );
+                    box_max[k] = Max( box_max[k], x[k] );
+                }
+            }
+        }
+
+    protected:
+
+        template<bool maxQ>
+        Real SupportVector( cptr<Real> dir, mptr<Real> supp ) const
+        {
+            Int  best_j = 0;
+            Real best   = dot_buffers<AMB_DIM>( Vertex(0), dir );
+
+            for( Int j = 1; j < POINT_COUNT; ++j )
+            {
+                const Real value = dot_buffers<AMB_DIM>( Vertex(j), dir );
+
+                if( maxQ ? (value > best) : (value < best) )
+                {
+                    best_j = j;
+                    best   = value;
+                }
+            }
+
+            copy_buffer<AMB_DIM>( Vertex(best_j), supp );
+
+            return best;
+        }
+
+    public:
+
+        virtual std::string ClassName() const override
+        {
+            return TO_STD_STRING(CLASS)+"<"+ToString(POINT_COUNT)+","+ToString(AMB_DIM)+","+TypeName<Real>+","+TypeName<Int>+","+TypeName<SReal>+","+TypeName<ExtInt>+">";
+        }
+
+    }; // IndexedPolytope
+
+} // namespace GJK
+
+#undef CLASS
+#undef BASE
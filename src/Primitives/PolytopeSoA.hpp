@@ -0,0 +1,385 @@
+#pragma once
+
+#define CLASS PolytopeSoA
+
+namespace GJK
+{
+    // A view onto polytopes that are stored in structure-of-arrays layout.
+    //
+    // The fields are the same as for Polytope<POINT_COUNT,AMB_DIM,...>, but the data of n primitives is stored as a matrix of size SIZE x stride (with stride >= n). Row f contains field f of all primitives, so the SoA matrix is just the transpose of the AoS matrix used by Polytope:
+    //
+    //      SoA[ stride * f + i ] == AoS[ SIZE * i + f ].
+    //
+    // So, e.g., the x-coordinates of vertex 0 of all primitives are contiguous, and so are the coordinates of the centers. The range kernels below (FromCoordinates, FromPolytopes, ToPolytopes, BoxMinMax) loop over the primitives innermost and are thus vectorized by the compiler; AABB::FromPrimitives has an overload for this layout.
+    //
+    // The class is not derived from PrimitiveSerialized: Its members SetPointer, InteriorPoint etc. assume the AoS layout and are not virtual. Instead, PolytopeSoA has the same non-virtual interface as Polytope, so that it can be used with the statically typed routines GJK_Algorithm::Compute, GJK_*_Batch, and SupportLanes. Pass a prototype constructed with the stride and the SoA matrix instead of the serialized data.
+    //
+    // BVH and the splitting routines of the bounding volumes work on the AoS layout only; use ToPolytopes to build a tree over primitives stored in SoA layout.
+
+    // DATA LAYOUT (of the i-th primitive)
+    // serialized_data[stride * 0 + i] = squared radius
+    // serialized_data[stride * 1 + i],...,serialized_data[stride * AMB_DIM + i] = interior_point
+    // serialized_data[stride * (AMB_DIM + 1 + AMB_DIM * j + k) + i] = k-th coordinate of the j-th point whose convex hull defines the polytope.
+
+    template<int POINT_COUNT,int AMB_DIM,typename Real_,typename Int_,typename SReal_,
+                typename ExtReal = SReal_,typename ExtInt = Int_>
+    class CLASS
+    {
+        ASSERT_FLOAT(Real_  );
+        ASSERT_INT  (Int_   );
+        ASSERT_FLOAT(SReal_ );
+        ASSERT_FLOAT(ExtReal);
+        ASSERT_INT  (ExtInt );
+
+    public:
+
+        using Real  = Real_;
+        using Int   = Int_;
+        using SReal = SReal_;
+
+        static constexpr Int SIZE = 1 + AMB_DIM + POINT_COUNT * AMB_DIM;
+
+    protected:
+
+        static constexpr Int POINTS = 1 + AMB_DIM; // first row of the points
+
+        SReal * restrict serialized_data = nullptr;
+
+        Int stride = 0;
+        Int pos    = 0;
+
+    public:
+
+        CLASS() = default;
+
+        explicit CLASS( const Int stride_ )
+        :   stride ( stride_ )
+        {}
+
+        CLASS( mptr<SReal> p_, const Int stride_ )
+        :   serialized_data ( p_      )
+        ,   stride          ( stride_ )
+        {}
+
+        ~CLASS() = default;
+
+        static constexpr Int AmbDim()
+        {
+            return AMB_DIM;
+        }
+
+        static constexpr Int PointCount()
+        {
+            return POINT_COUNT;
+        }
+
+        static constexpr Int Size()
+        {
+            return SIZE;
+        }
+
+        Int Stride() const
+        {
+            return stride;
+        }
+
+        // Sets the data pointer to the SoA matrix p_ and selects the primitive in column pos_. The stride is kept.
+        void SetPointer( mptr<SReal> p_, const Int pos_ )
+        {
+            serialized_data = p_;
+            pos             = pos_;
+        }
+
+        void SetPointer( mptr<SReal> p_, const Int stride_, const Int pos_ )
+        {
+            serialized_data = p_;
+            stride          = stride_;
+            pos             = pos_;
+        }
+
+        // Returns a pointer to row f of the SoA matrix, i.e., to field f of all primitives.
+        const SReal * Row( const Int f ) const
+        {
+            return &serialized_data[stride * f];
+        }
+
+        SReal * Row( const Int f )
+        {
+            return &serialized_data[stride * f];
+        }
+
+        // Returns the k-th coordinate of the j-th point of the current primitive.
+        Real Coordinate( const Int j, const Int k ) const
+        {
+            return static_cast<Real>(serialized_data[stride * (POINTS + AMB_DIM * j + k) + pos]);
+        }
+
+    public:
+
+        // ################################################################
+        // #################  Interface of a single primitive  ############
+        // ################################################################
+
+        Real SquaredRadius() const
+        {
+            return serialized_data ? static_cast<Real>(serialized_data[pos]) : std::numeric_limits<Real>::max();
+        }
+
+        void InteriorPoint( mptr<Real> point_out ) const
+        {
+            for( Int k = 0; k < AMB_DIM; ++k )
+            {
+                point_out[k] = static_cast<Real>(serialized_data[stride * (1 + k) + pos]);
+            }
+        }
+
+        Real InteriorPoint( const Int k ) const
+        {
+            return static_cast<Real>(serialized_data[stride * (1 + k) + pos]);
+        }
+
+        // Reads the points of the current primitive into a contiguous buffer of size POINT_COUNT x AMB_DIM.
+        void ReadPoints( mptr<Real> A ) const
+        {
+            for( Int j = 0; j < POINT_COUNT; ++j )
+            {
+                for( Int k = 0; k < AMB_DIM; ++k )
+                {
+                    A[AMB_DIM * j + k] = Coordinate(j,k);
+                }
+            }
+        }
+
+        //Computes support vector supp of dir.
+        Real MinSupportVector( cptr<Real> dir, mptr<Real> supp ) const
+        {
+            return SupportVector<false>( dir, supp );
+        }
+
+        //Computes support vector supp of dir.
+        Real MaxSupportVector( cptr<Real> dir, mptr<Real> supp ) const
+        {
+            return SupportVector<true>( dir, supp );
+        }
+
+        // Computes only the values of min/max support function. Usefull to compute bounding boxes.
+        void MinMaxSupportValue( cptr<Real> dir, mref<Real> min_val, mref<Real> max_val ) const
+        {
+            Real value = Dot( 0, dir );
+
+            min_val = value;
+            max_val = value;
+
+            for( Int j = 1; j < POINT_COUNT; ++j )
+            {
+                value = Dot( j, dir );
+
+                min_val = Min( min_val, value );
+                max_val = Max( max_val, value );
+            }
+        }
+
+        // Same as Polytope::BoxMinMax.
+        void BoxMinMax( mptr<SReal> box_min, mptr<SReal> box_max ) const
+        {
+            for( Int j = 0; j < POINT_COUNT; ++j )
+            {
+                for( Int k = 0; k < AMB_DIM; ++k )
+                {
+                    const SReal x = serialized_data[stride * (POINTS + AMB_DIM * j + k) + pos];
+                    box_min[k] = Min( box_min[k], x );
+                    box_max[k] = Max( box_max[k], x );
+                }
+            }
+        }
+
+    protected:
+
+        Real Dot( const Int j, cptr<Real> dir ) const
+        {
+            Real value = Coordinate(j,0) * dir[0];
+
+            for( Int k = 1; k < AMB_DIM; ++k )
+            {
+                value += Coordinate(j,k) * dir[k];
+            }
+
+            return value;
+        }
+
+        template<bool maxQ>
+        Real SupportVector( cptr<Real> dir, mptr<Real> supp ) const
+        {
+            Int  best_j = 0;
+            Real best   = Dot( 0, dir );
+
+            for( Int j = 1; j < POINT_COUNT; ++j )
+            {
+                const Real value = Dot( j, dir );
+
+                if( maxQ ? (value > best) : (value < best) )
+                {
+                    best_j = j;
+                    best   = value;
+                }
+            }
+
+            for( Int k = 0; k < AMB_DIM; ++k )
+            {
+                supp[k] = Coordinate(best_j,k);
+            }
+
+            return best;
+        }
+
+    public:
+
+        // ################################################################
+        // ########################  Range kernels  #######################
+        // ################################################################
+
+        // All range kernels work on the primitives in [begin,end[ of the SoA matrix this view points to; the current primitive (pos) is ignored.
+
+        // Same as Polytope::FromCoordinates for each i in [begin,end[; hull_coords is a matrix of size n x POINT_COUNT x AMB_DIM (AoS, as for Polytope).
+        void FromCoordinates( cptr<ExtReal> hull_coords, const Int begin, const Int end )
+        {
+            constexpr SReal w = Inv<SReal>(POINT_COUNT);
+
+            for( Int j = 0; j < POINT_COUNT; ++j )
+            {
+                for( Int k = 0; k < AMB_DIM; ++k )
+                {
+                    mptr<SReal> x = Row( POINTS + AMB_DIM * j + k );
+
+                    for( Int i = begin; i < end; ++i )
+                    {
+                        x[i] = static_cast<SReal>(hull_coords[(POINT_COUNT * i + j) * AMB_DIM + k]);
+                    }
+                }
+            }
+
+            ComputeCentersAndRadii( w, begin, end );
+        }
+
+        // Converts the primitives [begin,end[ from the AoS layout of Polytope<POINT_COUNT,AMB_DIM,...> to this SoA matrix.
+        void FromPolytopes( cptr<SReal> P_serialized, const Int begin, const Int end )
+        {
+            for( Int f = 0; f < SIZE; ++f )
+            {
+                mptr<SReal> x = Row(f);
+
+                for( Int i = begin; i < end; ++i )
+                {
+                    x[i] = P_serialized[SIZE * i + f];
+                }
+            }
+        }
+
+        // Converts the primitives [begin,end[ from this SoA matrix to the AoS layout of Polytope<POINT_COUNT,AMB_DIM,...>.
+        void ToPolytopes( mptr<SReal> P_serialized, const Int begin, const Int end ) const
+        {
+            for( Int f = 0; f < SIZE; ++f )
+            {
+                cptr<SReal> x = Row(f);
+
+                for( Int i = begin; i < end; ++i )
+                {
+                    P_serialized[SIZE * i + f] = x[i];
+                }
+            }
+        }
+
+        // Sets box_min = min(box_min, lower corner) and box_max = max(box_max, upper corner) of the bounding box of all primitives in [begin,end[. box_min, box_max are vectors of size AMB_DIM.
+        void BoxMinMax( const Int begin, const Int end, mptr<SReal> box_min, mptr<SReal> box_max ) const
+        {
+            for( Int k = 0; k < AMB_DIM; ++k )
+            {
+                SReal lo = box_min[k];
+                SReal hi = box_max[k];
+
+                for( Int j = 0; j < POINT_COUNT; ++j )
+                {
+                    cptr<SReal> x = Row( POINTS + AMB_DIM * j + k );
+
+                    for( Int i = begin; i < end; ++i )
+                    {
+                        lo = Min( lo, x[i] );
+                        hi = Max( hi, x[i] );
+                    }
+                }
+
+                box_min[k] = lo;
+                box_max[k] = hi;
+            }
+        }
+
+    protected:
+
+        void ComputeCentersAndRadii( const SReal w, const Int begin, const Int end )
+        {
+            // Compute average.
+            for( Int k = 0; k < AMB_DIM; ++k )
+            {
+                mptr<SReal> c = Row( 1 + k );
+
+                cptr<SReal> x = Row( POINTS + k );
+
+                for( Int i = begin; i < end; ++i )
+                {
+                    c[i] = x[i];
+                }
+
+                for( Int j = 1; j < POINT_COUNT; ++j )
+                {
+                    cptr<SReal> y = Row( POINTS + AMB_DIM * j + k );
+
+                    for( Int i = begin; i < end; ++i )
+                    {
+                        c[i] += y[i];
+                    }
+                }
+
+                for( Int i = begin; i < end; ++i )
+                {
+                    c[i] *= w;
+                }
+            }
+
+            // Compute radius.
+            mptr<SReal> r2 = Row(0);
+
+            for( Int i = begin; i < end; ++i )
+            {
+                r2[i] = Scalar::Zero<SReal>;
+            }
+
+            for( Int j = 0; j < POINT_COUNT; ++j )
+            {
+                for( Int i = begin; i < end; ++i )
+                {
+                    SReal square = Scalar::Zero<SReal>;
+
+                    for( Int k = 0; k < AMB_DIM; ++k )
+                    {
+                        const SReal diff = serialized_data[stride * (POINTS + AMB_DIM * j + k) + i] - serialized_data[stride * (1 + k) + i];
+
+                        square += diff * diff;
+                    }
+
+                    r2[i] = Max( r2[i], square );
+                }
+            }
+        }
+
+    public:
+
+        std::string ClassName() const
+        {
+            return TO_STD_STRING(CLASS)+"<"+ToString(POINT_COUNT)+","+ToString(AMB_DIM)+","+TypeName<Real>+","+TypeName<Int>+","+TypeName<SReal>+","+TypeName<ExtReal>+","+TypeName<ExtInt>+">";
+        }
+
+    }; // PolytopeSoA
+
+} // namespace GJK
+
+#undef CLASS
@@ -12,13 +12,17 @@ namespace GJK
     // SReal -  storage data type; could be float ("short real")
     // Int   -  integer type for return values and loops.
     
-    template<int AMB_DIM, typename Real, typename Int, typename SReal >
+    template<int AMB_DIM, typename Real, typename Int, typename SReal_ >
     class CLASS : public BASE
     {
-        ASSERT_FLOAT(Real );
-        ASSERT_INT  (Int  );
-        ASSERT_FLOAT(SReal);
+        ASSERT_FLOAT(Real  );
+        ASSERT_INT  (Int   );
+        ASSERT_FLOAT(SReal_);
 
+    public:
+        
+        using SReal = SReal_;
+        
     protected:
         
         // serialized_data is assumed to be an array of size SIZE. Will never be allocated by class! Instead, it is meant to be mapped onto an array of type Real by calling the member SetPointer.
@@ -0,0 +1,124 @@
+#pragma once
+
+namespace GJK
+{
+    // Stable least-significant-digit radix sort of 64-bit keys with Int payload, 8 bits per pass.
+    //
+    // Only the lowest key_bits bits of the keys are considered, so codes of fewer than 64 bits need fewer passes. Each pass is parallelized by splitting [0,n[ statically over the threads: every thread builds a histogram of its block, a prefix sum over (digit, thread) yields the threads' scatter offsets, and every thread scatters its block. This keeps the sort stable.
+    //
+    // keys and values are sorted in place; the scratch buffers are allocated internally.
+
+    template<typename Int>
+    void RadixSort(
+        const Int n,
+        mptr<std::uint64_t> keys,
+        mptr<Int> values,
+        const int key_bits = 64,
+        const Int thread_count_ = 1
+    )
+    {
+        ASSERT_INT(Int);
+
+        constexpr int radix_bits  = 8;
+        constexpr Int radix_count = Int(1) << radix_bits;
+
+        if( n <= 1 )
+        {
+            return;
+        }
+
+        // Small inputs are not worth the threads.
+        const Int thread_count = Max( Int(1), Min( thread_count_, n / Int(65536) ) );
+
+        const int pass_count = (Max( Min( key_bits, 64 ), 1 ) + radix_bits - 1) / radix_bits;
+
+        std::vector<std::uint64_t> keys_buffer   ( n );
+        std::vector<Int>           values_buffer ( n );
+
+        std::vector<Int> counts ( radix_count * thread_count );
+
+        std::uint64_t * keys_in    = keys;
+        Int *           values_in  = values;
+        std::uint64_t * keys_out   = keys_buffer.data();
+        Int *           values_out = values_buffer.data();
+
+        for( int pass = 0; pass < pass_count; ++pass )
+        {
+            const int shift = radix_bits * pass;
+
+            ParallelDo(
+                [&]( const Int thread )
+                {
+                    const Int i_begin = JobPointer( n, thread_count, thread    );
+                    const Int i_end   = JobPointer( n, thread_count, thread +1 );
+
+                    mptr<Int> c = &counts[radix_count * thread];
+
+                    std::fill( c, c + radix_count, Int(0) );
+
+                    for( Int i = i_begin; i < i_end; ++i )
+                    {
+                        ++c[ (keys_in[i] >> shift) & (radix_count - 1) ];
+                    }
+                },
+                thread_count
+            );
+
+            // Exclusive prefix sum, digit-major, thread-minor.
+            Int sum = 0;
+
+            bool trivialQ = false;
+
+            for( Int d = 0; d < radix_count; ++d )
+            {
+                const Int sum_before = sum;
+
+                for( Int thread = 0; thread < thread_count; ++thread )
+                {
+                    const Int c = counts[radix_count * thread + d];
+
+                    counts[radix_count * thread + d] = sum;
+
+                    sum += c;
+                }
+
+                trivialQ = trivialQ || (sum - sum_before == n);
+            }
+
+            // All keys have the same digit; the scatter would be the identity.
+            if( trivialQ )
+            {
+                continue;
+            }
+
+            ParallelDo(
+                [&]( const Int thread )
+                {
+                    const Int i_begin = JobPointer( n, thread_count, thread    );
+                    const Int i_end   = JobPointer( n, thread_count, thread +1 );
+
+                    mptr<Int> c = &counts[radix_count * thread];
+
+                    for( Int i = i_begin; i < i_end; ++i )
+                    {
+                        const Int j = c[ (keys_in[i] >> shift) & (radix_count - 1) ]++;
+
+                        keys_out  [j] = keys_in  [i];
+                        values_out[j] = values_in[i];
+                    }
+                },
+                thread_count
+            );
+
+            std::swap( keys_in,   keys_out   );
+            std::swap( values_in, values_out );
+        }
+
+        if( keys_in != keys )
+        {
+            std::copy_n( keys_in,   n, keys   );
+            std::copy_n( values_in, n, values );
+        }
+    }
+
+} // namespace GJK
@@ -0,0 +1,252 @@
+#pragma once
+
+#define CLASS SweptBVH
+
+namespace GJK
+{
+    // Broad phase for continuous collision queries.
+    //
+    // A MovingPolytope moves its vertices linearly, so the set it sweeps over the time interval [a,b] is the convex hull of its vertices at t = a and t = b. MovingPolytope_SweptBoxes writes the axis-aligned box of these 2 * PointCount() points for each polytope, in the serialized layout of AABB. The polytopes are given by their coordinates and velocities as written by WriteCoordinatesSerialized and WriteVelocitiesSerialized.
+    //
+    // SweptBVH builds a BVH over these boxes, i.e., the boxes serve as the BVH's primitives. PrimitiveOrdering() of the tree thus refers to the indices of the moving polytopes. Update recomputes the boxes for new coordinates, velocities, or time interval and refits the tree without changing its topology, which is what a line search needs after each step. SweptBVH_IntersectingPairs returns the pairs of polytopes whose swept boxes overlap; only these have to be passed to CollisionFinder (e.g., via CollisionFinder_MaximumSafeStepSize_Batch).
+
+    template<int AMB_DIM, typename Real, typename Int, typename SReal>
+    void MovingPolytope_SweptBoxes(
+        cref<MovingPolytopeBase<AMB_DIM,Real,Int,SReal>> P_,   // prototype
+        cptr<SReal> P_coords,           // matrix of size n x P_.CoordinateSize()
+        cptr<SReal> P_velocs,           // matrix of size n x P_.VelocitySize()
+        const Int n,
+        const SReal a,                  // first time
+        const SReal b,                  // second time
+        mptr<SReal> boxes,              // matrix of size n x (1 + 2 * AMB_DIM) of serialized AABBs
+        const SReal offset = 0,         // the boxes are enlarged by offset in each direction
+        const Int thread_count = 1
+    )
+    {
+        tic("MovingPolytope_SweptBoxes");
+
+        constexpr Int SIZE = 1 + 2 * AMB_DIM;
+
+        ParallelDo(
+            [&]( const Int thread )
+            {
+                const Int i_begin = JobPointer( n, thread_count, thread    );
+                const Int i_end   = JobPointer( n, thread_count, thread +1 );
+
+                std::shared_ptr<MovingPolytopeBase<AMB_DIM,Real,Int,SReal>> P = P_.Clone();
+
+                const Int point_count = P->PointCount();
+                const Int coord_size  = P->CoordinateSize();
+
+                // Positions at t = a and t = b, in the serialized layout of Polytope (squared radius, center, vertices).
+                std::vector<SReal> buffer ( 2 * coord_size );
+
+                for( Int i = i_begin; i < i_end; ++i )
+                {
+                    P->ReadCoordinatesSerialized( P_coords, i );
+                    P->ReadVelocitiesSerialized ( P_velocs, i );
+
+                    P->WriteDeformedSerialized( buffer.data(), a, 0 );
+                    P->WriteDeformedSerialized( buffer.data(), b, 1 );
+
+                    SReal lower [AMB_DIM];
+                    SReal upper [AMB_DIM];
+
+                    for( Int k = 0; k < AMB_DIM; ++k )
+                    {
+                        lower[k] = std::numeric_limits<SReal>::max();
+                        upper[k] = std::numeric_limits<SReal>::lowest();
+                    }
+
+                    for( Int s = 0; s < 2; ++s )
+                    {
+                        cptr<SReal> x = &buffer[coord_size * s + 1 + AMB_DIM];
+
+                        for( Int j = 0; j < point_count; ++j )
+                        {
+                            for( Int k = 0; k < AMB_DIM; ++k )
+                            {
+                                lower[k] = Min( lower[k], x[AMB_DIM * j + k] );
+                                upper[k] = Max( upper[k], x[AMB_DIM * j + k] );
+                            }
+                        }
+                    }
+
+                    mptr<SReal> box = &boxes[SIZE * i];
+
+                    SReal r2 = Scalar::Zero<SReal>;
+
+                    for( Int k = 0; k < AMB_DIM; ++k )
+                    {
+                        const SReal L = Scalar::Half<SReal> * (upper[k] - lower[k]) + offset;
+
+                        box[1 + k]           = Scalar::Half<SReal> * (upper[k] + lower[k]);
+                        box[1 + AMB_DIM + k] = L;
+
+                        r2 += L * L;
+                    }
+
+                    box[0] = r2;
+                }
+            },
+            thread_count
+        );
+
+        toc("MovingPolytope_SweptBoxes");
+    }
+
+    // BoundingVolume_T must be derived from AABB; it is used both as bounding volume of the nodes and as primitive.
+    template<typename BoundingVolume_T_>
+    class CLASS
+    {
+    public:
+
+        using BoundingVolume_T = BoundingVolume_T_;
+
+        using Real  = typename BoundingVolume_T::Real;
+        using Int   = typename BoundingVolume_T::Int;
+        using SReal = typename BoundingVolume_T::SReal;
+
+        static constexpr Int AMB_DIM = BoundingVolume_T::AmbDim();
+
+        static_assert( std::is_base_of_v<AABB<AMB_DIM,Real,Int,SReal>,BoundingVolume_T>, "SweptBVH: BoundingVolume_T must be derived from AABB." );
+
+        using MovingPolytope_T = MovingPolytopeBase<AMB_DIM,Real,Int,SReal>;
+
+        using Tree_T = BVH<BoundingVolume_T,BoundingVolume_T>;
+
+    protected:
+
+        std::shared_ptr<MovingPolytope_T> P_proto;
+
+        Int primitive_count = 0;
+        Int thread_count    = 1;
+
+        SReal a      = Scalar::Zero<SReal>;
+        SReal b      = Scalar::One <SReal>;
+        SReal offset = Scalar::Zero<SReal>;
+
+        // Swept boxes in the original order of the polytopes.
+        std::vector<SReal> boxes;
+
+        std::unique_ptr<Tree_T> tree;
+
+    public:
+
+        CLASS(
+            cref<BoundingVolume_T> C_,
+            cref<MovingPolytope_T> P_,
+            cptr<SReal> P_coords,                   // matrix of size n x P_.CoordinateSize()
+            cptr<SReal> P_velocs,                   // matrix of size n x P_.VelocitySize()
+            const Int n,
+            const SReal a_ = Scalar::Zero<SReal>,   // first time
+            const SReal b_ = Scalar::One <SReal>,   // second time
+            const SReal offset_ = Scalar::Zero<SReal>, // safety margin added to each box
+            const Int max_leaf_size_ = 1,
+            const Int thread_count_  = 1,
+            const BVH_BuildMethod method_ = BVH_BuildMethod::TopDownSplit
+        )
+        :   P_proto         ( P_.Clone()                    )
+        ,   primitive_count ( n                             )
+        ,   thread_count    ( Max( thread_count_, Int(1) )  )
+        ,   a               ( a_                            )
+        ,   b               ( b_                            )
+        ,   offset          ( offset_                       )
+        ,   boxes           ( n * C_.Size()                 )
+        {
+            tic(ClassName());
+
+            MovingPolytope_SweptBoxes( *P_proto, P_coords, P_velocs, n, a, b, boxes.data(), offset, thread_count );
+
+            tree = std::make_unique<Tree_T>( C_, C_, boxes.data(), n, max_leaf_size_, thread_count, method_ );
+
+            toc(ClassName());
+        }
+
+        CLASS( const CLASS & other ) = delete;
+
+        ~CLASS() = default;
+
+    public:
+
+        Int PrimitiveCount() const
+        {
+            return primitive_count;
+        }
+
+        SReal FirstTime() const
+        {
+            return a;
+        }
+
+        SReal SecondTime() const
+        {
+            return b;
+        }
+
+        SReal Offset() const
+        {
+            return offset;
+        }
+
+        cref<MovingPolytope_T> Primitive() const
+        {
+            return *P_proto;
+        }
+
+        mref<Tree_T> Tree()
+        {
+            return *tree;
+        }
+
+        cref<Tree_T> Tree() const
+        {
+            return *tree;
+        }
+
+        // Swept boxes in the original order of the polytopes; matrix of size PrimitiveCount() x (1 + 2 * AMB_DIM).
+        const SReal * SweptBoxes() const
+        {
+            return boxes.data();
+        }
+
+        // Recomputes the swept boxes and refits the tree; the topology of the tree is kept.
+        void Update(
+            cptr<SReal> P_coords,
+            cptr<SReal> P_velocs,
+            const SReal a_,
+            const SReal b_
+        )
+        {
+            tic(ClassName()+"::Update");
+
+            a = a_;
+            b = b_;
+
+            MovingPolytope_SweptBoxes( *P_proto, P_coords, P_velocs, primitive_count, a, b, boxes.data(), offset, thread_count );
+
+            tree->Refit( boxes.data() );
+
+            toc(ClassName()+"::Update");
+        }
+
+        std::string ClassName() const
+        {
+            return TO_STD_STRING(CLASS)+"<"+P_proto->ClassName()+">";
+        }
+    };
+
+    // Returns the pairs (i,j) of polytopes, in their original numbering, whose swept boxes overlap. S and T should use the same time interval.
+    template<typename BoundingVolume_T>
+    std::vector<std::pair<typename BoundingVolume_T::Int,typename BoundingVolume_T::Int>> SweptBVH_IntersectingPairs(
+        SweptBVH<BoundingVolume_T> & S,
+        SweptBVH<BoundingVolume_T> & T,
+        const typename BoundingVolume_T::Int thread_count = 1
+    )
+    {
+        return BVH_IntersectingPairs( S.Tree(), T.Tree(), thread_count );
+    }
+
+} // namespace GJK
+
+#undef CLASS
@@ -0,0 +1,421 @@
+#pragma once
+
+namespace GJK
+{
+    // Eigendecomposition of a small symmetric matrix of size AMB_DIM x AMB_DIM without allocations and without calls to LAPACK.
+    //
+    // Input:  A[AMB_DIM * i + j] for j >= i, i.e., the upper triangle in row-major layout (the lower triangle in column-major layout, just as for LAPACKE_?syev with 'L'). The strictly lower triangle is ignored.
+    // Output: A[AMB_DIM * j + k] is the k-th coordinate of the j-th eigenvector; the eigenvectors form an orthonormal basis. eigenvalues[j] is the j-th eigenvalue in ascending order.
+    // Returns 0 on success, just like the info value of LAPACK.
+    //
+    // For AMB_DIM <= 3 the decomposition is computed in closed form. The 3 x 3 case follows D. Eberly, A Robust Eigensolver for 3 x 3 Symmetric Matrices (2014): the eigenvalues are the roots of the characteristic polynomial in trigonometric form, the eigenvectors are obtained from cross products, so that they stay orthonormal even for (nearly) repeated eigenvalues. Larger matrices are handled by the cyclic Jacobi method.
+
+    template<int AMB_DIM, typename Real>
+    int SymmetricEigenSolve( mptr<Real> A, mptr<Real> eigenvalues )
+    {
+        ASSERT_FLOAT(Real);
+
+        static_assert( AMB_DIM >= 1, "SymmetricEigenSolve: AMB_DIM must be positive." );
+
+        if constexpr ( AMB_DIM == 1 )
+        {
+            eigenvalues[0] = A[0];
+            A[0] = Scalar::One<Real>;
+
+            return 0;
+        }
+        else if constexpr ( AMB_DIM == 2 )
+        {
+            const Real a = A[0];
+            const Real b = A[1];
+            const Real c = A[3];
+
+            const Real m = Scalar::Half<Real> * (a + c);
+            const Real d = std::hypot( Scalar::Half<Real> * (a - c), b );
+
+            eigenvalues[0] = m - d;
+            eigenvalues[1] = m + d;
+
+            // Rotation angle of the eigenvector of the larger eigenvalue.
+            const Real phi = Scalar::Half<Real> * std::atan2( Scalar::Two<Real> * b, a - c );
+
+            const Real cos_phi = std::cos( phi );
+            const Real sin_phi = std::sin( phi );
+
+            A[0] = -sin_phi;
+            A[1] =  cos_phi;
+            A[2] =  cos_phi;
+            A[3] =  sin_phi;
+
+            return 0;
+        }
+        else if constexpr ( AMB_DIM == 3 )
+        {
+            // Precondition the matrix by factoring out the maximal absolute value of the entries.
+            const Real max_abs = Max(
+                Max( Abs(A[0]), Abs(A[1]) ),
+                Max( Max( Abs(A[2]), Abs(A[4]) ), Max( Abs(A[5]), Abs(A[8]) ) )
+            );
+
+            if( max_abs <= Scalar::Zero<Real> )
+            {
+                for( int i = 0; i < 3; ++i )
+                {
+                    eigenvalues[i] = Scalar::Zero<Real>;
+
+                    for( int j = 0; j < 3; ++j )
+                    {
+                        A[3 * i + j] = static_cast<Real>(i == j);
+                    }
+                }
+
+                return 0;
+            }
+
+            const Real s = Inv<Real>( max_abs );
+
+            const Real a00 = s * A[0];
+            const Real a01 = s * A[1];
+            const Real a02 = s * A[2];
+            const Real a11 = s * A[4];
+            const Real a12 = s * A[5];
+            const Real a22 = s * A[8];
+
+            const Real off_norm = a01 * a01 + a02 * a02 + a12 * a12;
+
+            const Real q   = (a00 + a11 + a22) / static_cast<Real>(3);
+            const Real b00 = a00 - q;
+            const Real b11 = a11 - q;
+            const Real b22 = a22 - q;
+
+            const Real p = Sqrt( (b00 * b00 + b11 * b11 + b22 * b22 + Scalar::Two<Real> * off_norm) / static_cast<Real>(6) );
+
+            if( (off_norm <= Scalar::Zero<Real>) || (p <= Scalar::Eps<Real>) )
+            {
+                // Diagonal matrix or multiple of the identity up to rounding errors; sort the diagonal.
+                Real d    [3] = { a00, a11, a22 };
+                int  perm [3] = { 0, 1, 2 };
+
+                std::sort( &perm[0], &perm[3], [&d]( const int i, const int j ){ return d[i] < d[j]; } );
+
+                for( int i = 0; i < 3; ++i )
+                {
+                    eigenvalues[i] = max_abs * d[perm[i]];
+
+                    for( int j = 0; j < 3; ++j )
+                    {
+                        A[3 * i + j] = static_cast<Real>(perm[i] == j);
+                    }
+                }
+
+                return 0;
+            }
+
+            auto cross = []( cptr<Real> u, cptr<Real> v, mptr<Real> w )
+            {
+                w[0] = u[1] * v[2] - u[2] * v[1];
+                w[1] = u[2] * v[0] - u[0] * v[2];
+                w[2] = u[0] * v[1] - u[1] * v[0];
+            };
+
+            auto dot = []( cptr<Real> u, cptr<Real> v )
+            {
+                return u[0] * v[0] + u[1] * v[1] + u[2] * v[2];
+            };
+
+            // Eigenvector of the simple eigenvalue lambda: the largest cross product of two rows of A - lambda I.
+            auto eigenvector_0 = [&]( const Real lambda, mptr<Real> v )
+            {
+                const Real row_0 [3] = { a00 - lambda, a01,          a02          };
+                const Real row_1 [3] = { a01,          a11 - lambda, a12          };
+                const Real row_2 [3] = { a02,          a12,          a22 - lambda };
+
+                Real c [3][3];
+
+                cross( &row_0[0], &row_1[0], &c[0][0] );
+                cross( &row_0[0], &row_2[0], &c[1][0] );
+                cross( &row_1[0], &row_2[0], &c[2][0] );
+
+                const Real d [3] = { dot( &c[0][0], &c[0][0] ), dot( &c[1][0], &c[1][0] ), dot( &c[2][0], &c[2][0] ) };
+
+                const int i = (d[0] >= d[1]) ? ( (d[0] >= d[2]) ? 0 : 2 ) : ( (d[1] >= d[2]) ? 1 : 2 );
+
+                if( d[i] <= Scalar::Zero<Real> )
+                {
+                    // A - lambda I vanishes up to rounding errors, so every vector is an eigenvector.
+                    v[0] = Scalar::One<Real>;
+                    v[1] = Scalar::Zero<Real>;
+                    v[2] = Scalar::Zero<Real>;
+
+                    return;
+                }
+
+                const Real factor = InvSqrt( d[i] );
+
+                for( int k = 0; k < 3; ++k )
+                {
+                    v[k] = factor * c[i][k];
+                }
+            };
+
+            // Eigenvector of lambda orthogonal to the unit eigenvector w, computed within the orthogonal complement of w.
+            auto eigenvector_1 = [&]( cptr<Real> w, const Real lambda, mptr<Real> v )
+            {
+                Real U [3];
+                Real V [3];
+
+                if( Abs(w[0]) > Abs(w[1]) )
+                {
+                    const Real factor = InvSqrt( w[0] * w[0] + w[2] * w[2] );
+
+                    U[0] = - factor * w[2];
+                    U[1] = Scalar::Zero<Real>;
+                    U[2] = + factor * w[0];
+                }
+                else
+                {
+                    const Real factor = InvSqrt( w[1] * w[1] + w[2] * w[2] );
+
+                    U[0] = Scalar::Zero<Real>;
+                    U[1] = + factor * w[2];
+                    U[2] = - factor * w[1];
+                }
+
+                cross( w, &U[0], &V[0] );
+
+                const Real AU [3] = {
+                    a00 * U[0] + a01 * U[1] + a02 * U[2],
+                    a01 * U[0] + a11 * U[1] + a12 * U[2],
+                    a02 * U[0] + a12 * U[1] + a22 * U[2]
+                };
+
+                const Real AV [3] = {
+                    a00 * V[0] + a01 * V[1] + a02 * V[2],
+                    a01 * V[0] + a11 * V[1] + a12 * V[2],
+                    a02 * V[0] + a12 * V[1] + a22 * V[2]
+                };
+
+                Real m00 = dot( &U[0], &AU[0] ) - lambda;
+                Real m01 = dot( &U[0], &AV[0] );
+                Real m11 = dot( &V[0], &AV[0] ) - lambda;
+
+                const Real abs_m00 = Abs(m00);
+                const Real abs_m01 = Abs(m01);
+                const Real abs_m11 = Abs(m11);
+
+                Real alpha = Scalar::One<Real>;
+                Real beta  = Scalar::Zero<Real>;
+
+                if( abs_m00 >= abs_m11 )
+                {
+                    if( Max( abs_m00, abs_m01 ) > Scalar::Zero<Real> )
+                    {
+                        if( abs_m00 >= abs_m01 )
+                        {
+                            m01 /= m00;
+                            m00 = InvSqrt( Scalar::One<Real> + m01 * m01 );
+                            m01 *= m00;
+                        }
+                        else
+                        {
+                            m00 /= m01;
+                            m01 = InvSqrt( Scalar::One<Real> + m00 * m00 );
+                            m00 *= m01;
+                        }
+
+                        alpha =  m01;
+                        beta  = -m00;
+                    }
+                }
+                else
+                {
+                    if( Max( abs_m11, abs_m01 ) > Scalar::Zero<Real> )
+                    {
+                        if( abs_m11 >= abs_m01 )
+                        {
+                            m01 /= m11;
+                            m11 = InvSqrt( Scalar::One<Real> + m01 * m01 );
+                            m01 *= m11;
+                        }
+                        else
+                        {
+                            m11 /= m01;
+                            m01 = InvSqrt( Scalar::One<Real> + m11 * m11 );
+                            m11 *= m01;
+                        }
+
+                        alpha =  m11;
+                        beta  = -m01;
+                    }
+                }
+
+                for( int k = 0; k < 3; ++k )
+                {
+                    v[k] = alpha * U[k] + beta * V[k];
+                }
+            };
+
+            const Real c00 = b11 * b22 - a12 * a12;
+            const Real c01 = a01 * b22 - a12 * a02;
+            const Real c02 = a01 * a12 - b11 * a02;
+
+            const Real half_det = Min( Max(
+                Scalar::Half<Real> * (b00 * c00 - a01 * c01 + a02 * c02) / (p * p * p),
+                -Scalar::One<Real> ), Scalar::One<Real>
+            );
+
+            const Real angle = std::acos( half_det ) / static_cast<Real>(3);
+
+            constexpr Real two_thirds_pi = static_cast<Real>(2.09439510239319549230842892218633526);
+
+            const Real beta_2 = Scalar::Two<Real> * std::cos( angle );
+            const Real beta_0 = Scalar::Two<Real> * std::cos( angle + two_thirds_pi );
+            // Clamping keeps the order if rounding errors perturb a double root.
+            const Real beta_1 = Min( Max( - (beta_0 + beta_2), beta_0 ), beta_2 );
+
+            const Real lambda [3] = { q + p * beta_0, q + p * beta_1, q + p * beta_2 };
+
+            Real v [3][3];
+
+            // Start with the eigenvalue that is best separated from the other two.
+            if( half_det >= Scalar::Zero<Real> )
+            {
+                eigenvector_0( lambda[2], &v[2][0] );
+                eigenvector_1( &v[2][0], lambda[1], &v[1][0] );
+                cross( &v[1][0], &v[2][0], &v[0][0] );
+            }
+            else
+            {
+                eigenvector_0( lambda[0], &v[0][0] );
+                eigenvector_1( &v[0][0], lambda[1], &v[1][0] );
+                cross( &v[0][0], &v[1][0], &v[2][0] );
+            }
+
+            for( int i = 0; i < 3; ++i )
+            {
+                eigenvalues[i] = max_abs * lambda[i];
+
+                for( int j = 0; j < 3; ++j )
+                {
+                    A[3 * i + j] = v[i][j];
+                }
+            }
+
+            return 0;
+        }
+        else
+        {
+            constexpr int max_sweeps = 64;
+
+            Real a [AMB_DIM][AMB_DIM];
+            Real V [AMB_DIM][AMB_DIM];
+
+            Real norm = Scalar::Zero<Real>;
+
+            for( int i = 0; i < AMB_DIM; ++i )
+            {
+                for( int j = i; j < AMB_DIM; ++j )
+                {
+                    a[i][j] = a[j][i] = A[AMB_DIM * i + j];
+
+                    norm += (i == j ? Scalar::One<Real> : Scalar::Two<Real>) * a[i][j] * a[i][j];
+                }
+
+                for( int j = 0; j < AMB_DIM; ++j )
+                {
+                    V[i][j] = static_cast<Real>(i == j);
+                }
+            }
+
+            const Real threshold = Scalar::Eps<Real> * Scalar::Eps<Real> * norm;
+
+            for( int sweep = 0; sweep < max_sweeps; ++sweep )
+            {
+                Real off = Scalar::Zero<Real>;
+
+                for( int i = 0; i < AMB_DIM; ++i )
+                {
+                    for( int j = i + 1; j < AMB_DIM; ++j )
+                    {
+                        off += a[i][j] * a[i][j];
+                    }
+                }
+
+                if( off <= threshold )
+                {
+                    break;
+                }
+
+                for( int p = 0; p < AMB_DIM; ++p )
+                {
+                    for( int q = p + 1; q < AMB_DIM; ++q )
+                    {
+                        if( a[p][q] == Scalar::Zero<Real> )
+                        {
+                            continue;
+                        }
+
+                        // Rotation in the (p,q)-plane that annihilates a[p][q].
+                        const Real theta = (a[q][q] - a[p][p]) / (Scalar::Two<Real> * a[p][q]);
+
+                        const Real t = ( theta >= Scalar::Zero<Real> ? Scalar::One<Real> : -Scalar::One<Real> )
+                                     / ( Abs(theta) + std::sqrt( theta * theta + Scalar::One<Real> ) );
+
+                        const Real c = InvSqrt( t * t + Scalar::One<Real> );
+                        const Real s = t * c;
+
+                        for( int k = 0; k < AMB_DIM; ++k )
+                        {
+                            const Real a_kp = a[k][p];
+                            const Real a_kq = a[k][q];
+
+                            a[k][p] = c * a_kp - s * a_kq;
+                            a[k][q] = s * a_kp + c * a_kq;
+                        }
+
+                        for( int k = 0; k < AMB_DIM; ++k )
+                        {
+                            const Real a_pk = a[p][k];
+                            const Real a_qk = a[q][k];
+
+                            a[p][k] = c * a_pk - s * a_qk;
+                            a[q][k] = s * a_pk + c * a_qk;
+                        }
+
+                        for( int k = 0; k < AMB_DIM; ++k )
+                        {
+                            const Real V_kp = V[k][p];
+                            const Real V_kq = V[k][q];
+
+                            V[k][p] = c * V_kp - s * V_kq;
+                            V[k][q] = s * V_kp + c * V_kq;
+                        }
+                    }
+                }
+            }
+
+            int perm [AMB_DIM];
+
+            for( int i = 0; i < AMB_DIM; ++i )
+            {
+                perm[i] = i;
+            }
+
+            std::sort( &perm[0], &perm[AMB_DIM], [&a]( const int i, const int j ){ return a[i][i] < a[j][j]; } );
+
+            for( int i = 0; i < AMB_DIM; ++i )
+            {
+                eigenvalues[i] = a[perm[i]][perm[i]];
+
+                // The eigenvectors are the columns of V.
+                for( int k = 0; k < AMB_DIM; ++k )
+                {
+                    A[AMB_DIM * i + k] = V[k][perm[i]];
+                }
+            }
+
+            return 0;
+        }
+    }
+
+} // namespace GJK
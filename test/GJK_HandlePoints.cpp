@@ -0,0 +1,72 @@
+// Regression test for GJK_Algorithm::HandlePoints, i.e., for Compute on two points.
+//
+// HandlePoints used to set best_lambda[1] instead of best_lambda[0], so WriteWitnesses and WriteSimplex read a stale barycentric coordinate (and stale coords[0]) left over from the previous call to Compute.
+//
+// Build from the repository root, e.g.: g++ -std=c++20 -O2 -I. test/GJK_HandlePoints.cpp -pthread
+
+#include "GJK.hpp"
+
+using namespace GJK;
+
+using Real  = double;
+using Int   = int;
+using SReal = double;
+
+template<typename P_T>
+void Set( mref<P_T> P, mref<std::vector<SReal>> data, const std::vector<Real> & coords )
+{
+    data.resize( P_T::SIZE );
+    P.SetPointer( data.data(), 0 );
+    P.FromCoordinates( coords.data() );
+}
+
+int main()
+{
+    using Point_T = Polytope<1,3,Real,Int,SReal>;
+    using Tet_T   = Polytope<4,3,Real,Int,SReal>;
+
+    std::vector<SReal> A_data, B_data, X_data, Y_data;
+
+    Tet_T   A, B;
+    Point_T X, Y;
+
+    Set( A, A_data, { 0,0,0, 1,0,0, 0,1,0, 0,0,1 } );
+    Set( B, B_data, { 2,2,2, 3,2,2, 2,3,2, 2,2,3 } );
+    Set( X, X_data, { 0.5, -1.0,  2.0 } );
+    Set( Y, Y_data, { 1.5,  3.0, -1.0 } );
+
+    GJK_Algorithm<3,Real,Int> gjk;
+
+    // Leave a barycentric coordinate different from 1 in best_lambda[0].
+    gjk.Compute( A, B );
+    gjk.Compute( X, Y );
+
+    Real x [3];
+    Real y [3];
+    Real P_simplex [4][3];
+    Real Q_simplex [4][3];
+    Real lambda    [4];
+
+    gjk.WriteWitnesses( &x[0], &y[0] );
+
+    const Int simplex_size = gjk.WriteSimplex( &P_simplex[0][0], &Q_simplex[0][0], &lambda[0] );
+
+    const Real x_ex [3] = { 0.5, -1.0,  2.0 };
+    const Real y_ex [3] = { 1.5,  3.0, -1.0 };
+
+    Real error = Abs( lambda[0] - Scalar::One<Real> );
+
+    for( Int k = 0; k < 3; ++k )
+    {
+        error = Max( error, Abs( x[k] - x_ex[k] ) );
+        error = Max( error, Abs( y[k] - y_ex[k] ) );
+        error = Max( error, Abs( P_simplex[0][k] - x_ex[k] ) );
+        error = Max( error, Abs( Q_simplex[0][k] - y_ex[k] ) );
+    }
+
+    const bool passedQ = (simplex_size == 1) && (error <= 1e-14) && gjk.SeparatedQ() && ( Abs( gjk.LeastSquaredDistance() - 26.0 ) <= 1e-12 );
+
+    print( std::string("GJK_HandlePoints: ") + (passedQ ? "passed" : "FAILED") + " (error = " + ToString(error) + ")" );
+
+    return passedQ ? 0 : 1;
+}